@@ -15,7 +15,7 @@ bool BanList::ban(GuestData user)
 	bool added = GuestDataList::add(user);
 	if (added)
 	{
-		MetadataCache::saveBannedUsers(_guests);
+		save();
 	}
 	return added;
 }
@@ -25,7 +25,7 @@ const bool BanList::unban(const uint32_t userID, function<void(GuestData&)> call
 	bool found = GuestDataList::pop(userID, callback);
 	if (found)
 	{
-		MetadataCache::saveBannedUsers(_guests);
+		save();
 	}
 	return found;
 }
@@ -35,7 +35,7 @@ const bool BanList::unban(string guestName, function<void(GuestData&)> callback)
 	bool found = GuestDataList::pop(guestName, callback);
 	if (found)
 	{
-		MetadataCache::saveBannedUsers(_guests);
+		save();
 	}
 	return found;
 }
@@ -49,3 +49,29 @@ vector<GuestData>& BanList::getGuests()
 {
 	return GuestDataList::getGuests();
 }
+
+void BanList::setPersistence(PersistenceWorker* persistence)
+{
+	_persistence = persistence;
+}
+
+
+// =============================================================
+//
+//  Private
+//
+// =============================================================
+
+void BanList::save()
+{
+	if (_persistence == nullptr)
+	{
+		MetadataCache::saveBannedUsers(_guests);
+		return;
+	}
+
+	const vector<GuestData> snapshot = _guests;
+	_persistence->submit(PersistenceWorker::Target::BANS, [snapshot]() {
+		return MetadataCache::saveBannedUsers(snapshot);
+	});
+}
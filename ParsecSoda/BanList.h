@@ -6,6 +6,7 @@
 #include "GuestData.h"
 #include "GuestDataList.h"
 #include "MetadataCache.h"
+#include "PersistenceWorker.h"
 
 class BanList : GuestDataList
 {
@@ -17,5 +18,13 @@ public:
 	const bool unban(string guestName, function<void(GuestData&)> callback);
 	const bool isBanned(const uint32_t userID);
 	vector<GuestData>& getGuests();
+
+	/** Saves go through the worker once set; until then they are written right away. */
+	void setPersistence(PersistenceWorker* persistence);
+
+private:
+	void save();
+
+	PersistenceWorker* _persistence = nullptr;
 };
 
@@ -7,49 +7,22 @@ ACommand * ChatBot::identifyUserDataMessage(const char* msg, Guest &sender, bool
 
 	setLastUserId(BOT_GUESTID);
 
-	// Pleb commands
-	if (msgIsEqual(msg, CommandAFK::prefixes()))		return new CommandAFK(_guests, _gamepadClient);
-	if (msgStartsWith(msg, CommandBonk::prefixes()))	return new CommandBonk(msg, sender, _guests, _dice, _host);
-	if (msgIsEqual(msg, CommandFF::prefixes()))			return new CommandFF(sender, _gamepadClient);
-	if (msgIsEqual(msg, CommandHelp::prefixes()))		return new CommandHelp(sender, _tierList);
-	if (CommandIpFilter::containsIp(msg))				return new CommandIpFilter(msg, sender, _parsec, _ban, isHost);
-	if (msgIsEqual(msg, CommandJoin::prefixes()))		return new CommandJoin();
-	if (msgIsEqual(msg, CommandMirror::prefixes()))		return new CommandMirror(sender, _gamepadClient);
-	if (msgIsEqual(msg, CommandOne::prefixes()))		return new CommandOne(sender, _gamepadClient);
-	if (msgIsEqual(msg, CommandPads::prefixes()))		return new CommandPads(_gamepadClient);
-	if (msgStartsWith(msg, CommandSFX::prefixes()))		return new CommandSFX(msg, _sfxList);
-	if (msgStartsWith(msg, CommandSwap::prefixes()))	return new CommandSwap(msg, sender, _gamepadClient);
-	
-
 	Tier tier = _tierList.getTier(sender.userID);
+	const CommandRegistry::Entry* entry = _commands.find(msg, tier, isHost);
 
-	// Admin commands
-	if (tier >= Tier::ADMIN || isHost)
+	// IP filter keeps its place in the pleb list: commands registered before it win.
+	if ((entry == nullptr || entry->rank > _ipFilterRank) && CommandIpFilter::containsIp(msg))
 	{
-		if (msgStartsWith(msg, CommandBan::prefixes()))			return new CommandBan(msg, sender, _parsec, _guests, _guestHistory, _ban);
-		if (msgStartsWith(msg, CommandDC::prefixes()))			return new CommandDC(msg, _gamepadClient);
-		if (msgStartsWith(msg, CommandKick::prefixes()))		return new CommandKick(msg, sender, _parsec, _guests, isHost);
-		if (msgStartsWith(msg, CommandLimit::prefixes()))		return new CommandLimit(msg, _guests, _gamepadClient);
-		if (msgStartsWith(msg, CommandStrip::prefixes()))		return new CommandStrip(msg, sender, _gamepadClient);
-		if (msgStartsWith(msg, CommandUnban::prefixes()))		return new CommandUnban(msg, sender, _ban, _guestHistory);
+		return CommandArena::make<CommandIpFilter>(msg, sender, _parsec, _ban, isHost);
 	}
 
-	// God commands
-	if (tier >= Tier::GOD || isHost)
+	if (entry != nullptr)
 	{
-		if (msgStartsWith(msg, CommandGameId::prefixes()))		return new CommandGameId(msg, _hostConfig);
-		if (msgStartsWith(msg, CommandGuests::prefixes()))		return new CommandGuests(msg, _hostConfig);
-		if (msgStartsWith(msg, CommandMic::prefixes()))			return new CommandMic(msg, _audioIn);
-		if (msgStartsWith(msg, CommandName::prefixes()))		return new CommandName(msg, _hostConfig);
-		if (msgIsEqual(msg, CommandPrivate::prefixes()))		return new CommandPrivate(_hostConfig);
-		if (msgIsEqual(msg, CommandPublic::prefixes()))			return new CommandPublic(_hostConfig);
-		if (msgIsEqual(msg, CommandSetConfig::prefixes()))		return new CommandSetConfig(_parsec, &_hostConfig, _parsecSession.sessionId.c_str());
-		if (msgStartsWith(msg, CommandSpeakers::prefixes()))	return new CommandSpeakers(msg, _audioOut);
-		if (msgIsEqual(msg, CommandQuit::prefixes()))			return new CommandQuit(_hostingLoopController);
+		return entry->factory(msg, sender, isHost);
 	}
 
 	this->setLastUserId(previous);
-	return new CommandDefaultMessage(msg, sender, _lastUserId, tier, isHost);
+	return CommandArena::make<CommandDefaultMessage>(msg, sender, _lastUserId, tier, isHost);
 }
 
 const uint32_t ChatBot::getLastUserId() const
@@ -57,32 +30,31 @@ const uint32_t ChatBot::getLastUserId() const
 	return this->_lastUserId;
 }
 
-const std::string ChatBot::formatGuestConnection(Guest guest, ParsecGuestState state)
+const std::string& ChatBot::formatGuestConnection(const Guest& guest, ParsecGuestState state)
 {
 	setLastUserId(BOT_GUESTID);
 
-	std::ostringstream reply;
+	std::string& reply = CommandReply::buffer<ChatBot>();
+	reply.clear();
 	if (state == GUEST_CONNECTED)
 	{
-		reply << "@ >>  joined \t " << guest.name << " \t(#" << guest.userID << ")\0";
+		CommandReply::append(reply, "@ >>  joined \t ", guest.name, " \t(#", guest.userID, ")");
 	}
 	else
 	{
-		reply << "! <<  quit \t\t  " << guest.name << " \t(#" << guest.userID << ")\0";
+		CommandReply::append(reply, "! <<  quit \t\t  ", guest.name, " \t(#", guest.userID, ")");
 	}
 
-	const std::string formattedMessage = reply.str();
-	reply.clear();
-	reply.flush();
-	return formattedMessage;
+	return reply;
 }
 
-const std::string ChatBot::formatBannedGuestMessage(Guest guest)
+const std::string& ChatBot::formatBannedGuestMessage(const Guest& guest)
 {
-	std::ostringstream reply;
-	reply << "[ChatBot] | None shall pass! Banned guests don't join us:\n\t\t" << guest.name << " \t (#" << guest.userID << ")\0";
+	std::string& reply = CommandReply::buffer<ChatBot>();
+	reply.clear();
+	CommandReply::append(reply, "[ChatBot] | None shall pass! Banned guests don't join us:\n\t\t", guest.name, " \t (#", guest.userID, ")");
 
-	return reply.str();
+	return reply;
 }
 
 CommandBotMessage ChatBot::sendBotMessage(const char* msg)
@@ -93,43 +65,59 @@ CommandBotMessage ChatBot::sendBotMessage(const char* msg)
 	return message;
 }
 
-bool ChatBot::msgStartsWith(const char* msg, const char * pattern)
+void ChatBot::setLastUserId(uint32_t lastId)
 {
-	return Stringer::startsWithPattern(msg, pattern);
+	this->_lastUserId = lastId;
 }
 
-bool ChatBot::msgStartsWith(const char* msg, vector<const char*> patterns)
-{
-	vector<const char*>::iterator pi = patterns.begin();
-	for (; pi != patterns.end(); ++pi)
-	{
-		if (Stringer::startsWithPattern(msg, *pi))
-		{
-			return true;
-		}
-	}
-	return false;
-}
 
-bool ChatBot::msgIsEqual(const char * msg, const char * pattern)
-{
-	return (strcmp(msg, pattern) == 0);
-}
+// =============================================================
+//
+//  Private
+//
+// =============================================================
 
-bool ChatBot::msgIsEqual(const char* msg, vector<const char*> patterns)
+void ChatBot::registerCommands()
 {
-	vector<const char*>::iterator pi = patterns.begin();
-	for (; pi != patterns.end(); ++pi)
-	{
-		if ((strcmp(msg, *pi) == 0))
-		{
-			return true;
-		}
-	}
-	return false;
-}
+	const bool EXACT = true, PREFIX = false;
 
-void ChatBot::setLastUserId(uint32_t lastId)
-{
-	this->_lastUserId = lastId;
-}
\ No newline at end of file
+	// Pleb commands
+	_commands.add(CommandAFK::prefixes(),		EXACT,	Tier::PLEB, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandAFK>(_guests, _gamepadClient); });
+	_commands.add(CommandBonk::prefixes(),		PREFIX,	Tier::PLEB, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandBonk>(msg, sender, _guests, _dice, _host); });
+	_commands.add(CommandFF::prefixes(),		EXACT,	Tier::PLEB, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandFF>(sender, _gamepadClient); });
+	_commands.add(CommandGrabMouse::prefixes(),	EXACT,	Tier::PLEB, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandGrabMouse>(sender, _mouseRouter); });
+	_commands.add(CommandHelp::prefixes(),		EXACT,	Tier::PLEB, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandHelp>(sender, _tierList); });
+	_ipFilterRank = _commands.reserveRank();
+	_commands.add(CommandJoin::prefixes(),		EXACT,	Tier::PLEB, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandJoin>(); });
+	_commands.add(CommandMirror::prefixes(),	EXACT,	Tier::PLEB, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandMirror>(sender, _gamepadClient); });
+	_commands.add(CommandOne::prefixes(),		EXACT,	Tier::PLEB, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandOne>(sender, _gamepadClient); });
+	_commands.add(CommandPads::prefixes(),		EXACT,	Tier::PLEB, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandPads>(_gamepadClient); });
+	_commands.add(CommandQueue::prefixes(),		EXACT,	Tier::PLEB, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandQueue>(sender, _gamepadClient); });
+	_commands.add(CommandSFX::prefixes(),		PREFIX,	Tier::PLEB, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandSFX>(msg, _sfxList); });
+	_commands.add(CommandSwap::prefixes(),		PREFIX,	Tier::PLEB, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandSwap>(msg, sender, _gamepadClient); });
+	_commands.add(CommandTransform::prefixes(),	PREFIX,	Tier::PLEB, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandTransform>(msg, sender, _gamepadClient); });
+	_commands.add(CommandUnqueue::prefixes(),	EXACT,	Tier::PLEB, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandUnqueue>(sender, _gamepadClient); });
+
+	// Admin commands
+	_commands.add(CommandBan::prefixes(),		PREFIX,	Tier::ADMIN, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandBan>(msg, sender, _parsec, _guests, _guestHistory, _ban); });
+	_commands.add(CommandDC::prefixes(),		PREFIX,	Tier::ADMIN, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandDC>(msg, _gamepadClient); });
+	_commands.add(CommandIdle::prefixes(),		PREFIX,	Tier::ADMIN, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandIdle>(msg); });
+	_commands.add(CommandKick::prefixes(),		PREFIX,	Tier::ADMIN, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandKick>(msg, sender, _parsec, _guests, isHost); });
+	_commands.add(CommandLimit::prefixes(),		PREFIX,	Tier::ADMIN, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandLimit>(msg, _guests, _gamepadClient); });
+	_commands.add(CommandMouse::prefixes(),		PREFIX,	Tier::ADMIN, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandMouse>(msg, _guests, _mouseRouter); });
+	_commands.add(CommandRotate::prefixes(),	PREFIX,	Tier::ADMIN, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandRotate>(msg, _gamepadClient); });
+	_commands.add(CommandStrip::prefixes(),		PREFIX,	Tier::ADMIN, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandStrip>(msg, sender, _gamepadClient); });
+	_commands.add(CommandUnban::prefixes(),		PREFIX,	Tier::ADMIN, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandUnban>(msg, sender, _ban, _guestHistory); });
+
+	// God commands
+	_commands.add(CommandGameId::prefixes(),	PREFIX,	Tier::GOD, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandGameId>(msg, _hostConfig); });
+	_commands.add(CommandGuests::prefixes(),	PREFIX,	Tier::GOD, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandGuests>(msg, _hostConfig); });
+	_commands.add(CommandKeymaps::prefixes(),	EXACT,	Tier::GOD, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandKeymaps>(_gamepadClient); });
+	_commands.add(CommandMic::prefixes(),		PREFIX,	Tier::GOD, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandMic>(msg, _audioIn); });
+	_commands.add(CommandName::prefixes(),		PREFIX,	Tier::GOD, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandName>(msg, _hostConfig); });
+	_commands.add(CommandPrivate::prefixes(),	EXACT,	Tier::GOD, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandPrivate>(_hostConfig); });
+	_commands.add(CommandPublic::prefixes(),	EXACT,	Tier::GOD, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandPublic>(_hostConfig); });
+	_commands.add(CommandSetConfig::prefixes(),	EXACT,	Tier::GOD, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandSetConfig>(_parsec, &_hostConfig, _parsecSession.sessionId.c_str()); });
+	_commands.add(CommandSpeakers::prefixes(),	PREFIX,	Tier::GOD, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandSpeakers>(msg, _audioOut); });
+	_commands.add(CommandQuit::prefixes(),		EXACT,	Tier::GOD, [this](const char* msg, Guest& sender, bool isHost) -> ACommand* { return CommandArena::make<CommandQuit>(_hostingLoopController); });
+}
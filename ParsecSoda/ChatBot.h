@@ -10,8 +10,10 @@
 #include "GamepadClient.h"
 #include "DX11.h"
 #include "TierList.h"
+#include "CommandRegistry.h"
 
 #include "Commands/ACommand.h"
+#include "Commands/CommandArena.h"
 #include "Commands/CommandAFK.h"
 #include "Commands/CommandBan.h"
 #include "Commands/CommandBonk.h"
@@ -20,26 +22,34 @@
 #include "Commands/CommandDC.h"
 #include "Commands/CommandFF.h"
 #include "Commands/CommandGameId.h"
+#include "Commands/CommandGrabMouse.h"
 #include "Commands/CommandGuests.h"
+#include "Commands/CommandKeymaps.h"
 #include "Commands/CommandHelp.h"
+#include "Commands/CommandIdle.h"
 #include "Commands/CommandIpFilter.h"
 #include "Commands/CommandJoin.h"
 #include "Commands/CommandKick.h"
 #include "Commands/CommandMic.h"
 #include "Commands/CommandMirror.h"
+#include "Commands/CommandMouse.h"
 #include "Commands/CommandName.h"
 #include "Commands/CommandLimit.h"
 #include "Commands/CommandOne.h"
 #include "Commands/CommandPads.h"
 #include "Commands/CommandPrivate.h"
 #include "Commands/CommandPublic.h"
+#include "Commands/CommandQueue.h"
 #include "Commands/CommandQuit.h"
+#include "Commands/CommandRotate.h"
 #include "Commands/CommandSetConfig.h"
 #include "Commands/CommandSFX.h"
 #include "Commands/CommandSpeakers.h"
 #include "Commands/CommandStrip.h"
 #include "Commands/CommandSwap.h"
+#include "Commands/CommandTransform.h"
 #include "Commands/CommandUnban.h"
+#include "Commands/CommandUnqueue.h"
 #include "Commands/CommandVideoFix.h"
 
 #define BOT_GUESTID 0
@@ -52,29 +62,34 @@ public:
 	ChatBot(
 		AudioIn& audioIn, AudioOut& audioOut, BanList& ban, Dice& dice, DX11& dx11,
 		GamepadClient& gamepadClient, GuestList& guests, GuestDataList& guestHistory, ParsecDSO* parsec, ParsecHostConfig& hostConfig,
-		ParsecSession& parsecSession, SFXList& sfxList, TierList& _tierList, bool& hostingLoopController, Guest& host
+		ParsecSession& parsecSession, SFXList& sfxList, TierList& _tierList, bool& hostingLoopController, Guest& host,
+		MouseRouter& mouseRouter
 	)
 		: _audioIn(audioIn), _audioOut(audioOut), _ban(ban), _dice(dice), _dx11(dx11), _gamepadClient(gamepadClient),
 		_guests(guests), _guestHistory(guestHistory), _parsec(parsec), _hostConfig(hostConfig), _parsecSession(parsecSession),
-		_sfxList(sfxList), _tierList(_tierList), _hostingLoopController(hostingLoopController), _host(host)
-	{}
+		_sfxList(sfxList), _tierList(_tierList), _hostingLoopController(hostingLoopController), _host(host),
+		_mouseRouter(mouseRouter)
+	{
+		registerCommands();
+	}
 
+	/** The command is built in this thread's CommandArena: hand it back with CommandArena::release(). */
 	ACommand * identifyUserDataMessage(const char* msg, Guest& sender, bool isHost = false);
 
 	const uint32_t getLastUserId() const;
 	void setLastUserId(const uint32_t lastId = BOT_GUESTID);
 
-	const std::string formatGuestConnection(Guest guest, ParsecGuestState state);
-	const std::string formatBannedGuestMessage(Guest guest);
+	/** Join/leave and ban notices, formatted into a buffer this thread reuses; good until the next call. */
+	const std::string& formatGuestConnection(const Guest& guest, ParsecGuestState state);
+	const std::string& formatBannedGuestMessage(const Guest& guest);
 	CommandBotMessage sendBotMessage(const char * msg);
 
 private:
-	static bool msgStartsWith(const char* msg, const char* pattern);
-	static bool msgStartsWith(const char* msg, vector<const char*> patterns);
-	static bool msgIsEqual(const char* msg, const char* pattern);
-	static bool msgIsEqual(const char* msg, vector<const char*> patterns);
+	void registerCommands();
 
 	uint32_t _lastUserId = 0;
+	CommandRegistry _commands;
+	size_t _ipFilterRank = 0;
 
 	// Dependency Injection
 	ParsecDSO* _parsec;
@@ -92,4 +107,5 @@ private:
 	TierList& _tierList;
 	bool &_hostingLoopController;
 	Guest& _host;
+	MouseRouter& _mouseRouter;
 };
\ No newline at end of file
@@ -1,12 +1,16 @@
 #include "ChatLog.h"
 
-void ChatLog::logCommand(string message)
+ChatLog::ChatLog(size_t commandCapacity, size_t messageCapacity)
+	: _commandLog(commandCapacity), _messageLog(messageCapacity)
 {
-	tryCleanOldCommands();
-	_commandLog.push_back(message);
 }
 
-void ChatLog::logMessage(string message)
+void ChatLog::logCommand(const string& message)
+{
+	_commandLog.push(message);
+}
+
+void ChatLog::logMessage(const string& message)
 {
 	if (
 		message.size() > 0 &&
@@ -15,8 +19,7 @@ void ChatLog::logMessage(string message)
 		message[0] != '['
 	)
 	{
-		tryCleanOldMessages();
-		_messageLog.push_back(message);
+		_messageLog.push(message);
 	}
 	else
 	{
@@ -24,30 +27,12 @@ void ChatLog::logMessage(string message)
 	}
 }
 
-vector<string>& ChatLog::getCommandLog()
+LogRing& ChatLog::getCommandLog()
 {
 	return _commandLog;
 }
 
-vector<string>& ChatLog::getMessageLog()
+LogRing& ChatLog::getMessageLog()
 {
 	return _messageLog;
 }
-
-void ChatLog::tryCleanOldCommands()
-{
-	if (_commandLog.size() > CHATLOG_COMMAND_LENGTH)
-	{
-		vector<string>::iterator it = _commandLog.begin();
-		_commandLog.erase(it, it + _commandLog.size() / 2);
-	}
-}
-
-void ChatLog::tryCleanOldMessages()
-{
-	if (_messageLog.size() > CHATLOG_MESSAGE_LENGTH)
-	{
-		vector<string>::iterator it = _messageLog.begin();
-		_messageLog.erase(it, it + _messageLog.size() / 2);
-	}
-}
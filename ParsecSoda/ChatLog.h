@@ -1,29 +1,30 @@
 #pragma once
 
-#include <vector>
 #include <string>
-#include <sstream>
-#include <regex>
+#include "LogRing.h"
 
-#define CHATLOG_COMMAND_LENGTH 200
-#define CHATLOG_MESSAGE_LENGTH 100
+#define CHATLOG_COMMAND_CAPACITY 2000
+#define CHATLOG_MESSAGE_CAPACITY 2000
 
 using namespace std;
 
+/**
+ * Chat and command history shown by ChatWidget and LogWidget.
+ * Both logs are LogRings: logging is a copy into a fixed buffer from any
+ * thread, and the widgets pull new lines without ever blocking it.
+ */
 class ChatLog
 {
 public:
-	void logCommand(string message);
-	void logMessage(string message);
+	ChatLog(size_t commandCapacity = CHATLOG_COMMAND_CAPACITY, size_t messageCapacity = CHATLOG_MESSAGE_CAPACITY);
 
-	vector<string>& getCommandLog();
-	vector<string>& getMessageLog();
+	void logCommand(const string& message);
+	void logMessage(const string& message);
 
-private:
-	void tryCleanOldCommands();
-	void tryCleanOldMessages();
+	LogRing& getCommandLog();
+	LogRing& getMessageLog();
 
-	vector<string> _commandLog;
-	vector<string> _messageLog;
+private:
+	LogRing _commandLog;
+	LogRing _messageLog;
 };
-
@@ -0,0 +1,309 @@
+#include "ChatOutbox.h"
+
+ChatOutbox::ChatOutbox()
+{
+	for (size_t i = 0; i < CHAT_OUTBOX_PAYLOADS; i++)
+	{
+		_payloads[i].text.reserve(CHAT_OUTBOX_PAYLOAD_RESERVE);
+		_free[i] = (uint16_t)(CHAT_OUTBOX_PAYLOADS - 1 - i);
+	}
+	_freeCount = CHAT_OUTBOX_PAYLOADS;
+}
+
+ChatOutbox::~ChatOutbox()
+{
+	stop();
+}
+
+void ChatOutbox::start(ParsecDSO* parsec, uint32_t messageID)
+{
+	lock_guard<mutex> lock(_mutex);
+	_parsec = parsec;
+	_messageID = messageID;
+	if (_isRunning || _thread.joinable())
+	{
+		return;
+	}
+
+	_isRunning = true;
+	_thread = thread([this]() { run(); });
+}
+
+void ChatOutbox::stop()
+{
+	{
+		lock_guard<mutex> lock(_mutex);
+		_isRunning = false;
+	}
+
+	_wake.notify_all();
+	if (_thread.joinable())
+	{
+		_thread.join();
+	}
+}
+
+void ChatOutbox::enqueue(const uint32_t* guestIDs, size_t count, const string& message, bool isSystem)
+{
+	unique_lock<mutex> lock(_mutex);
+	_stats.enqueued++;
+
+	if (!_isRunning)
+	{
+		lock.unlock();
+		sendNow(guestIDs, count, message);
+		return;
+	}
+
+	int payload = isSystem ? findPending(message) : -1;
+	const bool isShared = (payload >= 0);
+	if (!isShared)
+	{
+		payload = acquirePayload();
+		if (payload < 0)
+		{
+			_stats.dropped += count;
+			return;
+		}
+
+		Payload& fresh = _payloads[payload];
+		fresh.text.assign(message);
+		fresh.enqueuedUs = nowUs();
+		fresh.isSystem = isSystem;
+	}
+
+	for (size_t i = 0; i < count; i++)
+	{
+		Lane* lane = findLane(guestIDs[i]);
+		if (lane == nullptr)
+		{
+			_stats.dropped++;
+			continue;
+		}
+
+		if (isShared && lane->contains((uint16_t)payload))
+		{
+			_stats.deduped++;
+			continue;
+		}
+
+		// A guest that can't keep up loses its oldest line, not everyone's memory.
+		if (lane->count >= CHAT_OUTBOX_GUEST_DEPTH)
+		{
+			releasePayload(lane->pop());
+			_stats.depth--;
+			_stats.dropped++;
+		}
+
+		lane->push((uint16_t)payload);
+		_payloads[payload].refs++;
+		_stats.depth++;
+	}
+
+	if (_payloads[payload].refs == 0)
+	{
+		_free[_freeCount++] = (uint16_t)payload;
+	}
+
+	_wake.notify_one();
+}
+
+void ChatOutbox::clear(uint32_t guestID)
+{
+	lock_guard<mutex> lock(_mutex);
+
+	for (size_t i = 0; i < GUESTLIST_MAX_GUESTS; i++)
+	{
+		Lane& lane = _lanes[i];
+		if (lane.guestID == guestID)
+		{
+			while (lane.count > 0)
+			{
+				releasePayload(lane.pop());
+				_stats.depth--;
+			}
+		}
+	}
+}
+
+const ChatOutbox::Stats ChatOutbox::getStats()
+{
+	lock_guard<mutex> lock(_mutex);
+	return _stats;
+}
+
+const string ChatOutbox::report()
+{
+	const Stats stats = getStats();
+
+	std::ostringstream reply;
+	reply << "[Chat] | " << stats.depth << " queued now, "
+		<< stats.enqueued << " lines, " << stats.sent << " sends, "
+		<< stats.dropped << " dropped, " << stats.deduped << " deduplicated";
+
+	if (stats.sent > 0)
+	{
+		reply << "\n  Send latency:\tlast " << (stats.lastLatencyUs / 1000.0) << " ms"
+			<< ", avg " << ((double)stats.totalLatencyUs / stats.sent / 1000.0) << " ms"
+			<< ", max " << (stats.maxLatencyUs / 1000.0) << " ms";
+	}
+
+	return reply.str();
+}
+
+
+// =============================================================
+//
+//  Private
+//
+// =============================================================
+
+void ChatOutbox::run()
+{
+	unique_lock<mutex> lock(_mutex);
+
+	while (true)
+	{
+		_wake.wait(lock, [this]() { return !_isRunning || _stats.depth > 0; });
+		if (_stats.depth == 0)
+		{
+			break;
+		}
+
+		// One line per guest per pass, starting one lane further each time.
+		for (size_t n = 0; n < GUESTLIST_MAX_GUESTS; n++)
+		{
+			Lane& lane = _lanes[(_nextLane + n) % GUESTLIST_MAX_GUESTS];
+			if (lane.count == 0)
+			{
+				continue;
+			}
+
+			const uint32_t guestID = lane.guestID;
+			const uint16_t payload = lane.pop();
+			_stats.depth--;
+
+			// The payload can't be reused while we hold a reference, so its text is safe unlocked.
+			const char* text = _payloads[payload].text.c_str();
+			lock.unlock();
+			ParsecHostSendUserData(_parsec, guestID, _messageID, text);
+			const uint64_t sentUs = nowUs();
+			lock.lock();
+
+			const uint64_t latency = sentUs - _payloads[payload].enqueuedUs;
+			_stats.sent++;
+			_stats.lastLatencyUs = latency;
+			_stats.maxLatencyUs = (latency > _stats.maxLatencyUs) ? latency : _stats.maxLatencyUs;
+			_stats.totalLatencyUs += latency;
+			releasePayload(payload);
+		}
+		_nextLane = (_nextLane + 1) % GUESTLIST_MAX_GUESTS;
+	}
+}
+
+void ChatOutbox::sendNow(const uint32_t* guestIDs, size_t count, const string& message)
+{
+	if (_parsec == nullptr)
+	{
+		return;
+	}
+
+	for (size_t i = 0; i < count; i++)
+	{
+		ParsecHostSendUserData(_parsec, guestIDs[i], _messageID, message.c_str());
+	}
+
+	lock_guard<mutex> lock(_mutex);
+	_stats.sent += count;
+}
+
+ChatOutbox::Lane* ChatOutbox::findLane(uint32_t guestID)
+{
+	Lane* idle = nullptr;
+	for (size_t i = 0; i < GUESTLIST_MAX_GUESTS; i++)
+	{
+		Lane& lane = _lanes[i];
+		if (lane.guestID == guestID)
+		{
+			return &lane;
+		}
+		if (idle == nullptr && lane.count == 0)
+		{
+			idle = &lane;
+		}
+	}
+
+	if (idle != nullptr)
+	{
+		idle->guestID = guestID;
+		idle->head = 0;
+	}
+
+	return idle;
+}
+
+int ChatOutbox::findPending(const string& message) const
+{
+	for (size_t i = 0; i < CHAT_OUTBOX_PAYLOADS; i++)
+	{
+		const Payload& payload = _payloads[i];
+		if (payload.refs > 0 && payload.isSystem && payload.text == message)
+		{
+			return (int)i;
+		}
+	}
+
+	return -1;
+}
+
+int ChatOutbox::acquirePayload()
+{
+	if (_freeCount == 0)
+	{
+		return -1;
+	}
+
+	return _free[--_freeCount];
+}
+
+void ChatOutbox::releasePayload(uint16_t payload)
+{
+	if (--_payloads[payload].refs == 0)
+	{
+		_free[_freeCount++] = payload;
+	}
+}
+
+uint64_t ChatOutbox::nowUs()
+{
+	return (uint64_t)chrono::duration_cast<chrono::microseconds>(
+		chrono::steady_clock::now().time_since_epoch()
+	).count();
+}
+
+bool ChatOutbox::Lane::contains(uint16_t payload) const
+{
+	for (uint16_t i = 0; i < count; i++)
+	{
+		if (items[(head + i) % CHAT_OUTBOX_GUEST_DEPTH] == payload)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void ChatOutbox::Lane::push(uint16_t payload)
+{
+	items[(head + count) % CHAT_OUTBOX_GUEST_DEPTH] = payload;
+	count++;
+}
+
+uint16_t ChatOutbox::Lane::pop()
+{
+	const uint16_t payload = items[head];
+	head = (uint16_t)((head + 1) % CHAT_OUTBOX_GUEST_DEPTH);
+	count--;
+	return payload;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include "parsec-dso.h"
+#include "GuestList.h"
+
+#define CHAT_OUTBOX_PAYLOADS 128
+#define CHAT_OUTBOX_PAYLOAD_RESERVE 256
+#define CHAT_OUTBOX_GUEST_DEPTH 32
+
+using namespace std;
+
+/**
+ * Outgoing chat, sent from its own thread so no caller loops over the room.
+ * enqueue() copies the text once into a pooled payload and files it in a
+ * small queue per guest; the sender thread then takes one message from
+ * each guest in turn, so a guest with a long backlog doesn't hold up the
+ * others. A guest whose queue is full loses its oldest message instead of
+ * growing it. System messages that are still waiting to go out aren't
+ * queued twice, so a burst of identical bot replies reaches each guest once.
+ *
+ * Payloads and queues are fixed arrays: once the payload strings have grown,
+ * queuing a line costs no allocations. Before start() and after stop(),
+ * enqueue() sends right away on the caller's thread.
+ */
+class ChatOutbox
+{
+public:
+	class Stats
+	{
+	public:
+		size_t depth = 0;
+		uint64_t enqueued = 0;
+		uint64_t sent = 0;
+		uint64_t dropped = 0;
+		uint64_t deduped = 0;
+		uint64_t lastLatencyUs = 0;
+		uint64_t maxLatencyUs = 0;
+		uint64_t totalLatencyUs = 0;
+	};
+
+	ChatOutbox();
+	~ChatOutbox();
+
+	void start(ParsecDSO* parsec, uint32_t messageID);
+	/** Sends what is still queued, then joins the thread. */
+	void stop();
+	void enqueue(const uint32_t* guestIDs, size_t count, const string& message, bool isSystem = true);
+	void clear(uint32_t guestID);
+
+	const Stats getStats();
+	const string report();
+
+private:
+	class Payload
+	{
+	public:
+		string text;
+		uint32_t refs = 0;
+		uint64_t enqueuedUs = 0;
+		bool isSystem = false;
+	};
+
+	class Lane
+	{
+	public:
+		uint32_t guestID = 0;
+		uint16_t head = 0;
+		uint16_t count = 0;
+		uint16_t items[CHAT_OUTBOX_GUEST_DEPTH];
+
+		bool contains(uint16_t payload) const;
+		void push(uint16_t payload);
+		uint16_t pop();
+	};
+
+	void run();
+	void sendNow(const uint32_t* guestIDs, size_t count, const string& message);
+	Lane* findLane(uint32_t guestID);
+	int findPending(const string& message) const;
+	int acquirePayload();
+	void releasePayload(uint16_t payload);
+	static uint64_t nowUs();
+
+	ParsecDSO* _parsec = nullptr;
+	uint32_t _messageID = 0;
+	bool _isRunning = false;
+
+	Payload _payloads[CHAT_OUTBOX_PAYLOADS];
+	uint16_t _free[CHAT_OUTBOX_PAYLOADS];
+	size_t _freeCount = 0;
+	Lane _lanes[GUESTLIST_MAX_GUESTS];
+	size_t _nextLane = 0;
+	Stats _stats;
+
+	thread _thread;
+	mutex _mutex;
+	condition_variable _wake;
+};
@@ -0,0 +1,177 @@
+#include "ChatRateLimiter.h"
+
+#define CHAT_LIMIT_TOKEN 1000000ULL
+#define CHAT_LIMIT_FNV_OFFSET 14695981039346656037ULL
+#define CHAT_LIMIT_FNV_PRIME 1099511628211ULL
+
+ChatRateLimiter::ChatRateLimiter()
+{
+	// perMinute, burst, repeats, warnAt, muteAt, kickAt, muteSeconds
+	_policies[(int)Tier::PLEB]	= { 20, 5, 2, 3, 6, 12, 30 };
+	_policies[(int)Tier::ADMIN]	= { 60, 10, 3, 5, 0, 0, 0 };
+	_policies[(int)Tier::GOD]	= { 0, 0, 0, 0, 0, 0, 0 };
+}
+
+void ChatRateLimiter::reset()
+{
+	_guests.clear();
+	_stats = Stats();
+}
+
+void ChatRateLimiter::forget(uint32_t userID)
+{
+	_guests.erase(userID);
+}
+
+void ChatRateLimiter::setPolicy(Tier tier, Policy policy)
+{
+	_policies[(int)tier] = policy;
+}
+
+const ChatRateLimiter::Policy& ChatRateLimiter::getPolicy(Tier tier) const
+{
+	return _policies[(int)tier];
+}
+
+ChatRateLimiter::Action ChatRateLimiter::check(uint32_t userID, Tier tier, const char* message, uint64_t nowUs)
+{
+	const Policy& policy = _policies[(int)tier];
+	if (policy.perMinute == 0)
+	{
+		_stats.passed++;
+		return Action::PASS;
+	}
+
+	GuestState& state = _guests[userID];
+	if (state.strikes > 0 && nowUs - state.lastStrikeUs >= CHAT_LIMIT_STRIKE_DECAY_US)
+	{
+		state.strikes = 0;
+	}
+
+	// Muted guests are dropped quietly; a mute is not something to keep adding strikes to.
+	if (nowUs < state.mutedUntilUs)
+	{
+		_stats.dropped++;
+		return Action::DROP;
+	}
+
+	const bool isRepeated = isDuplicate(state, policy, message, nowUs);
+	if (!isRepeated && take(state, policy, nowUs))
+	{
+		_stats.passed++;
+		return Action::PASS;
+	}
+
+	if (isRepeated)
+	{
+		_stats.duplicates++;
+	}
+
+	return strike(state, policy, nowUs);
+}
+
+const ChatRateLimiter::Stats ChatRateLimiter::getStats() const
+{
+	return _stats;
+}
+
+uint64_t ChatRateLimiter::now()
+{
+	return (uint64_t)chrono::duration_cast<chrono::microseconds>(
+		chrono::steady_clock::now().time_since_epoch()
+	).count();
+}
+
+
+// =============================================================
+//
+//  Private
+//
+// =============================================================
+
+bool ChatRateLimiter::take(GuestState& state, const Policy& policy, uint64_t nowUs)
+{
+	const uint64_t capacity = (uint64_t)policy.burst * CHAT_LIMIT_TOKEN;
+
+	if (state.lastUs == 0)
+	{
+		state.tokens = capacity;
+	}
+	else if (nowUs > state.lastUs)
+	{
+		state.tokens += (nowUs - state.lastUs) * policy.perMinute / 60;
+		if (state.tokens > capacity) state.tokens = capacity;
+	}
+	state.lastUs = nowUs;
+
+	if (state.tokens >= CHAT_LIMIT_TOKEN)
+	{
+		state.tokens -= CHAT_LIMIT_TOKEN;
+		return true;
+	}
+
+	return false;
+}
+
+bool ChatRateLimiter::isDuplicate(GuestState& state, const Policy& policy, const char* message, uint64_t nowUs)
+{
+	const uint64_t messageHash = hash(message);
+	if (messageHash == state.lastHash && nowUs - state.lastMessageUs < CHAT_LIMIT_DUPLICATE_WINDOW_US)
+	{
+		state.repeats++;
+	}
+	else
+	{
+		state.lastHash = messageHash;
+		state.repeats = 0;
+	}
+	state.lastMessageUs = nowUs;
+
+	return policy.repeats > 0 && state.repeats >= policy.repeats;
+}
+
+ChatRateLimiter::Action ChatRateLimiter::strike(GuestState& state, const Policy& policy, uint64_t nowUs)
+{
+	state.strikes++;
+	state.lastStrikeUs = nowUs;
+
+	if (policy.kickAt > 0 && state.strikes >= policy.kickAt)
+	{
+		state.strikes = 0;
+		_stats.kicked++;
+		return Action::KICK;
+	}
+
+	if (policy.muteAt > 0 && state.strikes == policy.muteAt)
+	{
+		state.mutedUntilUs = nowUs + (uint64_t)policy.muteSeconds * 1000000ULL;
+		_stats.muted++;
+		return Action::MUTE;
+	}
+
+	if (policy.warnAt > 0 && state.strikes == policy.warnAt)
+	{
+		_stats.warned++;
+		return Action::WARN;
+	}
+
+	_stats.dropped++;
+	return Action::DROP;
+}
+
+uint64_t ChatRateLimiter::hash(const char* message)
+{
+	// Case and spacing don't make a line new: "GG  gg" repeats "gg gg".
+	uint64_t result = CHAT_LIMIT_FNV_OFFSET;
+	for (const char* c = message; *c != '\0'; ++c)
+	{
+		char folded = *c;
+		if (folded == ' ' || folded == '\t')	continue;
+		if (folded >= 'A' && folded <= 'Z')	folded = (char)(folded - 'A' + 'a');
+
+		result ^= (uint8_t)folded;
+		result *= CHAT_LIMIT_FNV_PRIME;
+	}
+
+	return result;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <chrono>
+#include "Tier.h"
+
+#define CHAT_LIMIT_TIER_COUNT 3
+#define CHAT_LIMIT_DUPLICATE_WINDOW_US 10000000ULL
+#define CHAT_LIMIT_STRIKE_DECAY_US 60000000ULL
+
+using namespace std;
+
+/**
+ * Per-guest chat budget in front of Hosting::handleMessage.
+ * Each guest has a token bucket and remembers a hash of their last line; a
+ * line over budget, or the same line repeated more than a Policy allows
+ * within CHAT_LIMIT_DUPLICATE_WINDOW_US, is a strike. Strikes escalate from
+ * a silent drop to a warning, a mute and finally a kick, at thresholds set
+ * per Tier. Strikes are forgotten after CHAT_LIMIT_STRIKE_DECAY_US without a
+ * new one. A threshold of 0 disables that step, and a Policy with
+ * perMinute 0 is never limited. The host never goes through here.
+ *
+ * One hash and one map lookup per line. Not thread safe: meant to live on the event thread.
+ */
+class ChatRateLimiter
+{
+public:
+	enum class Action
+	{
+		PASS,
+		DROP,
+		WARN,
+		MUTE,
+		KICK
+	};
+
+	class Policy
+	{
+	public:
+		uint32_t perMinute;
+		uint32_t burst;
+		/** Identical lines in a row that are let through. */
+		uint32_t repeats;
+		uint32_t warnAt;
+		uint32_t muteAt;
+		uint32_t kickAt;
+		uint32_t muteSeconds;
+	};
+
+	class Stats
+	{
+	public:
+		uint64_t passed = 0;
+		uint64_t dropped = 0;
+		uint64_t duplicates = 0;
+		uint64_t warned = 0;
+		uint64_t muted = 0;
+		uint64_t kicked = 0;
+	};
+
+	ChatRateLimiter();
+	void reset();
+	void forget(uint32_t userID);
+	void setPolicy(Tier tier, Policy policy);
+	const Policy& getPolicy(Tier tier) const;
+	Action check(uint32_t userID, Tier tier, const char* message, uint64_t nowUs);
+	const Stats getStats() const;
+
+	static uint64_t now();
+
+private:
+	class GuestState
+	{
+	public:
+		/** Scaled by 1e6 per minute so refill is integer math on microseconds. */
+		uint64_t tokens = 0;
+		uint64_t lastUs = 0;
+		uint64_t lastHash = 0;
+		uint64_t lastMessageUs = 0;
+		uint32_t repeats = 0;
+		uint32_t strikes = 0;
+		uint64_t lastStrikeUs = 0;
+		uint64_t mutedUntilUs = 0;
+	};
+
+	bool take(GuestState& state, const Policy& policy, uint64_t nowUs);
+	bool isDuplicate(GuestState& state, const Policy& policy, const char* message, uint64_t nowUs);
+	Action strike(GuestState& state, const Policy& policy, uint64_t nowUs);
+	static uint64_t hash(const char* message);
+
+	Policy _policies[CHAT_LIMIT_TIER_COUNT];
+	unordered_map<uint32_t, GuestState> _guests;
+	Stats _stats;
+};
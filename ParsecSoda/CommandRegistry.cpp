@@ -0,0 +1,106 @@
+#include "CommandRegistry.h"
+
+#define COMMAND_REGISTRY_NO_NODE 0
+
+void CommandRegistry::add(vector<const char*> patterns, bool isExact, Tier tier, Factory factory)
+{
+	const size_t rank = _nextRank++;
+
+	vector<const char*>::iterator pi = patterns.begin();
+	for (; pi != patterns.end(); ++pi)
+	{
+		Entry entry;
+		entry.pattern = *pi;
+		entry.isExact = isExact;
+		entry.tier = tier;
+		entry.rank = rank;
+		entry.factory = factory;
+
+		uint32_t node = 0;
+		for (const char* c = *pi; *c != '\0'; ++c)
+		{
+			uint32_t next = child(node, fold(*c));
+			if (next == COMMAND_REGISTRY_NO_NODE)
+			{
+				next = (uint32_t)_nodes.size();
+				_nodes.push_back(Node());
+				_nodes[node].children.push_back(make_pair(fold(*c), next));
+			}
+			node = next;
+		}
+
+		_nodes[node].entries.push_back((uint32_t)_entries.size());
+		_entries.push_back(entry);
+	}
+}
+
+size_t CommandRegistry::reserveRank()
+{
+	return _nextRank++;
+}
+
+const CommandRegistry::Entry* CommandRegistry::find(const char* msg, Tier tier, bool isHost) const
+{
+	const Entry* result = nullptr;
+	uint32_t node = 0;
+	const char* c = msg;
+
+	while (true)
+	{
+		const vector<uint32_t>& entries = _nodes[node].entries;
+		for (size_t i = 0; i < entries.size(); i++)
+		{
+			const Entry& entry = _entries[entries[i]];
+			if (result != nullptr && result->rank <= entry.rank)				continue;
+			if (!isHost && tier < entry.tier)									continue;
+			if (entry.isExact && (*c != '\0' || strcmp(msg, entry.pattern) != 0))	continue;
+
+			result = &entry;
+		}
+
+		if (*c == '\0')
+		{
+			break;
+		}
+
+		node = child(node, fold(*c));
+		if (node == COMMAND_REGISTRY_NO_NODE)
+		{
+			break;
+		}
+		++c;
+	}
+
+	return result;
+}
+
+size_t CommandRegistry::size() const
+{
+	return _entries.size();
+}
+
+
+// =============================================================
+//
+//  Private
+//
+// =============================================================
+
+char CommandRegistry::fold(char c)
+{
+	return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+}
+
+uint32_t CommandRegistry::child(uint32_t node, char c) const
+{
+	const vector<pair<char, uint32_t>>& children = _nodes[node].children;
+	for (size_t i = 0; i < children.size(); i++)
+	{
+		if (children[i].first == c)
+		{
+			return children[i].second;
+		}
+	}
+
+	return COMMAND_REGISTRY_NO_NODE;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <functional>
+#include "Commands/ACommand.h"
+#include "Guest.h"
+#include "Tier.h"
+
+using namespace std;
+
+/**
+ * Chat command lookup, built once when the ChatBot starts.
+ * Patterns live in a case-folded prefix trie, so identifying a message is a
+ * single walk over its first characters: plain chat leaves at the root and a
+ * command never looks at patterns that don't share its prefix.
+ *
+ * Matching follows the old if-chain exactly. Exact patterns must equal the
+ * whole message (case-sensitive), other patterns match a case-insensitive
+ * prefix, and when several match the one registered first wins. Each entry
+ * records the Tier it needs; the host passes every check.
+ */
+class CommandRegistry
+{
+public:
+	typedef function<ACommand*(const char* msg, Guest& sender, bool isHost)> Factory;
+
+	class Entry
+	{
+	public:
+		const char* pattern = nullptr;
+		bool isExact = false;
+		Tier tier = Tier::PLEB;
+		size_t rank = 0;
+		Factory factory;
+	};
+
+	void add(vector<const char*> patterns, bool isExact, Tier tier, Factory factory);
+
+	/** Takes a rank without an entry, for checks that run between commands (see ChatBot). */
+	size_t reserveRank();
+
+	const Entry* find(const char* msg, Tier tier, bool isHost) const;
+	size_t size() const;
+
+private:
+	class Node
+	{
+	public:
+		vector<pair<char, uint32_t>> children;
+		vector<uint32_t> entries;
+	};
+
+	static char fold(char c);
+	uint32_t child(uint32_t node, char c) const;
+
+	vector<Node> _nodes = vector<Node>(1);
+	vector<Entry> _entries;
+	size_t _nextRank = 0;
+};
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <vector>
+#include "CommandReply.h"
 
 enum class COMMAND_TYPE
 {
@@ -14,26 +15,34 @@ enum class COMMAND_TYPE
 	DC,
 	FF,
 	GAMEID,
+	GRABMOUSE,
 	GUESTS,
 	HELP,
+	IDLE,
 	IP,
 	JOIN,
+	KEYMAPS,
 	KICK,
 	LIMIT,
 	MIC,
 	MIRROR,
+	MOUSE,
 	NAME,
 	ONE,
 	PADS,
 	PRIVATE,
 	PUBLIC,
+	QUEUE,
 	QUIT,
+	ROTATE,
 	SETCONFIG,
 	SFX,
 	SPEAKERS,
 	SWAP,
 	TAKE,
+	TRANSFORM,
 	UNBAN,
+	UNQUEUE,
 	VIDEOFIX,
 	
 	// Search + number
@@ -43,10 +52,38 @@ enum class COMMAND_TYPE
 class ACommand
 {
 public:
+	virtual ~ACommand() {}
 	virtual const COMMAND_TYPE type() { return COMMAND_TYPE::INVALID; }
 	virtual bool run() = 0;
-	const std::string replyMessage() const { return _replyMessage; }
+	const std::string& replyMessage() const { return (_reply != nullptr) ? *_reply : CommandReply::empty(); }
 
 protected:
-	std::string _replyMessage = "";
+	/** Formats the reply into this thread's reply buffer (see CommandReply). */
+	template <typename... Args>
+	void setReply(const Args&... args)
+	{
+		_reply = &CommandReply::format(args...);
+	}
+
+	/** Clears this thread's reply buffer and points the reply at it, for replies built piece by piece. */
+	std::string& beginReply()
+	{
+		std::string& out = CommandReply::buffer();
+		out.clear();
+		_reply = &out;
+		return out;
+	}
+
+	/** For text that outlives the command, such as tables built once. */
+	void setConstantReply(const std::string& text)
+	{
+		_reply = &text;
+	}
+
+	void clearReply()
+	{
+		_reply = nullptr;
+	}
+
+	const std::string* _reply = nullptr;
 };
\ No newline at end of file
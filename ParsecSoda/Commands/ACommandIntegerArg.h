@@ -1,11 +1,12 @@
 #pragma once
 
 #include "ACommandPrefix.h"
+#include <climits>
 
 class ACommandIntegerArg : public ACommandPrefix
 {
 public:
-	ACommandIntegerArg(const char* msg, vector<const char*> prefixes)
+	ACommandIntegerArg(const char* msg, const vector<const char*>& prefixes)
 		: ACommandPrefix(msg, prefixes), _intArg(0)
 	{}
 
@@ -16,18 +17,14 @@ public:
 			return false;
 		}
 
-		try
-		{
-			std::string str = _msg;
-			size_t cmdSize = strlen(_prefix);
-			_intArg = std::stoi(str.substr(cmdSize));
-
-			return true;
-		}
-		catch (const std::exception&)
+		long value = 0;
+		if (!parseNumber(argument(), value) || value < INT_MIN || value > INT_MAX)
 		{
 			return false;
 		}
+
+		_intArg = (int)value;
+		return true;
 	}
 
 protected:
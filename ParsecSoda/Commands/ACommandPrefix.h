@@ -3,17 +3,21 @@
 #include "ACommand.h"
 #include "../Stringer.h"
 #include <vector>
+#include <cstdlib>
+#include <cerrno>
+#include <cstring>
 
 class ACommandPrefix : public ACommand
 {
 public:
-	ACommandPrefix(const char* msg, vector<const char*> prefixes)
-		: _msg(msg), _prefixes(prefixes), _prefix("")
+	/** prefixes must outlive the command: commands pass their static internalPrefixes(). */
+	ACommandPrefix(const char* msg, const vector<const char*>& prefixes)
+		: _msg(msg), _prefix(""), _prefixes(prefixes)
 	{}
 
 	bool run() override
 	{
-		vector<const char*>::iterator prefix = _prefixes.begin();
+		vector<const char*>::const_iterator prefix = _prefixes.begin();
 		for (; prefix != _prefixes.end(); ++prefix)
 		{
 			if (Stringer::startsWithPattern(_msg, *prefix))
@@ -27,7 +31,28 @@ public:
 	}
 
 protected:
+	/** The message past the matched prefix. */
+	const char* argument() const
+	{
+		return _msg + strlen(_prefix);
+	}
+
+	/** Same numbers stol would take (leading digits, optional sign), without throwing on the rest. */
+	static bool parseNumber(const char* text, long& value)
+	{
+		char* end = nullptr;
+		errno = 0;
+		const long result = strtol(text, &end, 10);
+		if (end == text || errno == ERANGE)
+		{
+			return false;
+		}
+
+		value = result;
+		return true;
+	}
+
 	const char* _msg;
 	const char* _prefix;
-	vector<const char*> _prefixes;
+	const vector<const char*>& _prefixes;
 };
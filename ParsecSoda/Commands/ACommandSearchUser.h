@@ -15,10 +15,12 @@ enum class SEARCH_USER_RESULT
 class ACommandSearchUser : public ACommandPrefix
 {
 public:
-	ACommandSearchUser(const char* msg, vector<const char*> prefixes, GuestList &guests)
+	ACommandSearchUser(const char* msg, const vector<const char*>& prefixes, GuestList &guests)
 		: ACommandPrefix(msg, prefixes), _guests(guests),
-		_searchResult(SEARCH_USER_RESULT::FAILED), _targetGuest(Guest())
-	{}
+		_searchResult(SEARCH_USER_RESULT::FAILED), _targetGuest(Guest()), _targetUsername(CommandReply::buffer<ACommandSearchUser>())
+	{
+		_targetUsername.clear();
+	}
 
 	bool run() override
 	{
@@ -30,16 +32,14 @@ public:
 
 		try
 		{
-			std::string str = _msg;
-			size_t cmdSize = strlen(_prefix);
-			_targetUsername = str.substr(cmdSize);
+			_targetUsername.assign(argument());
 
 			bool found = false;
-			try
+			long userID = 0;
+			if (parseNumber(_targetUsername.c_str(), userID))
 			{
-				found = _guests.find(stoul(_targetUsername), &_targetGuest);
+				found = _guests.find((uint32_t)userID, &_targetGuest);
 			}
-			catch (const std::exception&) {}
 
 			if (!found)
 			{
@@ -60,6 +60,7 @@ protected:
 	SEARCH_USER_RESULT _searchResult;
 	GuestList& _guests;
 	Guest _targetGuest;
-	string _targetUsername;
+	/** This thread's argument buffer, like ACommandStringArg's. */
+	string& _targetUsername;
 };
 
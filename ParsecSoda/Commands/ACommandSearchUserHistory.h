@@ -17,10 +17,13 @@ class ACommandSearchUserHistory : public ACommandPrefix
 {
 public:
 
-	ACommandSearchUserHistory(const char* msg, vector<const char*> prefixes, GuestList &guests, GuestDataList &guestHistory)
+	ACommandSearchUserHistory(const char* msg, const vector<const char*>& prefixes, GuestList &guests, GuestDataList &guestHistory)
 		: ACommandPrefix(msg, prefixes), _guests(guests), _guestHistory(guestHistory),
-		_searchResult(SEARCH_USER_HISTORY_RESULT::FAILED), _onlineGuest(Guest()), _offlineGuest(GuestData())
-	{}
+		_searchResult(SEARCH_USER_HISTORY_RESULT::FAILED), _onlineGuest(Guest()), _offlineGuest(GuestData()),
+		_targetUsername(CommandReply::buffer<ACommandSearchUserHistory>())
+	{
+		_targetUsername.clear();
+	}
 
 	bool run() override
 	{
@@ -34,14 +37,13 @@ public:
 		{
 			_searchResult = SEARCH_USER_HISTORY_RESULT::NOT_FOUND;
 
-			std::string str = _msg;
-			size_t cmdSize = strlen(_prefix);
-			_targetUsername = str.substr(cmdSize);
+			_targetUsername.assign(argument());
 
 			bool found = false;
-			try
+			long parsedID = 0;
+			if (parseNumber(_targetUsername.c_str(), parsedID))
 			{
-				uint32_t userID = stoul(_targetUsername);
+				const uint32_t userID = (uint32_t)parsedID;
 
 				found = _guests.find(userID, &_onlineGuest);
 				if (found)
@@ -54,7 +56,6 @@ public:
 					_searchResult = found ? SEARCH_USER_HISTORY_RESULT::OFFLINE : SEARCH_USER_HISTORY_RESULT::NOT_FOUND;
 				}
 			}
-			catch (const std::exception&) {}
 
 			if (!found)
 			{
@@ -85,6 +86,7 @@ protected:
 	GuestList& _guests;
 	Guest _onlineGuest;
 	GuestData _offlineGuest;
-	string _targetUsername;
+	/** This thread's argument buffer, like ACommandStringArg's. */
+	string& _targetUsername;
 };
 
@@ -6,9 +6,11 @@
 class ACommandStringArg : public ACommandPrefix
 {
 public:
-	ACommandStringArg(const char* msg, vector<const char*> prefixes)
-		: ACommandPrefix(msg, prefixes), _stringArg("")
-	{}
+	ACommandStringArg(const char* msg, const vector<const char*>& prefixes)
+		: ACommandPrefix(msg, prefixes), _stringArg(CommandReply::buffer<ACommandStringArg>())
+	{
+		_stringArg.clear();
+	}
 
 	bool run()
 	{
@@ -17,13 +19,12 @@ public:
 			return false;
 		}
 
-		size_t cmdSize = strlen(_prefix);
-		std::string str = _msg;
-		_stringArg = str.substr(cmdSize);
+		_stringArg.assign(argument());
 
 		return true;
 	}
 
 protected:
-	string _stringArg;
+	/** This thread's argument buffer, reused like the reply buffers: one command runs at a time. */
+	string& _stringArg;
 };
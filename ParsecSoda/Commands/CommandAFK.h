@@ -1,6 +1,5 @@
 #pragma once
 
-#include <sstream>
 #include "../GamepadClient.h"
 #include "../GuestList.h"
 
@@ -17,10 +16,8 @@ public:
 	{
 		int clearCount = _padClient.clearAFK(_guests);
 
-		std::ostringstream reply;
-		reply << "[ChatBot] | Retrieving AFK gamepads... Gamepads cleared:  " << clearCount << "\0";
+		setReply("[ChatBot] | Retrieving AFK gamepads... Gamepads cleared:  ", clearCount);
 
-		_replyMessage = reply.str();
 
 		return true;
 	}
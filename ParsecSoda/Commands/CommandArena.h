@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "ACommand.h"
+
+#define COMMAND_ARENA_SIZE 1024
+
+/**
+ * One command's worth of storage per thread, reused for every chat message.
+ * ChatBot builds the command it identified here instead of on the heap, and
+ * whoever ran it hands it back with release(). A thread only ever has one
+ * message in flight, so one slot is enough; should a second command be made
+ * before the first is released, it simply goes to the heap.
+ */
+class CommandArena
+{
+public:
+	template <typename T, typename... Args>
+	static T* make(Args&&... args)
+	{
+		static_assert(sizeof(T) <= COMMAND_ARENA_SIZE, "Command doesn't fit the arena; raise COMMAND_ARENA_SIZE.");
+		static_assert(alignof(T) <= alignof(std::max_align_t), "Command is over-aligned for the arena.");
+
+		Slot& slot = current();
+		if (slot.isBusy)
+		{
+			return new T(std::forward<Args>(args)...);
+		}
+
+		T* command = new (slot.buffer) T(std::forward<Args>(args)...);
+		slot.isBusy = true;
+		return command;
+	}
+
+	static void release(ACommand* command)
+	{
+		if (command == nullptr)
+		{
+			return;
+		}
+
+		Slot& slot = current();
+		const char* address = reinterpret_cast<const char*>(command);
+		if (address >= slot.buffer && address < slot.buffer + COMMAND_ARENA_SIZE)
+		{
+			command->~ACommand();
+			slot.isBusy = false;
+		}
+		else
+		{
+			delete command;
+		}
+	}
+
+private:
+	class Slot
+	{
+	public:
+		alignas(std::max_align_t) char buffer[COMMAND_ARENA_SIZE];
+		bool isBusy = false;
+	};
+
+	static Slot& current()
+	{
+		static thread_local Slot slot;
+		return slot;
+	}
+};
@@ -2,9 +2,8 @@
 
 #include "ACommandSearchUserHistory.h"
 #include <iostream>
-#include <Windows.h>
-#include <mmsystem.h>
 #include "parsec-dso.h"
+#include "../SoundPlayer.h"
 #include "../BanList.h"
 
 using namespace std;
@@ -28,7 +27,7 @@ public:
 		switch (_searchResult)
 		{
 		case SEARCH_USER_HISTORY_RESULT::NOT_FOUND:
-			_replyMessage = string() + "[ChatBot] | " + _sender.name + ", I cannot find the user you want to ban.\0";
+			setReply("[ChatBot] | ", _sender.name, ", I cannot find the user you want to ban.\0");
 			break;
 
 		case SEARCH_USER_HISTORY_RESULT::ONLINE:
@@ -43,7 +42,7 @@ public:
 
 		case SEARCH_USER_HISTORY_RESULT::FAILED:
 		default:
-			_replyMessage = "[ChatBot] | Usage: !ban <username>\nExample: !ban melon\0";
+			setReply("[ChatBot] | Usage: !ban <username>\nExample: !ban melon\0");
 			break;
 		}
 
@@ -56,9 +55,10 @@ public:
 	}
 
 private:
-	static vector<const char*> internalPrefixes()
+	static const vector<const char*>& internalPrefixes()
 	{
-		return vector<const char*> { "!ban ", "!block " };
+		static const vector<const char*> prefixes { "!ban ", "!block " };
+		return prefixes;
 	}
 
 	ParsecDSO* _parsec;
@@ -70,10 +70,10 @@ private:
 		bool result = false;
 
 		if (_sender.userID == target.userID)
-			_replyMessage = string() + "[ChatBot] | Thou shall not ban thyself, " + _sender.name + " ...\0";
+			setReply("[ChatBot] | Thou shall not ban thyself, ", _sender.name, " ...\0");
 		else
 		{
-			_replyMessage = string() + "[ChatBot] | " + target.name + " was banned by " + _sender.name + "!\0";
+			setReply("[ChatBot] | ", target.name, " was banned by ", _sender.name, "!\0");
 
 			if (_ban.ban(target))
 			{
@@ -82,11 +82,7 @@ private:
 					ParsecHostKickGuest(_parsec, guestID);
 				}
 
-				try
-				{
-					PlaySound(TEXT("./sfx/ban.wav"), NULL, SND_FILENAME | SND_NODEFAULT | SND_ASYNC);
-				}
-				catch (const std::exception&) {}
+				SoundPlayer::play("./sfx/ban.wav");
 
 				result = true;
 			}
@@ -1,11 +1,10 @@
 #pragma once
 
 #include "ACommandSearchUser.h"
-#include <Windows.h>
-#include <mmsystem.h>
 #include <iostream>
 #include <sstream>
 #include "parsec.h"
+#include "../SoundPlayer.h"
 #include "../Dice.h"
 
 class CommandBonk : public ACommandSearchUser
@@ -23,15 +22,12 @@ public:
 
 		if (_searchResult != SEARCH_USER_RESULT::FOUND)
 		{
-			try
+			long userID = 0;
+			if (parseNumber(_targetUsername.c_str(), userID) && _host.userID == (uint32_t)userID)
 			{
-				if (_host.userID == stoul(_targetUsername))
-				{
-					_targetGuest = _host;
-					_searchResult = SEARCH_USER_RESULT::FOUND;
-				}
+				_targetGuest = _host;
+				_searchResult = SEARCH_USER_RESULT::FOUND;
 			}
-			catch (const std::exception&) {}
 
 			if (_searchResult != SEARCH_USER_RESULT::FOUND && _targetUsername.compare(_host.name) == 0)
 			{
@@ -48,45 +44,33 @@ public:
 		{
 		case SEARCH_USER_RESULT::NOT_FOUND:
 			if (_dice.roll(BONK_CHANCE))
-				_replyMessage = std::string() + "[ChatBot] | " + _sender.name + " dreams of bonking but the target out of reach.\0";
+				setReply("[ChatBot] | ", _sender.name, " dreams of bonking but the target out of reach.\0");
 			else
-				_replyMessage = std::string() + "[ChatBot] | " + _sender.name + " yearns for bonking but the victim is not here.\0";
+				setReply("[ChatBot] | ", _sender.name, " yearns for bonking but the victim is not here.\0");
 			break;
 
 		case SEARCH_USER_RESULT::FOUND:
 			rv = true;
 			if (_sender.userID == _targetGuest.userID)
 			{
-				_replyMessage = std::string() + "[ChatBot] | " + _sender.name + " self-bonked. *Bonk!*\0";
-				try
-				{
-					PlaySound(TEXT("./sfx/bonk-hit.wav"), NULL, SND_FILENAME | SND_NODEFAULT | SND_ASYNC);
-				}
-				catch (const std::exception&) {}
+				setReply("[ChatBot] | ", _sender.name, " self-bonked. *Bonk!*\0");
+				SoundPlayer::play("./sfx/bonk-hit.wav");
 			}
 			else if (_dice.roll(BONK_CHANCE))
 			{
-				_replyMessage = std::string() + "[ChatBot] | " + _sender.name + " bonked " + _targetGuest.name + ". *Bonk!*\0";
-				try
-				{
-					PlaySound(TEXT("./sfx/bonk-hit.wav"), NULL, SND_FILENAME | SND_NODEFAULT | SND_ASYNC);
-				}
-				catch (const std::exception&) {}
+				setReply("[ChatBot] | ", _sender.name, " bonked ", _targetGuest.name, ". *Bonk!*\0");
+				SoundPlayer::play("./sfx/bonk-hit.wav");
 			}
 			else
 			{
-				_replyMessage = std::string() + "[ChatBot] | " + _targetGuest.name + " dodged " + _sender.name + "'s bonk. *Swoosh!*\0";
-				try
-				{
-					PlaySound(TEXT("./sfx/bonk-dodge.wav"), NULL, SND_FILENAME | SND_NODEFAULT | SND_ASYNC);
-				}
-				catch (const std::exception&) {}
+				setReply("[ChatBot] | ", _targetGuest.name, " dodged ", _sender.name, "'s bonk. *Swoosh!*\0");
+				SoundPlayer::play("./sfx/bonk-dodge.wav");
 			}
 			break;
 		
 		case SEARCH_USER_RESULT::FAILED:
 		default:
-			_replyMessage = "[ChatBot] | Usage: !bonk <username>\nExample: !bonk melon\0";
+			setReply("[ChatBot] | Usage: !bonk <username>\nExample: !bonk melon\0");
 			break;
 		}
 
@@ -99,9 +83,10 @@ public:
 	}
 
 protected:
-	static vector<const char*> internalPrefixes()
+	static const vector<const char*>& internalPrefixes()
 	{
-		return vector<const char*> { "!bonk " };
+		static const vector<const char*> prefixes { "!bonk " };
+		return prefixes;
 	}
 
 	Guest& _sender;
@@ -1,6 +1,5 @@
 #pragma once
 
-#include <sstream>
 #include "ACommandIntegerArg.h"
 #include "../GamepadClient.h"
 
@@ -17,26 +16,23 @@ public:
 	{
 		if ( !ACommandIntegerArg::run() )
 		{
-			_replyMessage = std::string() + "[ChatBot] | Usage: !dc <integer in range [1, 4]>\nExample: !dc 3\0";
+			setReply("[ChatBot] | Usage: !dc <integer in range [1, ", _gamepadClient.size(), "]>\nExample: !dc 3\0");
 			return false;
 		}
 
-		std::ostringstream reply;
-		if (_intArg < 1 || _intArg > XUSER_MAX_COUNT)
+		if (_intArg < 1 || _intArg > _gamepadClient.size())
 		{
-			reply << "[ChatBot] | Wrong index: " << _intArg << " is not in range [1, 4].\0";
+			setReply("[ChatBot] | Wrong index: ", _intArg, " is not in range [1, ", _gamepadClient.size(), "].\0");
 		}
-
-		if (_gamepadClient.disconnect(_intArg - 1))
+		else if (_gamepadClient.disconnect(_intArg - 1))
 		{
-			reply << "[ChatBot] | Gamepad " << _intArg << " disconnected.\0";
+			setReply("[ChatBot] | Gamepad ", _intArg, " disconnected.\0");
 		}
 		else
 		{
-			reply << "[ChatBot] | Gamepad " << _intArg << " fail to disconnect.\0";
+			setReply("[ChatBot] | Gamepad ", _intArg, " fail to disconnect.\0");
 		}
 
-		_replyMessage = reply.str();
 		return true;
 	}
 
@@ -46,9 +42,10 @@ public:
 	}
 
 private:
-	static vector<const char*> internalPrefixes()
+	static const vector<const char*>& internalPrefixes()
 	{
-		return vector<const char*> { "!dc " };
+		static const vector<const char*> prefixes { "!dc " };
+		return prefixes;
 	}
 
 	GamepadClient &_gamepadClient;
@@ -1,7 +1,6 @@
 #pragma once
 
-#include <iostream>
-#include <sstream>
+#include <string>
 #include "ACommand.h"
 #include "../Guest.h"
 #include "../Tier.h"
@@ -17,41 +16,40 @@ public:
 
 	bool run() override
 	{
-		std::ostringstream reply;
+		// Its own buffer, so a command's reply formatted on this thread survives the chat line.
+		string& reply = CommandReply::buffer<CommandDefaultMessage>();
+		reply.clear();
+
 		if (_sender.userID != _lastUserID)
 		{
-			static string role = "";
-			if (_isHost || _tier == Tier::GOD) role = "#  ";
-			else if (_tier == Tier::ADMIN) role = "$  ";
-			else role = ">  ";
+			if (_isHost || _tier == Tier::GOD) reply.append("#  ");
+			else if (_tier == Tier::ADMIN) reply.append("$  ");
+			else reply.append(">  ");
 			
 			if (_sender.isValid())
 			{
-				reply << role << _sender.name << " \t (#" << _sender.userID << ")";
+				CommandReply::append(reply, _sender.name, " \t (#", _sender.userID, ")");
 			}
 			else if(_isHost)
 			{
-				reply << role << "Host";
+				reply.append("Host");
 			}
 			else
 			{
-				reply << role << "Unkown Guest";
+				reply.append("Unkown Guest");
 			}
 
-			reply << ":\n";
+			reply.append(":\n");
 		}
 
-		reply << "\t\t " << _msg << "\0";
-
-		_replyMessage = reply.str();
-		reply.clear();
-		reply.flush();
+		CommandReply::append(reply, "\t\t ", _msg);
 
+		_reply = &reply;
 		return true;
 	}
 
 protected:
-	string _msg;
+	const char* _msg;
 	Guest &_sender;
 	uint32_t _lastUserID;
 	Tier _tier;
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <iostream>
-#include <sstream>
 #include "ACommand.h"
 #include "../GamepadClient.h"
 #include "../Guest.h"
@@ -19,23 +18,19 @@ public:
 	{
 		_droppedPadCount = _gamepadClient.onQuit(_sender);
 
-		std::ostringstream reply;
 		if (_droppedPadCount > 1)
 		{
-			reply << "[ChatBot] | " << _sender.name << " has dropped " << _droppedPadCount << " gamepads!\0";
+			setReply("[ChatBot] | ", _sender.name, " has dropped ", _droppedPadCount, " gamepads!\0");
 		}
 		else if (_droppedPadCount > 0)
 		{
-			reply << "[ChatBot] | " << _sender.name << " has dropped " << _droppedPadCount << " gamepad!\0";
+			setReply("[ChatBot] | ", _sender.name, " has dropped ", _droppedPadCount, " gamepad!\0");
 		}
 		else
 		{
-			reply <<  "[ChatBot] | " << _sender.name << " has no gamepads to drop.\0";
+			setReply("[ChatBot] | ", _sender.name, " has no gamepads to drop.\0");
 		}
 
-		_replyMessage = reply.str();
-		reply.clear();
-
 		return true;
 	}
 
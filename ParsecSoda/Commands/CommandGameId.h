@@ -16,7 +16,7 @@ public:
 	{
 		if ( !ACommandStringArg::run() )
 		{
-			_replyMessage = "[ChatBot] | Usage: !gameid <id>\nExample: !gameid 1RR6JAsP4sdrjUOMEV4i7lVwMht\0";
+			setReply("[ChatBot] | Usage: !gameid <id>\nExample: !gameid 1RR6JAsP4sdrjUOMEV4i7lVwMht\0");
 			return false;
 		}
 
@@ -26,11 +26,11 @@ public:
 		}
 		catch (const std::exception&)
 		{
-			_replyMessage = "[ChatBot] | Failed to write game ID.\0";
+			setReply("[ChatBot] | Failed to write game ID.\0");
 			return false;
 		}
 
-		_replyMessage = std::string() + "[ChatBot] | Game ID changed:\n" + _stringArg + "\0";
+		setReply("[ChatBot] | Game ID changed:\n", _stringArg);
 		return true;
 	}
 
@@ -40,9 +40,10 @@ public:
 	}
 
 protected:
-	static vector<const char*> internalPrefixes()
+	static const vector<const char*>& internalPrefixes()
 	{
-		return vector<const char*> { "!gameid " };
+		static const vector<const char*> prefixes { "!gameid " };
+		return prefixes;
 	}
 
 	ParsecHostConfig& _config;
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "ACommand.h"
+#include "../MouseRouter.h"
+
+class CommandGrabMouse : public ACommand
+{
+public:
+	const COMMAND_TYPE type() override { return COMMAND_TYPE::GRABMOUSE; }
+
+	CommandGrabMouse(Guest &sender, MouseRouter &mouseRouter)
+		: _sender(sender), _mouseRouter(mouseRouter)
+	{}
+
+	bool run() override
+	{
+		if (!_mouseRouter.grab(_sender.userID))
+		{
+			setReply("[ChatBot] | ", _sender.name, ", you are not allowed to use the mouse.\0");
+			return false;
+		}
+
+		setReply("[ChatBot] | ", _sender.name, " is holding the mouse.\0");
+		return true;
+	}
+
+	static vector<const char*> prefixes()
+	{
+		return vector<const char*> { "!grabmouse" };
+	}
+
+protected:
+	Guest& _sender;
+	MouseRouter& _mouseRouter;
+};
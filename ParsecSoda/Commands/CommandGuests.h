@@ -1,6 +1,5 @@
 #pragma once
 
-#include <sstream>
 #include "parsec-dso.h"
 #include "ACommandIntegerArg.h"
 
@@ -17,14 +16,12 @@ public:
 	{
 		if ( !ACommandIntegerArg::run() )
 		{
-			_replyMessage = "[ChatBot] | Usage: !guests <number>\nExample: !guests 7\0";
+			setReply("[ChatBot] | Usage: !guests <number>\nExample: !guests 7\0");
 			return false;
 		}
 
 		_config.maxGuests = _intArg;
-		std::ostringstream reply;
-		reply << "[ChatBot] | Max guests set to " << _intArg << "\0";
-		_replyMessage = reply.str();
+		setReply("[ChatBot] | Max guests set to ", _intArg);
 
 		return true;
 	}
@@ -35,9 +32,10 @@ public:
 	}
 
 protected:
-	static vector<const char*> internalPrefixes()
+	static const vector<const char*>& internalPrefixes()
 	{
-		return vector<const char*> { "!guests " };
+		static const vector<const char*> prefixes { "!guests " };
+		return prefixes;
 	}
 
 	ParsecHostConfig& _config;
@@ -17,19 +17,35 @@ public:
 
 	bool run() override
 	{
-		const string pleb_commands = string()
+		setConstantReply(commandList(_tierList.getTier(_sender.userID)));
+		return true;
+	}
+
+	static vector<const char*> prefixes()
+	{
+		return vector<const char*> { "!help", "!commands" };
+	}
+
+	/** The whole reply for a tier. Built on first use and shared from then on. */
+	static const string& commandList(Tier tier)
+	{
+		static const string pleb_commands = string()
 			+ "\n  " + "---- Normal Commands ----"
 			+ "\n  " + "!bonk\t\t\t\t |\tBonk another user."
 			+ "\n  " + "!help\t\t\t\t  |\tShow command list."
 			+ "\n  " + "!ff\t\t\t\t\t\t |\tDrop your gamepads."
+			+ "\n  " + "!grabmouse\t|\tTake the mouse (if you are allowed to)."
 			+ "\n  " + "!mirror\t\t\t   |\tToggle mirroring of L-Stick into DPad."
 			+ "\n  " + "!one\t\t\t\t    |\tMaps all of your devices to the same gamepad."
 			+ "\n  " + "!pads\t\t\t\t  |\tShow who's holding each gamepad."
+			+ "\n  " + "!queue\t\t\t  |\tWait in line for the next free gamepad."
 			+ "\n  " + "!sfx\t\t\t\t\t  |\tPlay sound effect."
 			+ "\n  " + "!swap\t\t\t\t |\tReplace your gamepad with another one."
+			+ "\n  " + "!transform\t |\tDeadzone, curve, trigger and turbo settings."
+			+ "\n  " + "!unqueue\t\t|\tLeave the gamepad queue."
 			;
 
-		const string admin_commands = string()
+		static const string admin_commands = string()
 			+ pleb_commands
 			+ "\n  " + ""
 			+ "\n  " + "---- Admin Commands ----"
@@ -37,16 +53,20 @@ public:
 			+ "\n  " + "!dc\t\t\t\t   |\tDisconnect a specific gamepad."
 			+ "\n  " + "!kick\t\t\t   |\tKick user from the room."
 			+ "\n  " + "!strip\t\t\t |\tStrip gamepad from player's hand."
+			+ "\n  " + "!idle\t\t\t\t|\tReclaim gamepads idle for that many seconds (0 = off)."
 			+ "\n  " + "!limit\t\t\t   |\tSet the maximum amount of pads a guest can hold."
+			+ "\n  " + "!mouse\t\t\t|\tAllow or deny mouse control for a guest."
+			+ "\n  " + "!rotate\t\t  |\tHand a gamepad to the next in queue every N seconds."
 			+ "\n  " + "!unban\t\t   |\tUnban a guest."
 			;
 
-		const string god_commands = string()
+		static const string god_commands = string()
 			+ admin_commands
 			+ "\n  " + ""
 			+ "\n  " + "---- God Commands ----"
 			+ "\n  " + "!gameid\t\t|\tSet game id."
 			+ "\n  " + "!guests\t\t  |\tSet the amount of room slots."
+			+ "\n  " + "!keymaps\t  |\tReload custom guest keymaps."
 			+ "\n  " + "!mic\t\t\t\t|\tSet microphone volume."
 			+ "\n  " + "!name\t\t\t|\tSet room name."
 			+ "\n  " + "!private\t\t |\tMake the room private."
@@ -56,23 +76,13 @@ public:
 			+ "\n  " + "!speakers\t  |\tSet speakers volume."
 			;
 
-		Tier tier = _tierList.getTier(_sender.userID);
-		string commandList = pleb_commands;
-		if		(tier == Tier::ADMIN)	commandList = admin_commands;
-		else if	(tier == Tier::GOD)		commandList = god_commands;
-		else							commandList = pleb_commands;
-
-		_replyMessage =
-			string("[ChatBot] | Command list: ")
-			+ commandList
-			+ "\n\0";
-
-		return true;
-	}
+		static const string pleb_reply = string("[ChatBot] | Command list: ") + pleb_commands + "\n";
+		static const string admin_reply = string("[ChatBot] | Command list: ") + admin_commands + "\n";
+		static const string god_reply = string("[ChatBot] | Command list: ") + god_commands + "\n";
 
-	static vector<const char*> prefixes()
-	{
-		return vector<const char*> { "!help", "!commands" };
+		if		(tier == Tier::ADMIN)	return admin_reply;
+		else if	(tier == Tier::GOD)		return god_reply;
+		else							return pleb_reply;
 	}
 
 protected:
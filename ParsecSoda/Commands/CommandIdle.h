@@ -0,0 +1,53 @@
+#pragma once
+
+#include "ACommandIntegerArg.h"
+#include "../MetadataCache.h"
+
+#define IDLE_USAGE "\nUsage: !idle <seconds>  (0 to disable)\nExample: !idle 120\0"
+
+class CommandIdle : public ACommandIntegerArg
+{
+public:
+	const COMMAND_TYPE type() override { return COMMAND_TYPE::IDLE; }
+
+	CommandIdle(const char* msg)
+		: ACommandIntegerArg(msg, internalPrefixes())
+	{}
+
+	bool run() override
+	{
+		if (!ACommandIntegerArg::run() || _intArg < 0)
+		{
+			const unsigned int seconds = MetadataCache::preferences.idleReclaimSeconds;
+			if (seconds > 0)	setReply("[ChatBot] | Idle gamepads are reclaimed after ", seconds, " seconds.", IDLE_USAGE);
+			else				setReply("[ChatBot] | Idle gamepads are never reclaimed.", IDLE_USAGE);
+			return false;
+		}
+
+		MetadataCache::preferences.idleReclaimSeconds = (unsigned int)_intArg;
+		MetadataCache::savePreferences();
+
+		if (_intArg == 0)
+		{
+			setReply("[ChatBot] | Idle gamepads will no longer be reclaimed.\0");
+		}
+		else
+		{
+			setReply("[ChatBot] | Gamepads idle for ", _intArg, " seconds will be reclaimed.\0");
+		}
+
+		return true;
+	}
+
+	static vector<const char*> prefixes()
+	{
+		return vector<const char*> { "!idle" };
+	}
+
+private:
+	static const vector<const char*>& internalPrefixes()
+	{
+		static const vector<const char*> prefixes { "!idle " };
+		return prefixes;
+	}
+};
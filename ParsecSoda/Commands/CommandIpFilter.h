@@ -1,10 +1,10 @@
 #pragma once
 
-#include <regex>
-#include <Windows.h>
-#include <mmsystem.h>
+#include <cstdint>
 #include "ACommand.h"
 #include "parsec-dso.h"
+#include "../SoundPlayer.h"
+#include "../BanList.h"
 #include "../Guest.h"
 
 class CommandIpFilter : public ACommand
@@ -16,13 +16,40 @@ public:
 		: _msg(msg), _sender(sender), _parsec(parsec), _ban(ban), _isHost(isHost)
 	{}
 
+	/**
+	 * True when msg looks like it leaks an IP: three digit groups in a row, sized
+	 * 2+, 2-3 and 1-3, each followed by non-digits. Same matches as the old search
+	 * for ((\d{3}|\d{2})[\s\D]+){2}((\d{3}|\d{2}|\d{1})[\s\D]+){1}, but in
+	 * one pass over the bytes with no allocation. The first group only needs two
+	 * digits because the pattern could start inside a longer number.
+	 */
 	static bool containsIp(const char* msg)
 	{
-		std::string message = msg;
-		std::smatch match;
-		std::regex ipRegex("((\\d{3}|\\d{2})[\\s\\D]+){2}((\\d{3}|\\d{2}|\\d{1})[\\s\\D]+){1}");
+		// Digit run lengths, capped at 4: anything longer behaves the same.
+		uint8_t first = 0, second = 0, run = 0;
 
-		return std::regex_search(message, match, ipRegex);
+		for (const unsigned char* c = (const unsigned char*)msg; *c != '\0'; ++c)
+		{
+			if (*c >= '0' && *c <= '9')
+			{
+				if (run < 4) run++;
+				continue;
+			}
+
+			if (run > 0)
+			{
+				if (first >= 2 && second >= 2 && second <= 3 && run <= 3)
+				{
+					return true;
+				}
+
+				first = second;
+				second = run;
+				run = 0;
+			}
+		}
+
+		return false;
 	}
 
 	bool run() override
@@ -32,13 +59,9 @@ public:
 			ParsecHostKickGuest(_parsec, _sender.id);
 		}
 		_ban.ban(GuestData(_sender.name, _sender.userID));
-		_replyMessage = std::string() + "! [ChatBot] | " + _sender.name + " was banned by ChatBot.\n\t\tBEGONE! *MEGA BONK*\0";
+		setReply("! [ChatBot] | ", _sender.name, " was banned by ChatBot.\n\t\tBEGONE! *MEGA BONK*\0");
 
-		try
-		{
-			PlaySound(TEXT("./sfx/banido.wav"), NULL, SND_FILENAME | SND_NODEFAULT | SND_ASYNC);
-		}
-		catch (const std::exception&) {}
+		SoundPlayer::play("./sfx/banido.wav");
 
 		return true;
 	}
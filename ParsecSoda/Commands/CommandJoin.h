@@ -13,10 +13,11 @@ public:
 
 	bool run() override
 	{
-		_replyMessage = std::string()
-			+ "[ChatBot] | You don't need a command to get a gamepad.\n"
-			+ "\tJust press (A, B, X or Y) to pick a random controller,\n"
-			+ "\tif there are any free controllers available.\0";
+		setReply(
+			"[ChatBot] | You don't need a command to get a gamepad.\n"
+			"\tJust press (A, B, X or Y) to pick a random controller,\n"
+			"\tif there are any free controllers available.\0"
+		);
 
 		return true;
 	}
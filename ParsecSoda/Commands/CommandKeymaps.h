@@ -0,0 +1,30 @@
+#pragma once
+
+#include "ACommand.h"
+#include "../GamepadClient.h"
+
+class CommandKeymaps : public ACommand
+{
+public:
+	const COMMAND_TYPE type() override { return COMMAND_TYPE::KEYMAPS; }
+
+	CommandKeymaps(GamepadClient &gamepadClient)
+		: _gamepadClient(gamepadClient)
+	{}
+
+	bool run() override
+	{
+		size_t count = _gamepadClient.loadKeyMaps();
+
+		setReply("[ChatBot] | Reloaded ", KEYMAP_FILENAME, ":\t", count, " custom keymap", (count == 1 ? "" : "s"));
+		return true;
+	}
+
+	static vector<const char*> prefixes()
+	{
+		return vector<const char*> { "!keymaps" };
+	}
+
+protected:
+	GamepadClient& _gamepadClient;
+};
@@ -2,9 +2,8 @@
 
 #include "ACommandSearchUser.h"
 #include <iostream>
-#include <Windows.h>
-#include <mmsystem.h>
 #include "parsec-dso.h"
+#include "../SoundPlayer.h"
 
 
 class CommandKick : public ACommandSearchUser
@@ -24,25 +23,21 @@ public:
 		{
 		case SEARCH_USER_RESULT::NOT_FOUND:
 			{
-				_replyMessage = std::string() + "[ChatBot] | " + _sender.name + ", I cannot find the user you want to kick.\0";
+				setReply("[ChatBot] | ", _sender.name, ", I cannot find the user you want to kick.\0");
 			}
 			break;
 
 		case SEARCH_USER_RESULT::FOUND:
 			if (_sender.userID == _targetGuest.userID)
 			{
-				_replyMessage = std::string() + "[ChatBot] | Thou shall not kick thyself, " + _sender.name + " ...\0";
+				setReply("[ChatBot] | Thou shall not kick thyself, ", _sender.name, " ...\0");
 			}
 			else
 			{
-				_replyMessage = std::string() + "[ChatBot] | " + _targetGuest.name+ " was kicked by " + _sender.name + "!\0";
+				setReply("[ChatBot] | ", _targetGuest.name, " was kicked by ", _sender.name, "!\0");
 				ParsecHostKickGuest(_parsec, _targetGuest.id);
 				
-				try
-				{
-					PlaySound(TEXT("./sfx/kick.wav"), NULL, SND_FILENAME | SND_NODEFAULT | SND_ASYNC);
-				}
-				catch (const std::exception&) {}
+				SoundPlayer::play("./sfx/kick.wav");
 
 				return true;
 			}
@@ -50,7 +45,7 @@ public:
 		
 		case SEARCH_USER_RESULT::FAILED:
 		default:
-			_replyMessage = "[ChatBot] | Usage: !kick <username>\nExample: !kick melon\0";
+			setReply("[ChatBot] | Usage: !kick <username>\nExample: !kick melon\0");
 			break;
 		}
 
@@ -63,9 +58,10 @@ public:
 	}
 
 protected:
-	static vector<const char*> internalPrefixes()
+	static const vector<const char*>& internalPrefixes()
 	{
-		return vector<const char*> { "!kick " };
+		static const vector<const char*> prefixes { "!kick " };
+		return prefixes;
 	}
 
 	Guest& _sender;
@@ -1,6 +1,5 @@
 #pragma once
 
-#include <sstream>
 #include "ACommandSearchUserIntArg.h"
 #include "../GamepadClient.h"
 
@@ -17,15 +16,13 @@ public:
 	{
 		if ( !ACommandSearchUserIntArg::run() )
 		{
-			_replyMessage = "[ChatBot] | Usage: !limit <username> <number>\nExample: !limit melon 2\0";
+			setReply("[ChatBot] | Usage: !limit <username> <number>\nExample: !limit melon 2\0");
 			return false;
 		}
 
 		_gamepadClient.setLimit(_targetGuest.userID, _intArg);
 
-		std::ostringstream reply;
-		reply << "[ChatBot] | " << _targetGuest.name << " gamepad limit set to " << _intArg << "\0";
-		_replyMessage = reply.str();
+		setReply("[ChatBot] | ", _targetGuest.name, " gamepad limit set to ", _intArg);
 		return true;
 	}
 
@@ -35,9 +32,10 @@ public:
 	}
 
 protected:
-	static vector<const char*> internalPrefixes()
+	static const vector<const char*>& internalPrefixes()
 	{
-		return vector<const char*> { "!limit " };
+		static const vector<const char*> prefixes { "!limit " };
+		return prefixes;
 	}
 
 	GamepadClient& _gamepadClient;
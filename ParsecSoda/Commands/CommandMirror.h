@@ -16,10 +16,7 @@ public:
 	bool run() override
 	{
 		bool isMirrored = _gamepadClient.toggleMirror(_sender.userID);
-		_replyMessage = std::string()
-			+ "[ChatBot] | " + _sender.name
-			+ " toggled mirror mode:\t" + (isMirrored ? "ON" : "OFF")
-			+ "\0";
+		setReply("[ChatBot] | ", _sender.name, " toggled mirror mode:\t", (isMirrored ? "ON" : "OFF"));
 		return true;
 	}
 
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "ACommandSearchUser.h"
+#include "../MouseRouter.h"
+
+class CommandMouse : public ACommandSearchUser
+{
+public:
+	const COMMAND_TYPE type() override { return COMMAND_TYPE::MOUSE; }
+
+	CommandMouse(const char* msg, GuestList &guests, MouseRouter &mouseRouter)
+		: ACommandSearchUser(msg, internalPrefixes(), guests), _mouseRouter(mouseRouter)
+	{}
+
+	bool run() override
+	{
+		ACommandSearchUser::run();
+
+		switch (_searchResult)
+		{
+		case SEARCH_USER_RESULT::NOT_FOUND:
+			setReply("[ChatBot] | I cannot find the user you want to give the mouse to.\0");
+			break;
+
+		case SEARCH_USER_RESULT::FOUND:
+			if (_mouseRouter.togglePermission(_targetGuest.userID))
+			{
+				setReply("[ChatBot] | ", _targetGuest.name, " can use the mouse now.",
+					(_mouseRouter.getHolder() == _targetGuest.userID ? "" : " Type !grabmouse to take it."));
+			}
+			else
+			{
+				setReply("[ChatBot] | ", _targetGuest.name, " can no longer use the mouse.\0");
+			}
+			return true;
+
+		case SEARCH_USER_RESULT::FAILED:
+		default:
+			setReply("[ChatBot] | Usage: !mouse <username>\nExample: !mouse melon\0");
+			break;
+		}
+
+		return false;
+	}
+
+	static vector<const char*> prefixes()
+	{
+		return vector<const char*> { "!mouse" };
+	}
+
+protected:
+	static const vector<const char*>& internalPrefixes()
+	{
+		static const vector<const char*> prefixes { "!mouse " };
+		return prefixes;
+	}
+
+	MouseRouter& _mouseRouter;
+};
@@ -16,7 +16,7 @@ public:
 	{
 		if ( !ACommandStringArg::run() )
 		{
-			_replyMessage = "[ChatBot] | Usage: !name <roomname>\nExample: !name Let's Play Gauntlet!\0";
+			setReply("[ChatBot] | Usage: !name <roomname>\nExample: !name Let's Play Gauntlet!\0");
 			return false;
 		}
 
@@ -33,7 +33,7 @@ public:
 
 		strcpy_s(_config.name, _stringArg.c_str());
 
-		_replyMessage = std::string() + "[ChatBot] | Room name changed:\n" + _stringArg + "\0";
+		setReply("[ChatBot] | Room name changed:\n", _stringArg);
 		return true;
 	}
 
@@ -43,9 +43,10 @@ public:
 	}
 
 protected:
-	static vector<const char*> internalPrefixes()
+	static const vector<const char*>& internalPrefixes()
 	{
-		return vector<const char*> { "!name " };
+		static const vector<const char*> prefixes { "!name " };
+		return prefixes;
 	}
 	ParsecHostConfig& _config;
 };
@@ -16,10 +16,7 @@ public:
 	bool run() override
 	{
 		bool isOne = _gamepadClient.toggleIgnoreDeviceID(_sender.userID);
-		_replyMessage = std::string()
-			+ "[ChatBot] | " + _sender.name
-			+ " toggled ignore device ID mode:\t" + (isOne ? "ON" : "OFF")
-			+ "\0";
+		setReply("[ChatBot] | ", _sender.name, " toggled ignore device ID mode:\t", (isOne ? "ON" : "OFF"));
 		return true;
 	}
 
@@ -3,7 +3,6 @@
 #include "ACommand.h"
 #include <iostream>
 #include "../GamepadClient.h"
-#include <sstream>
 
 class CommandPads : public ACommand
 {
@@ -16,30 +15,27 @@ public:
 
 	bool run() override
 	{
-		std::ostringstream reply;
-		reply << "[ChatBot] | Gamepad Holders:\n";
+		string& reply = beginReply();
+		CommandReply::append(reply, "[ChatBot] | Gamepad Holders:\n");
 
-		std::vector<Gamepad>::iterator gi = _gamepadClient.gamepads.begin();
+		const shared_ptr<const GamepadTable> table = _gamepadClient.getTable();
+		GamepadTable::Slots::const_iterator si = table->slots.begin();
 		uint16_t i = 1;
-		for (; gi != _gamepadClient.gamepads.end(); ++gi)
+		for (; si != table->slots.end(); ++si)
 		{
-			reply << "\t\t"
-				<< ((*gi).isConnected() ? "ON  " : "OFF") << "\t"
-				<< "[" << i << "] \t";
+			CommandReply::append(reply, "\t\t", ((*si).pad->isConnected() ? "ON  " : "OFF"), "\t", "[", i, "] \t");
 
-			if (!(*gi).owner.guest.isValid())
+			if (!(*si).isOwned())
 			{
-				reply << "\n";
+				CommandReply::append(reply, "\n");
 			}
 			else
 			{
-				reply << "(" << (*gi).owner.guest.userID << ")\t" << (*gi).owner.guest.name << "\n";
+				CommandReply::append(reply, "(", (*si).owner.guest.userID, ")\t", (*si).owner.guest.name, "\n");
 			}
 			++i;
 		}
-		reply << "\0";
 
-		_replyMessage = reply.str();
 		return true;
 	}
 
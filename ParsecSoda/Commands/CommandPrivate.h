@@ -15,7 +15,7 @@ public:
 
 	bool run() override
 	{
-		_replyMessage = "[ChatBot] | Room set to private.\0";
+		setReply("[ChatBot] | Room set to private.\0");
 		_config.publicGame = false;
 		return true;
 	}
@@ -26,9 +26,10 @@ public:
 	}
 
 protected:
-	static vector<const char*> internalPrefixes()
+	static const vector<const char*>& internalPrefixes()
 	{
-		return vector<const char*> { "!private " };
+		static const vector<const char*> prefixes { "!private " };
+		return prefixes;
 	}
 
 	ParsecHostConfig& _config;
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "ACommand.h"
+#include "../GamepadClient.h"
+
+class CommandQueue : public ACommand
+{
+public:
+	const COMMAND_TYPE type() override { return COMMAND_TYPE::QUEUE; }
+
+	CommandQueue(Guest &sender, GamepadClient &gamepadClient)
+		: _sender(sender), _gamepadClient(gamepadClient)
+	{}
+
+	bool run() override
+	{
+		PadQueue& queue = _gamepadClient.getPadQueue();
+
+		bool hasPad = false;
+		const shared_ptr<const GamepadTable> table = _gamepadClient.getTable();
+		GamepadTable::Slots::const_iterator si = table->slots.begin();
+		for (; si != table->slots.end() && !hasPad; ++si)
+		{
+			hasPad = (*si).isOwnedBy(_sender.userID);
+		}
+
+		if (hasPad)
+		{
+			setReply("[ChatBot] | ", _sender.name, ", you already have a gamepad.\0");
+			return false;
+		}
+
+		size_t position = queue.join(_sender);
+		if (position == 0)
+		{
+			position = queue.position(_sender.userID);
+		}
+
+		setReply("[ChatBot] | ", _sender.name, " is number ", position, " of ", queue.size(), " in the gamepad queue.\0");
+		return true;
+	}
+
+	static vector<const char*> prefixes()
+	{
+		return vector<const char*> { "!queue" };
+	}
+
+protected:
+	Guest& _sender;
+	GamepadClient& _gamepadClient;
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <string>
+#include <cstdio>
+#include <type_traits>
+
+#define COMMAND_REPLY_RESERVE 1024
+
+/**
+ * Builds chat replies without allocating. append() writes any mix of text,
+ * characters and numbers to the end of a string; each argument's type is
+ * checked at compile time, so there's no format string to get out of step.
+ * format() does the same into a buffer that belongs to the calling thread and
+ * is reused by every reply it builds: once it has grown to fit the longest
+ * reply, formatting is just the copy. That text is only good until the next
+ * format() on the same thread.
+ */
+class CommandReply
+{
+public:
+	template <typename... Args>
+	static const std::string& format(const Args&... args)
+	{
+		std::string& out = buffer();
+		out.clear();
+		append(out, args...);
+		return out;
+	}
+
+	template <typename... Args>
+	static void append(std::string& out, const Args&... args)
+	{
+		// One put() per argument, left to right.
+		const int expand[] = { 0, (put(out, args), 0)... };
+		(void)expand;
+	}
+
+	/** The calling thread's buffer; each Owner type gets its own, so replies that must coexist don't share one. */
+	template <typename Owner = CommandReply>
+	static std::string& buffer()
+	{
+		static thread_local std::string text;
+		if (text.capacity() < COMMAND_REPLY_RESERVE)
+		{
+			text.reserve(COMMAND_REPLY_RESERVE);
+		}
+		return text;
+	}
+
+	static const std::string& empty()
+	{
+		static const std::string text;
+		return text;
+	}
+
+private:
+	static void put(std::string& out, const char* text)
+	{
+		if (text != nullptr) out.append(text);
+	}
+
+	static void put(std::string& out, const std::string& text)
+	{
+		out.append(text);
+	}
+
+	static void put(std::string& out, char c)
+	{
+		out.push_back(c);
+	}
+
+	template <typename T>
+	static void put(std::string& out, const T& value)
+	{
+		static_assert(!std::is_same<T, bool>::value, "CommandReply doesn't print bools; pick the words with a ternary.");
+		static_assert(std::is_arithmetic<T>::value, "CommandReply only formats text, characters and numbers.");
+		putNumber(out, value, std::is_integral<T>());
+	}
+
+	template <typename T>
+	static void putNumber(std::string& out, T value, std::true_type)
+	{
+		// Characters print as characters, like they would on a stream.
+		if (sizeof(T) == 1)
+		{
+			out.push_back((char)value);
+			return;
+		}
+
+		char digits[24];
+		char* end = digits + sizeof(digits);
+		char* at = end;
+
+		const bool isNegative = value < 0;
+		unsigned long long magnitude = isNegative ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+		do
+		{
+			*--at = (char)('0' + magnitude % 10);
+			magnitude /= 10;
+		} while (magnitude > 0);
+
+		if (isNegative) *--at = '-';
+		out.append(at, end);
+	}
+
+	template <typename T>
+	static void putNumber(std::string& out, T value, std::false_type)
+	{
+		char digits[32];
+		const int length = snprintf(digits, sizeof(digits), "%g", (double)value);
+		if (length > 0) out.append(digits, (size_t)length);
+	}
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <sstream>
+#include "ACommandStringArg.h"
+#include "../GamepadClient.h"
+
+class CommandRotate : public ACommandStringArg
+{
+public:
+	const COMMAND_TYPE type() override { return COMMAND_TYPE::ROTATE; }
+
+	CommandRotate(const char* msg, GamepadClient &gamepadClient)
+		: ACommandStringArg(msg, internalPrefixes()), _gamepadClient(gamepadClient)
+	{}
+
+	bool run() override
+	{
+		int padIndex = 0, seconds = -1;
+		if (ACommandStringArg::run())
+		{
+			std::istringstream in(_stringArg);
+			in >> padIndex >> seconds;
+		}
+
+		const size_t padCount = _gamepadClient.size();
+		if (padIndex < 1 || padIndex > (int)padCount || seconds < 0)
+		{
+			setReply("[ChatBot] | Usage: !rotate <gamepad in range [1, ", padCount, "]> <seconds, 0 = off>\nExample: !rotate 1 300\0");
+			return false;
+		}
+
+		_gamepadClient.getPadQueue().setRotation(padIndex - 1, (uint32_t)seconds);
+
+		if (seconds == 0)	setReply("[ChatBot] | Gamepad ", padIndex, " no longer rotates.\0");
+		else				setReply("[ChatBot] | Gamepad ", padIndex, " rotates to the next in queue every ", seconds, " seconds.\0");
+		return true;
+	}
+
+	static vector<const char*> prefixes()
+	{
+		return vector<const char*> { "!rotate" };
+	}
+
+protected:
+	static const vector<const char*>& internalPrefixes()
+	{
+		static const vector<const char*> prefixes { "!rotate " };
+		return prefixes;
+	}
+
+	GamepadClient& _gamepadClient;
+};
@@ -17,11 +17,11 @@ public:
 	{
 		if ( !ACommandStringArg::run() )
 		{
-			_replyMessage =
-				string("[ChatBot] | Usage: !sfx <sound name> | Example: !sfx bruh\n") +
-				string("List of available sound names:\n") +
-				_sfxList.loadedTags() +
-				string("\0");
+			setReply(
+				"[ChatBot] | Usage: !sfx <sound name> | Example: !sfx bruh\n",
+				"List of available sound names:\n",
+				_sfxList.loadedTags()
+			);
 			return false;
 		}
 
@@ -30,21 +30,22 @@ public:
 		switch (result)
 		{
 		case SFXList::SFXPlayResult::COOLDOWN:
-			_replyMessage =
-				string("[ChatBot] | Command !sfx is on cooldown: ") +
-				to_string(_sfxList.getRemainingCooldown()) +
-				string(" seconds left.");
+			setReply(
+				"[ChatBot] | Command !sfx is on cooldown: ",
+				_sfxList.getRemainingCooldown(),
+				" seconds left."
+			);
 			break;
 		case SFXList::SFXPlayResult::NOT_FOUND:
-			_replyMessage =
-				string("[ChatBot] | This sound does not exist.\n") +
-				string("List of available sound effects:\n") +
-				_sfxList.loadedTags() +
-				string("\0");
+			setReply(
+				"[ChatBot] | This sound does not exist.\n",
+				"List of available sound effects:\n",
+				_sfxList.loadedTags()
+			);
 			break;
 		case SFXList::SFXPlayResult::OK:
 		default:
-			_replyMessage = "";
+			clearReply();
 			break;
 		}
 
@@ -57,9 +58,10 @@ public:
 	}
 
 protected:
-	static vector<const char*> internalPrefixes()
+	static const vector<const char*>& internalPrefixes()
 	{
-		return vector<const char*> { "!sfx " };
+		static const vector<const char*> prefixes { "!sfx " };
+		return prefixes;
 	}
 	SFXList& _sfxList;
 };
@@ -15,7 +15,7 @@ public:
 
 	bool run() override
 	{
-		_replyMessage = "[ChatBot] | Room settings applied.\0";
+		setReply("[ChatBot] | Room settings applied.\0");
 		ParsecHostSetConfig(_parsec, _config, _sessionId);
 		return true;
 	}
@@ -1,6 +1,5 @@
 #pragma once
 
-#include <sstream>
 #include "ACommandIntegerArg.h"
 #include "../AudioOut.h"
 
@@ -17,15 +16,13 @@ public:
 	{
 		if (!ACommandIntegerArg::run())
 		{
-			_replyMessage = std::string() + "[ChatBot] | Usage: !speakers <integer in range [0, 100]>\nExample: !speakers 42\0";
+			setReply("[ChatBot] | Usage: !speakers <integer in range [0, 100]>\nExample: !speakers 42\0");
 			return false;
 		}
 
 		_audioOut.volume = (float)_intArg / 100.0f;
 
-		std::ostringstream reply;
-		reply << "[ChatBot] | Speakers volume set to " << _intArg << "%\0";
-		_replyMessage = reply.str();
+		setReply("[ChatBot] | Speakers volume set to ", _intArg, "%\0");
 		return true;
 	}
 
@@ -35,9 +32,10 @@ public:
 	}
 
 protected:
-	static vector<const char*> internalPrefixes()
+	static const vector<const char*>& internalPrefixes()
 	{
-		return vector<const char*> { "!speakers " };
+		static const vector<const char*> prefixes { "!speakers " };
+		return prefixes;
 	}
 
 	AudioOut& _audioOut;
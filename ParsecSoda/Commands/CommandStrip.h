@@ -1,7 +1,6 @@
 #pragma once
 
 #include <iostream>
-#include <sstream>
 #include "ACommandIntegerArg.h"
 #include "../GamepadClient.h"
 
@@ -18,23 +17,22 @@ public:
 	{
 		if (!ACommandIntegerArg::run())
 		{
-			_replyMessage = "[ChatBot] | Usage: !strip <integer in range [1, 4]>\nExample: !strip 4\0";
+			setReply("[ChatBot] | Usage: !strip <integer in range [1, ", _gamepadClient.size(), "]>\nExample: !strip 4\0");
 			return false;
 		}
 
 		bool success = _gamepadClient.clearOwner(_intArg-1);
 		if (!success)
 		{
-			_replyMessage = "[ChatBot] | Usage: !strip <integer in range [1, 4]>\nExample: !strip 4\0";
+			setReply("[ChatBot] | Usage: !strip <integer in range [1, ", _gamepadClient.size(), "]>\nExample: !strip 4\0");
 			return false;
 		}
 
-		std::ostringstream reply;
-		reply
-			<< "[ChatBot] | Gamepad " << _intArg << " was forcefully dropped by " << _sender.name << "\n"
-			<< "\t\tType !pads to see the gamepad list.\0";
+		setReply(
+			"[ChatBot] | Gamepad ", _intArg, " was forcefully dropped by ", _sender.name, "\n",
+			"\t\tType !pads to see the gamepad list.\0"
+		);
 
-		_replyMessage = reply.str();
 		return true;
 	}
 
@@ -44,9 +42,10 @@ public:
 	}
 
 protected:
-	static vector<const char*> internalPrefixes()
+	static const vector<const char*>& internalPrefixes()
 	{
-		return vector<const char*> { "!strip " };
+		static const vector<const char*> prefixes { "!strip " };
+		return prefixes;
 	}
 	string _msg;
 	Guest& _sender;
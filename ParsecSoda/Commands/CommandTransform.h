@@ -0,0 +1,109 @@
+#pragma once
+
+#include <sstream>
+#include <algorithm>
+#include "ACommandStringArg.h"
+#include "../GamepadClient.h"
+
+class CommandTransform : public ACommandStringArg
+{
+public:
+	const COMMAND_TYPE type() override { return COMMAND_TYPE::TRANSFORM; }
+
+	CommandTransform(const char* msg, Guest &sender, GamepadClient &gamepadClient)
+		: ACommandStringArg(msg, prefixes()), _sender(sender), _gamepadClient(gamepadClient)
+	{}
+
+	bool run() override
+	{
+		ACommandStringArg::run();
+
+		string args = _stringArg;
+		std::transform(args.begin(), args.end(), args.begin(), ::tolower);
+		std::istringstream in(args);
+		string option;
+		in >> option;
+
+		InputTransform::Settings settings = _gamepadClient.getTransformSettings(_sender.userID);
+		bool isOk = true;
+
+		if (option == "off")
+		{
+			settings = InputTransform::Settings();
+		}
+		else if (option == "deadzone")
+		{
+			string mode;
+			int percent = settings.deadzoneSize * 100 / 32768;
+			in >> mode >> percent;
+
+			if		(mode == "off")		settings.deadzone = InputTransform::Deadzone::NONE;
+			else if	(mode == "axial")	settings.deadzone = InputTransform::Deadzone::AXIAL;
+			else if	(mode == "radial")	settings.deadzone = InputTransform::Deadzone::RADIAL;
+			else						isOk = false;
+
+			percent = (std::min)((std::max)(percent, 0), 90);
+			settings.deadzoneSize = (uint16_t)(percent * 32768 / 100);
+		}
+		else if (option == "curve")
+		{
+			string curve;
+			in >> curve;
+			isOk = InputTransform::parseCurve(curve.c_str(), settings.curve);
+		}
+		else if (option == "trigger")
+		{
+			int threshold = -1;
+			in >> threshold;
+			isOk = (threshold >= 0 && threshold <= 255);
+			if (isOk) settings.triggerThreshold = (uint8_t)threshold;
+		}
+		else if (option == "turbo")
+		{
+			uint16_t buttons = 0;
+			int hz = settings.turboHz;
+			string word;
+			while (in >> word)
+			{
+				uint16_t button = 0;
+				if (word == "off")										buttons = 0;
+				else if (InputTransform::parseButton(word.c_str(), button))	buttons |= button;
+				else													hz = atoi(word.c_str());
+			}
+			settings.turboButtons = buttons;
+			settings.turboHz = (uint8_t)(std::min)((std::max)(hz, 1), TRANSFORM_TURBO_HZ_MAX);
+		}
+		else
+		{
+			// No option just shows the current settings.
+			isOk = option.empty();
+		}
+
+		if (!isOk)
+		{
+			setReply(
+				"[ChatBot] | Usage: !transform [off | deadzone <off|axial|radial> <percent> | curve <linear|soft|softer|sharp>"
+				" | trigger <0-255> | turbo <a b x y lb rb ls rs|off> <hz>]"
+				"\nExample: !transform deadzone radial 15\0"
+			);
+			return false;
+		}
+
+		if (!option.empty())
+		{
+			_gamepadClient.setTransform(_sender.userID, settings);
+		}
+
+		setReply("[ChatBot] | ", _sender.name, " input transform:\t", settings.toString());
+		return true;
+	}
+
+	static vector<const char*> prefixes()
+	{
+		return vector<const char*> { "!transform" };
+	}
+
+protected:
+	Guest& _sender;
+	GamepadClient& _gamepadClient;
+};
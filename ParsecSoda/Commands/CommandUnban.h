@@ -2,7 +2,6 @@
 
 #include "ACommandStringArg.h"
 #include <iostream>
-#include <sstream>
 #include "parsec-dso.h"
 #include "../BanList.h"
 #include "../Guest.h"
@@ -20,7 +19,7 @@ public:
 	{
 		if ( !ACommandStringArg::run())
 		{
-			_replyMessage = "[ChatBot] | Usage: !unban <username>\nExample: !unban melon\0";
+			setReply("[ChatBot] | Usage: !unban <username>\nExample: !unban melon\0");
 			return false;
 		}
 		
@@ -44,17 +43,16 @@ public:
 
 		if (found)
 		{
-			std::ostringstream reply;
-			reply
-				<< "[ChatBot] | " << _sender.name << " has revoked a ban:\n"
-				<< "\t\t" << unbannedGuest.name << "\t(#" << unbannedGuest.userID << ")\0";
-			_replyMessage = reply.str();
+			setReply(
+				"[ChatBot] | ", _sender.name, " has revoked a ban:\n",
+				"\t\t", unbannedGuest.name, "\t(#", unbannedGuest.userID, ")\0"
+			);
 			_guestHistory.add(unbannedGuest);
 			return true;
 		}
 		else
 		{
-			_replyMessage = std::string() + "[ChatBot] | " + _sender.name + ", I cannot find the user you want to unban.\0";
+			setReply("[ChatBot] | ", _sender.name, ", I cannot find the user you want to unban.\0");
 			return false;
 		}
 	}
@@ -65,9 +63,10 @@ public:
 	}
 
 protected:
-	static vector<const char*> internalPrefixes()
+	static const vector<const char*>& internalPrefixes()
 	{
-		return vector<const char*> { "!unban " };
+		static const vector<const char*> prefixes { "!unban " };
+		return prefixes;
 	}
 	string _msg;
 	Guest& _sender;
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "ACommand.h"
+#include "../GamepadClient.h"
+
+class CommandUnqueue : public ACommand
+{
+public:
+	const COMMAND_TYPE type() override { return COMMAND_TYPE::UNQUEUE; }
+
+	CommandUnqueue(Guest &sender, GamepadClient &gamepadClient)
+		: _sender(sender), _gamepadClient(gamepadClient)
+	{}
+
+	bool run() override
+	{
+		if (_gamepadClient.getPadQueue().leave(_sender.userID))
+		{
+			setReply("[ChatBot] | ", _sender.name, " left the gamepad queue.\0");
+			return true;
+		}
+
+		setReply("[ChatBot] | ", _sender.name, ", you are not in the gamepad queue.\0");
+		return false;
+	}
+
+	static vector<const char*> prefixes()
+	{
+		return vector<const char*> { "!unqueue" };
+	}
+
+protected:
+	Guest& _sender;
+	GamepadClient& _gamepadClient;
+};
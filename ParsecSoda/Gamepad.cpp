@@ -6,16 +6,14 @@ Gamepad::Gamepad()
 	_client = nullptr;
 	_isAlive = false;
 	_index = GAMEPAD_INDEX_ERROR;
+	_busIndex = GAMEPAD_INDEX_ERROR;
 	_isConnected = false;
-	clearOwner();
 }
 
-Gamepad::Gamepad(ParsecDSO* parsec, PVIGEM_CLIENT client)
-	: parsec(parsec)
+Gamepad::Gamepad(ParsecDSO* parsec, PVIGEM_CLIENT client, Type type, RumbleForwarder* rumble)
+	: parsec(parsec), _rumble(rumble), _type(type)
 {
 	_client = client;
-	clearOwner();
-	refreshIndex();
 	_isConnected = false;
 
 	alloc();
@@ -25,10 +23,17 @@ bool Gamepad::alloc()
 {
 	if (_client != nullptr)
 	{
-		pad = vigem_target_x360_alloc();
+		if (_type == Type::DS4)
+		{
+			pad = vigem_target_ds4_alloc();
+		}
+		else
+		{
+			pad = vigem_target_x360_alloc();
+			vigem_target_set_vid(pad, 0x045E);
+			vigem_target_set_pid(pad, 0x028E);
+		}
 
-		vigem_target_set_vid(pad, 0x045E);
-		vigem_target_set_pid(pad, 0x028E);
 		_isAlive = true;
 	}
 	else
@@ -45,7 +50,7 @@ bool Gamepad::realloc()
 	return alloc();
 }
 
-bool Gamepad::connect()
+bool Gamepad::connect(bool waitIndex)
 {
 	if (!_isAlive || _client == nullptr) { return false; }
 
@@ -53,30 +58,13 @@ bool Gamepad::connect()
 
 	if (VIGEM_SUCCESS(err))
 	{
-		clearOwner();
-		refreshIndex();
+		_index = GAMEPAD_INDEX_ERROR;
+		_busIndex = vigem_target_get_index(pad);
+		requestClear();
+		bindNotification();
+		refreshIndex(waitIndex ? GAMEPAD_INDEX_TIMEOUT_MS : 0);
 		_isConnected = true;
 
-		const VIGEM_ERROR error = vigem_target_x360_register_notification(
-			_client, pad,
-			[](PVIGEM_CLIENT Client, PVIGEM_TARGET Target, UCHAR LargeMotor, UCHAR SmallMotor, UCHAR LedNumber, LPVOID UserData) {
-				Gamepad* gamepad = reinterpret_cast<Gamepad*>(UserData);
-				if (gamepad != nullptr)
-				{
-					if (gamepad->isConnected() && gamepad->isOwned() && gamepad->parsec != nullptr)
-					{
-						ParsecHostSubmitRumble(gamepad->parsec, gamepad->owner.guest.id, gamepad->owner.deviceID, LargeMotor, SmallMotor);
-					}
-				}
-			},
-			this
-		);
-
-		if (!VIGEM_SUCCESS(error))
-		{
-			bool stop = true;
-		}
-
 		return true;
 	}
 
@@ -97,7 +85,8 @@ bool Gamepad::disconnect()
 	}
 
 	_isConnected = false;
-	clearOwner();
+	_index = GAMEPAD_INDEX_ERROR;
+	_rumbleTarget = 0;
 	return true;
 }
 
@@ -107,7 +96,7 @@ void Gamepad::release()
 	{
 		disconnect();
 		vigem_target_free(pad);
-		clearOwner();
+		_rumbleTarget = 0;
 		_isAlive = false;
 		_isConnected = false;
 	}
@@ -123,42 +112,97 @@ bool Gamepad::isAttached()
 	return false;
 }
 
+void Gamepad::bindNotification()
+{
+	if (!_isAlive || _client == nullptr)
+	{
+		return;
+	}
+
+	// Notifications carry a raw pointer to this object; pads are never copied or moved once created.
+	if (_type == Type::DS4)
+	{
+		vigem_target_ds4_unregister_notification(pad);
+		vigem_target_ds4_register_notification(_client, pad, &Gamepad::onDS4Notification, this);
+	}
+	else
+	{
+		vigem_target_x360_unregister_notification(pad);
+		vigem_target_x360_register_notification(_client, pad, &Gamepad::onXboxNotification, this);
+	}
+}
+
 void Gamepad::setState(XINPUT_STATE state)
 {
-	vigem_target_x360_update(_client, pad, *reinterpret_cast<XUSB_REPORT*>(&state.Gamepad));
+	if (isMeaningfulInput(state.Gamepad))
+	{
+		_idleReference = state.Gamepad;
+		touchInput((uint64_t)chrono::duration_cast<chrono::milliseconds>(
+			chrono::steady_clock::now().time_since_epoch()
+		).count());
+	}
+
+	_state = state;
+	update();
 }
 
-bool Gamepad::refreshIndex()
+void Gamepad::update()
 {
-	if (_isAlive)
+	XINPUT_GAMEPAD gamepad = _state.Gamepad;
+	if (_transform != nullptr)
+	{
+		_transform->apply(gamepad, _turboPhase);
+	}
+
+	if (_type == Type::DS4)
+	{
+		DS4_REPORT report;
+		DS4_REPORT_INIT(&report);
+		XUSB_TO_DS4_REPORT(reinterpret_cast<XUSB_REPORT*>(&gamepad), &report);
+		vigem_target_ds4_update(_client, pad, report);
+	}
+	else
+	{
+		vigem_target_x360_update(_client, pad, *reinterpret_cast<XUSB_REPORT*>(&gamepad));
+	}
+
+	InputLatency::markApplied();
+}
+
+bool Gamepad::refreshIndex(uint32_t timeoutMs)
+{
+	using clock = chrono::steady_clock;
+
+	if (!_isAlive || _type != Type::XBOX)
 	{
-		clearState();
-		VIGEM_ERROR err = vigem_target_x360_get_user_index(_client, pad, &_index);
-		if (!VIGEM_SUCCESS(err))
+		return false;
+	}
+
+	// The user index is reported by the driver itself (or pushed through the LED
+	// notification), so pads plugged in concurrently never interfere with each other.
+	const clock::time_point deadline = clock::now() + chrono::milliseconds(timeoutMs);
+	ULONG index = GAMEPAD_INDEX_ERROR;
+	do
+	{
+		if (VIGEM_SUCCESS(vigem_target_x360_get_user_index(_client, pad, &index)))
 		{
-			XINPUT_STATE state = XINPUT_STATE();
-			state.Gamepad.sThumbRX = 7;
-			state.Gamepad.sThumbRY = 19;
+			_index = index;
+		}
 
-			setState(state);
-			
-			XINPUT_STATE iState = XINPUT_STATE();
-			for (size_t i = 0; i < XUSER_MAX_COUNT; ++i)
-			{
-				XInputGetState(i, &iState);
-				if (iState.Gamepad.sThumbRX == state.Gamepad.sThumbRX && iState.Gamepad.sThumbRY == state.Gamepad.sThumbRY)
-				{
-					_index = i;
-					clearState();
-					break;
-				}
-			}
-
-			clearState();
+		if (_index != GAMEPAD_INDEX_ERROR)
+		{
+			return true;
 		}
-	}
 
-	return _index;
+		if (clock::now() >= deadline)
+		{
+			break;
+		}
+
+		Sleep(GAMEPAD_INDEX_POLL_MS);
+	} while (true);
+
+	return false;
 }
 
 void Gamepad::setIndex(ULONG index)
@@ -171,33 +215,34 @@ ULONG Gamepad::getIndex() const
 	return _index;
 }
 
-XINPUT_STATE Gamepad::getState()
+ULONG Gamepad::getBusIndex() const
 {
-	XINPUT_STATE state = {};
+	return _busIndex;
+}
 
-	if (_isAlive && _index >= 0)
-	{
-		XInputGetState(_index, &state);
-	}
+Gamepad::Type Gamepad::getType() const
+{
+	return _type;
+}
 
-	return state;
+XINPUT_STATE Gamepad::getState()
+{
+	return _state;
 }
 
 void Gamepad::clearState()
 {
-	XINPUT_STATE xState;
-	xState.Gamepad.wButtons = 0;
-	xState.Gamepad.bLeftTrigger = 0;
-	xState.Gamepad.bRightTrigger = 0;
-	xState.Gamepad.sThumbLX = 0;
-	xState.Gamepad.sThumbLY = 0;
-	xState.Gamepad.sThumbRX = 0;
-	xState.Gamepad.sThumbRY = 0;
-	vigem_target_x360_update(_client, pad, *reinterpret_cast<XUSB_REPORT*>(&xState.Gamepad));
+	_state = XINPUT_STATE();
+	if (_isAlive && _client != nullptr)
+	{
+		update();
+	}
 }
 
 bool Gamepad::setState(ParsecGamepadStateMessage state)
 {
+	applyPendingClear();
+
 	if (_isAlive && _isConnected && _client != nullptr)
 	{
 		XINPUT_STATE xState;
@@ -209,133 +254,50 @@ bool Gamepad::setState(ParsecGamepadStateMessage state)
 		xState.Gamepad.sThumbRX = state.thumbRX;
 		xState.Gamepad.sThumbRY = state.thumbRY;
 
-		if (mirror)
-		{
-			Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_DPAD_LEFT, state.thumbLX < -GAMEPAD_DEADZONE);
-			Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_DPAD_RIGHT, state.thumbLX > GAMEPAD_DEADZONE);
-			Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_DPAD_UP, state.thumbLY > GAMEPAD_DEADZONE);
-			Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_DPAD_DOWN, state.thumbLY < -GAMEPAD_DEADZONE);
-		}
-
-		vigem_target_x360_update(_client, pad, *reinterpret_cast<XUSB_REPORT*>(&xState.Gamepad));
+		setState(xState);
 		return true;
 	}
 
 	return false;
 }
 
-bool Gamepad::setState(ParsecKeyboardMessage key)
+bool Gamepad::setState(ParsecKeyboardMessage key, const KeyMap& keyMap)
 {
+	applyPendingClear();
+
 	if (_isAlive && _isConnected && _client != nullptr)
 	{
-		bool isOk = true;
-		XINPUT_STATE xState = getState();
-
-		switch (key.code)
+		const KeyAction& action = keyMap.get(key.code);
+		if (action.isEmpty())
 		{
+			return false;
+		}
 
-			// Directions
-		case (int)KEY_TO_GAMEPAD::LEFT:
-		case (int)KEY_TO_GAMEPAD2::LEFT:
-			xState.Gamepad.sThumbLX = (key.pressed ? GAMEPAD_STICK_MIN : 0);
-			if (mirror)
-			{
-				Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_DPAD_LEFT, key.pressed);
-			}
-			break;
-		case (int)KEY_TO_GAMEPAD::RIGHT:
-		case (int)KEY_TO_GAMEPAD2::RIGHT:
-			xState.Gamepad.sThumbLX = (key.pressed ? GAMEPAD_STICK_MAX : 0);
-			if (mirror)
-			{
-				Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_DPAD_RIGHT, key.pressed);
-			}
-			break;
-		case (int)KEY_TO_GAMEPAD::UP:
-		case (int)KEY_TO_GAMEPAD2::UP:
-			xState.Gamepad.sThumbLY = (key.pressed ? GAMEPAD_STICK_MAX : 0);
-			if (mirror)
-			{
-				Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_DPAD_UP, key.pressed);
-			}
-			break;
-		case (int)KEY_TO_GAMEPAD::DOWN:
-		case (int)KEY_TO_GAMEPAD2::DOWN:
-			xState.Gamepad.sThumbLY = (key.pressed ? GAMEPAD_STICK_MIN : 0);
-			if (mirror)
-			{
-				Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_DPAD_DOWN, key.pressed);
-			}
-			break;
-
-			// Face buttons
-		case (int)KEY_TO_GAMEPAD::A:
-		case (int)KEY_TO_GAMEPAD2::A:
-			Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_A, key.pressed);
-			break;
-		case (int)KEY_TO_GAMEPAD::B:
-		case (int)KEY_TO_GAMEPAD2::B:
-			Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_B, key.pressed);
-			break;
-		case (int)KEY_TO_GAMEPAD::X:
-		case (int)KEY_TO_GAMEPAD2::X:
-			Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_X, key.pressed);
-			break;
-		case (int)KEY_TO_GAMEPAD::Y:
-		case (int)KEY_TO_GAMEPAD2::Y:
-			Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_Y, key.pressed);
-			break;
-
-			// Center
-		case (int)KEY_TO_GAMEPAD::BACK:
-		case (int)KEY_TO_GAMEPAD2::BACK:
-			Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_BACK, key.pressed);
-			break;
-		case (int)KEY_TO_GAMEPAD::START:
-		case (int)KEY_TO_GAMEPAD2::START:
-			Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_START, key.pressed);
-			break;
+		XINPUT_STATE xState = getState();
 
-			// Shoulders
-		case (int)KEY_TO_GAMEPAD::LB:
-		case (int)KEY_TO_GAMEPAD2::LB:
-			Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_LEFT_SHOULDER, key.pressed);
-			break;
-		case (int)KEY_TO_GAMEPAD::RB:
-		case (int)KEY_TO_GAMEPAD2::RB:
-			Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_RIGHT_SHOULDER, key.pressed);
-			break;
+		xState.Gamepad.wButtons = (xState.Gamepad.wButtons & ~action.button) | (key.pressed ? action.button : 0);
 
-			// Triggers
-		case (int)KEY_TO_GAMEPAD::LT:
-		case (int)KEY_TO_GAMEPAD2::LT:
-			xState.Gamepad.bLeftTrigger = (key.pressed ? GAMEPAD_STICK_MAX : GAMEPAD_STICK_MIN);
+		const int16_t value = (key.pressed ? action.value : 0);
+		switch (action.axis)
+		{
+		case KeyAction::Axis::LX:
+			xState.Gamepad.sThumbLX = value;
 			break;
-		case (int)KEY_TO_GAMEPAD::RT:
-		case (int)KEY_TO_GAMEPAD2::RT:
-			xState.Gamepad.bRightTrigger = (key.pressed ? GAMEPAD_STICK_MAX : GAMEPAD_STICK_MIN);
+		case KeyAction::Axis::LY:
+			xState.Gamepad.sThumbLY = value;
 			break;
-
-			// Thumbs
-		case (int)KEY_TO_GAMEPAD::LTHUMB:
-		case (int)KEY_TO_GAMEPAD2::LTHUMB:
-			Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_LEFT_THUMB, key.pressed);
+		case KeyAction::Axis::LT:
+			xState.Gamepad.bLeftTrigger = (BYTE)value;
 			break;
-		case (int)KEY_TO_GAMEPAD::RTHUMB:
-		case (int)KEY_TO_GAMEPAD2::RTHUMB:
-			Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_RIGHT_THUMB, key.pressed);
+		case KeyAction::Axis::RT:
+			xState.Gamepad.bRightTrigger = (BYTE)value;
 			break;
-
 		default:
-			isOk = false;
 			break;
 		}
 
-		if (isOk)
-		{
-			vigem_target_x360_update(_client, pad, *reinterpret_cast<XUSB_REPORT*>(&xState.Gamepad));
-			return true;
-		}
+		setState(xState);
+		return true;
 	}
 
 	return false;
@@ -343,6 +305,8 @@ bool Gamepad::setState(ParsecKeyboardMessage key)
 
 bool Gamepad::setState(ParsecGamepadButtonMessage button)
 {
+	applyPendingClear();
+
 	if (_isAlive && _isConnected && _client != nullptr)
 	{
 		bool isOk = true;
@@ -405,7 +369,7 @@ bool Gamepad::setState(ParsecGamepadButtonMessage button)
 		if (isOk)
 		{
 			Bitwise::setValue(&xState.Gamepad.wButtons, buttonCode, button.pressed);
-			vigem_target_x360_update(_client, pad, *reinterpret_cast<XUSB_REPORT*>(&xState.Gamepad));
+			setState(xState);
 			
 			return true;
 		}
@@ -416,10 +380,10 @@ bool Gamepad::setState(ParsecGamepadButtonMessage button)
 
 bool Gamepad::setState(ParsecGamepadAxisMessage axis)
 {
+	applyPendingClear();
+
 	if (_isAlive && _isConnected && _client != nullptr)
 	{
-		cout << "Axis: " << axis.axis << " | " << axis.value;
-
 		bool isOk = true;
 		XINPUT_STATE xState = getState();
 
@@ -427,19 +391,9 @@ bool Gamepad::setState(ParsecGamepadAxisMessage axis)
 		{
 		case GAMEPAD_AXIS_LX:
 			xState.Gamepad.sThumbLX = axis.value;
-			if (mirror)
-			{
-				Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_DPAD_LEFT, axis.value < -GAMEPAD_DEADZONE);
-				Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_DPAD_RIGHT, axis.value > GAMEPAD_DEADZONE);
-			}
 			break;
 		case GAMEPAD_AXIS_LY:
 			xState.Gamepad.sThumbLY = -axis.value;
-			if (mirror)
-			{
-				Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_DPAD_UP, axis.value < -GAMEPAD_DEADZONE);
-				Bitwise::setValue(&xState.Gamepad.wButtons, XUSB_GAMEPAD_DPAD_DOWN, axis.value > GAMEPAD_DEADZONE);
-			}
 			break;
 		case GAMEPAD_AXIS_RX:
 			xState.Gamepad.sThumbRX = axis.value;
@@ -460,7 +414,7 @@ bool Gamepad::setState(ParsecGamepadAxisMessage axis)
 
 		if (isOk)
 		{
-			vigem_target_x360_update(_client, pad, *reinterpret_cast<XUSB_REPORT*>(&xState.Gamepad));
+			setState(xState);
 
 			return true;
 		}
@@ -469,30 +423,166 @@ bool Gamepad::setState(ParsecGamepadAxisMessage axis)
 	return false;
 }
 
-void Gamepad::setOwner(Guest& guest, uint32_t deviceID, bool isKeyboard)
+void Gamepad::setRumbleTarget(const GuestDevice& owner)
+{
+	_rumbleTarget = owner.guest.isValid()
+		? (((uint64_t)owner.guest.id << 32) | owner.deviceID)
+		: 0;
+}
+
+void Gamepad::requestClear()
 {
-	owner.guest.copy(guest);
-	owner.deviceID = deviceID;
-	owner.isKeyboard = isKeyboard;
+	_isClearPending = true;
 }
 
-void Gamepad::copyOwner(Gamepad pad)
+void Gamepad::setTransform(const shared_ptr<const InputTransform>& transform)
 {
-	owner.copy(pad.owner);
+	if (_transform != transform)
+	{
+		_transform = transform;
+	}
 }
 
-void Gamepad::clearOwner()
+void Gamepad::touchInput(uint64_t nowMs)
 {
-	clearState();
-	owner = GuestDevice();
+	_lastInputMs = nowMs;
 }
 
-const bool Gamepad::isOwned()
+uint64_t Gamepad::getLastInputMs() const
 {
-	return owner.guest.isValid();
+	return _lastInputMs;
+}
+
+bool Gamepad::refreshTurbo(uint64_t nowMs)
+{
+	if (applyPendingClear())
+	{
+		if (_isAlive && _isConnected && _client != nullptr)
+		{
+			update();
+		}
+		return true;
+	}
+
+	if (_transform == nullptr || !_transform->hasTurbo() || !_isConnected)
+	{
+		return false;
+	}
+
+	// Only resend while a turbo button is actually held and the phase flipped.
+	const uint32_t phase = _transform->turboPhase(nowMs);
+	if (phase == _turboPhase || (_state.Gamepad.wButtons & _transform->getSettings().turboButtons) == 0)
+	{
+		_turboPhase = phase;
+		return false;
+	}
+
+	_turboPhase = phase;
+	update();
+	return true;
 }
 
 bool Gamepad::isConnected() const
 {
 	return _isConnected;
-}
\ No newline at end of file
+}
+
+VOID CALLBACK Gamepad::onXboxNotification(PVIGEM_CLIENT Client, PVIGEM_TARGET Target, UCHAR LargeMotor, UCHAR SmallMotor, UCHAR LedNumber, LPVOID UserData)
+{
+	Gamepad* gamepad = reinterpret_cast<Gamepad*>(UserData);
+	if (gamepad != nullptr)
+	{
+		// XInput lights the player LED matching the user index it assigned.
+		if (LedNumber < XUSER_MAX_COUNT)
+		{
+			gamepad->_index = LedNumber;
+		}
+
+		gamepad->submitRumble(LargeMotor, SmallMotor);
+	}
+}
+
+VOID CALLBACK Gamepad::onDS4Notification(PVIGEM_CLIENT Client, PVIGEM_TARGET Target, UCHAR LargeMotor, UCHAR SmallMotor, DS4_LIGHTBAR_COLOR LightbarColor, LPVOID UserData)
+{
+	Gamepad* gamepad = reinterpret_cast<Gamepad*>(UserData);
+	if (gamepad != nullptr)
+	{
+		gamepad->submitRumble(LargeMotor, SmallMotor);
+	}
+}
+
+bool Gamepad::applyPendingClear()
+{
+	// Only the thread that feeds the pad consumes the flag, so _state has a single writer.
+	if (!_isClearPending.exchange(false))
+	{
+		return false;
+	}
+
+	_state = XINPUT_STATE();
+	_turboPhase = 0;
+	return true;
+}
+
+bool Gamepad::isMeaningfulInput(const XINPUT_GAMEPAD& gamepad) const
+{
+	const XINPUT_GAMEPAD& ref = _idleReference;
+
+	if (gamepad.wButtons != ref.wButtons)
+	{
+		return true;
+	}
+
+	if (
+		abs(gamepad.bLeftTrigger - ref.bLeftTrigger) > GAMEPAD_IDLE_TRIGGER_NOISE ||
+		abs(gamepad.bRightTrigger - ref.bRightTrigger) > GAMEPAD_IDLE_TRIGGER_NOISE
+	)
+	{
+		return true;
+	}
+
+	// Resting sticks jitter inside the deadzone: only travel outside of it counts.
+	const int sticks[2][4] = {
+		{ gamepad.sThumbLX, gamepad.sThumbLY, ref.sThumbLX, ref.sThumbLY },
+		{ gamepad.sThumbRX, gamepad.sThumbRY, ref.sThumbRX, ref.sThumbRY }
+	};
+	for (int i = 0; i < 2; ++i)
+	{
+		const bool isOut = abs(sticks[i][0]) > GAMEPAD_DEADZONE || abs(sticks[i][1]) > GAMEPAD_DEADZONE;
+		const bool wasOut = abs(sticks[i][2]) > GAMEPAD_DEADZONE || abs(sticks[i][3]) > GAMEPAD_DEADZONE;
+		if (isOut != wasOut)
+		{
+			return true;
+		}
+
+		if (isOut && (
+			abs(sticks[i][0] - sticks[i][2]) > GAMEPAD_IDLE_STICK_NOISE ||
+			abs(sticks[i][1] - sticks[i][3]) > GAMEPAD_IDLE_STICK_NOISE
+		))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void Gamepad::submitRumble(UCHAR largeMotor, UCHAR smallMotor)
+{
+	const uint64_t target = _rumbleTarget;
+	if (isConnected() && target != 0 && parsec != nullptr)
+	{
+		const uint32_t guestID = (uint32_t)(target >> 32);
+		const uint32_t deviceID = (uint32_t)(target & 0xFFFFFFFF);
+
+		// Runs on the driver's notification thread: hand off instead of talking to Parsec here.
+		if (_rumble != nullptr)
+		{
+			_rumble->submit(guestID, deviceID, largeMotor, smallMotor);
+		}
+		else
+		{
+			ParsecHostSubmitRumble(parsec, guestID, deviceID, largeMotor, smallMotor);
+		}
+	}
+}
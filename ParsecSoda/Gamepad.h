@@ -3,64 +3,121 @@
 #include <Windows.h>
 #include <Xinput.h>
 #include "ViGEm/Client.h"
+#include "ViGEm/Util.h"
 #include <vector>
 #include <iostream>
 #include <functional>
+#include <chrono>
+#include <memory>
+#include <atomic>
 #include "parsec-dso.h"
 #include "Bitwise.h"
-#include "KeyboardMaps.h"
+#include "KeyMap.h"
+#include "InputTransform.h"
+#include "RumbleForwarder.h"
+#include "InputLatency.h"
 #include "GuestDevice.h"
 
 using namespace std;
 
 #define GAMEPAD_INDEX_ERROR -1
-#define GAMEPAD_DEADZONE 4096
+#define GAMEPAD_INDEX_TIMEOUT_MS 1000
+#define GAMEPAD_INDEX_POLL_MS 5
+#define GAMEPAD_MAX_COUNT 16
 
 #define GAMEPAD_STICK_MIN -32768
 #define GAMEPAD_STICK_MAX 32767
 #define GAMEPAD_TRIGGER_MIN 0
 #define GAMEPAD_TRIGGER_MAX 255
 
+/** Trigger travel below this (and stick travel inside the deadzone) doesn't count as activity. */
+#define GAMEPAD_IDLE_TRIGGER_NOISE 32
+#define GAMEPAD_IDLE_STICK_NOISE (GAMEPAD_DEADZONE / 8)
+
 class Gamepad
 {
 public:
+	enum class Type
+	{
+		XBOX,
+		DS4
+	};
+
 	Gamepad();
-	Gamepad(ParsecDSO * parsec, PVIGEM_CLIENT client);
+	Gamepad(ParsecDSO * parsec, PVIGEM_CLIENT client, Type type = Type::XBOX, RumbleForwarder* rumble = nullptr);
+	Gamepad(const Gamepad&) = delete;
+	Gamepad& operator=(const Gamepad&) = delete;
 	bool alloc();
 	bool realloc();
-	bool connect();
+	bool connect(bool waitIndex = true);
 	bool disconnect();
 	void release();
 	bool isAttached();
+	void bindNotification();
 	void setIndex(ULONG index);
 	ULONG getIndex() const;
+	ULONG getBusIndex() const;
+	Type getType() const;
 	XINPUT_STATE getState();
 	void clearState();
 
 	// State mesages
 	bool setState(ParsecGamepadStateMessage state);
-	bool setState(ParsecKeyboardMessage key);
+	bool setState(ParsecKeyboardMessage key, const KeyMap& keyMap = KeyMap::DEFAULT);
 	bool setState(ParsecGamepadButtonMessage button);
 	bool setState(ParsecGamepadAxisMessage axis);
 
-	void setOwner(Guest& guest, uint32_t deviceID, bool isKeyboard);
-	void copyOwner(Gamepad pad);
-	void clearOwner();
-	const bool isOwned();
+	void setRumbleTarget(const GuestDevice& owner);
+	void requestClear();
 	bool isConnected() const;
-	GuestDevice owner = GuestDevice();
-	bool mirror = false;
+	void setTransform(const shared_ptr<const InputTransform>& transform);
+	bool refreshTurbo(uint64_t nowMs);
+	void touchInput(uint64_t nowMs);
+	uint64_t getLastInputMs() const;
 
 	ParsecDSO * parsec;
 
 private:
 	void setState(XINPUT_STATE state);
-	bool refreshIndex();
+	void update();
+	bool refreshIndex(uint32_t timeoutMs = GAMEPAD_INDEX_TIMEOUT_MS);
+	bool applyPendingClear();
+	bool isMeaningfulInput(const XINPUT_GAMEPAD& gamepad) const;
+	void submitRumble(UCHAR largeMotor, UCHAR smallMotor);
 	PVIGEM_CLIENT _client;
 	PVIGEM_TARGET pad;
-	ULONG _index = -1;
+	RumbleForwarder* _rumble = nullptr;
+	Type _type = Type::XBOX;
+	XINPUT_STATE _state = {};
+
+	/** Owner's transform; null means the raw state goes to the driver untouched. */
+	shared_ptr<const InputTransform> _transform;
+	uint32_t _turboPhase = 0;
+
+	/** XInput user index (player LED). Only XBOX pads in the first four slots get one. Set from the driver's notification thread. */
+	atomic<ULONG> _index { (ULONG)GAMEPAD_INDEX_ERROR };
+
+	/** Serial number assigned by the bus on plug-in. Unique for every target, any type. */
+	atomic<ULONG> _busIndex { (ULONG)GAMEPAD_INDEX_ERROR };
+
 	bool _isAlive = false;
 	bool _isConnected = false;
 
-	VOID CALLBACK notification(PVIGEM_CLIENT Client,PVIGEM_TARGET Target,UCHAR LargeMotor,UCHAR SmallMotor,UCHAR LedNumber, LPVOID UserData);
+	/**
+	 * Ownership lives in GamepadTable. The pad only keeps what the driver thread needs
+	 * (who gets the rumble, as guest id << 32 | device id, 0 for nobody) and a flag
+	 * asking the input thread to zero the state when the owner changes.
+	 */
+	atomic<uint64_t> _rumbleTarget { 0 };
+	atomic<bool> _isClearPending { false };
+
+	/**
+	 * Steady clock ms of the owner's last meaningful input, compared against
+	 * _idleReference (the state at that moment) so slow deliberate moves still add up.
+	 */
+	atomic<uint64_t> _lastInputMs { 0 };
+	XINPUT_GAMEPAD _idleReference = {};
+
+	static VOID CALLBACK onXboxNotification(PVIGEM_CLIENT Client, PVIGEM_TARGET Target, UCHAR LargeMotor, UCHAR SmallMotor, UCHAR LedNumber, LPVOID UserData);
+	static VOID CALLBACK onDS4Notification(PVIGEM_CLIENT Client, PVIGEM_TARGET Target, UCHAR LargeMotor, UCHAR SmallMotor, DS4_LIGHTBAR_COLOR LightbarColor, LPVOID UserData);
 };
\ No newline at end of file
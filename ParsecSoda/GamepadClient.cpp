@@ -13,6 +13,7 @@ GamepadClient::~GamepadClient()
 void GamepadClient::setParsec(ParsecDSO* parsec)
 {
 	this->_parsec = parsec;
+	_rumbleForwarder.setParsec(parsec);
 }
 
 bool GamepadClient::init()
@@ -34,60 +35,144 @@ bool GamepadClient::init()
 		return false;
 	}
 
+	loadKeyMaps();
+	loadPreferences();
+	_rumbleForwarder.start();
+
 	return true;
 }
 
-Gamepad GamepadClient::createGamepad(uint16_t index)
+shared_ptr<Gamepad> GamepadClient::createGamepad(uint16_t index, Gamepad::Type type)
 {
-	if (_client == nullptr || gamepads.size() > XUSER_MAX_COUNT)
+	if (_client == nullptr || size() >= GAMEPAD_MAX_COUNT)
 	{
-		return Gamepad();
+		return nullptr;
 	}
 
-	Gamepad gamepad(_parsec, _client);
-	gamepads.push_back(gamepad);
+	// Heap allocated and shared by every table version: connect() hands "this" to the driver.
+	shared_ptr<Gamepad> gamepad = make_shared<Gamepad>(_parsec, _client, type, &_rumbleForwarder);
+	edit([&gamepad](GamepadTable::Slots& slots) {
+		GamepadTable::Slot slot;
+		slot.pad = gamepad;
+		slots.push_back(slot);
+	});
 	return gamepad;
 }
 
 void GamepadClient::createMaximumGamepads()
 {
-	for (uint16_t i = 0; i < XUSER_MAX_COUNT; i++)
+	unsigned int xboxCount = min(MetadataCache::preferences.xboxCount, (unsigned int)GAMEPAD_MAX_COUNT);
+	unsigned int ds4Count = min(MetadataCache::preferences.ds4Count, (unsigned int)GAMEPAD_MAX_COUNT - xboxCount);
+
+	if (_client == nullptr)
 	{
-		this->createGamepad(i);
-		Sleep(200);
+		return;
 	}
+
+	// Built aside and published as a single version.
+	GamepadTable::Slots created;
+	uint16_t i = 0;
+	for (; i < xboxCount + ds4Count; i++)
+	{
+		GamepadTable::Slot slot;
+		slot.pad = make_shared<Gamepad>(_parsec, _client, i < xboxCount ? Gamepad::Type::XBOX : Gamepad::Type::DS4, &_rumbleForwarder);
+		created.push_back(slot);
+	}
+
+	edit([&created](GamepadTable::Slots& slots) {
+		GamepadTable::Slots::iterator ci = created.begin();
+		for (; ci != created.end() && slots.size() < GAMEPAD_MAX_COUNT; ++ci)
+		{
+			slots.push_back(*ci);
+		}
+	});
 }
 
 void GamepadClient::connectAllGamepads()
 {
-	reduce([](Gamepad& pad) {
-		pad.connect();
-		Sleep(200);
+	using clock = chrono::steady_clock;
+	using milli = chrono::duration<double, milli>;
+
+	const shared_ptr<const GamepadTable> table = getTable();
+	const size_t count = table->size();
+
+	BringUpReport report;
+	report.padMs = vector<double>(count, 0);
+	vector<int> results(count, 0);
+
+	// XInput only has four user slots: extra XBOX pads must not wait for one.
+	vector<int> waitIndex(count, 0);
+	size_t xboxCount = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (table->slots[i].pad->getType() == Gamepad::Type::XBOX && xboxCount++ < XUSER_MAX_COUNT)
+		{
+			waitIndex[i] = 1;
+		}
+	}
+
+	clock::time_point before = clock::now();
+	reduceParallel([&](Gamepad& pad, size_t index) {
+		if (index >= count) return;
+		clock::time_point padBefore = clock::now();
+		results[index] = pad.connect(waitIndex[index] != 0);
+		report.padMs[index] = milli(clock::now() - padBefore).count();
 	});
+	report.totalMs = milli(clock::now() - before).count();
+
+	// The Gamepads widget tooltip and headless status show these timings; keep them off stdout.
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		if (!results[i]) report.failedCount++;
+	}
+
+	lock_guard<mutex> guard(_bringUpMutex);
+	_bringUpReport = report;
 }
 
 void GamepadClient::disconnectAllGamepads()
 {
-	reduce([](Gamepad& pad) {
+	reduceParallel([](Gamepad& pad, size_t index) {
 		pad.disconnect();
 	});
 }
 
+const GamepadClient::BringUpReport GamepadClient::getBringUpReport()
+{
+	lock_guard<mutex> guard(_bringUpMutex);
+	return _bringUpReport;
+}
+
+const RumbleForwarder::Stats GamepadClient::getRumbleStats() const
+{
+	return _rumbleForwarder.getStats();
+}
+
 void GamepadClient::sortGamepads()
 {
-	std::vector<Gamepad> sorted = gamepads;
-	std::sort(
-		sorted.begin(),
-		sorted.end(),
-		[](const Gamepad a, const Gamepad b) {
-			return a.getIndex() < b.getIndex();
-		}
-	);
-	gamepads = sorted;
+	// Only the slot order changes: owners travel with their pads and nothing is rebound.
+	edit([](GamepadTable::Slots& slots) {
+		std::sort(
+			slots.begin(),
+			slots.end(),
+			[](const GamepadTable::Slot& a, const GamepadTable::Slot& b) {
+				if (a.pad->getIndex() != b.pad->getIndex())
+				{
+					return a.pad->getIndex() < b.pad->getIndex();
+				}
+				return a.pad->getBusIndex() < b.pad->getBusIndex();
+			}
+		);
+	});
 }
 
 void GamepadClient::resetAll()
 {
+	if (_isResetting.exchange(true))
+	{
+		return;
+	}
+
 	_resetAllThread = thread([&]() {
 		lock = true;
 		release();
@@ -95,63 +180,171 @@ void GamepadClient::resetAll()
 		createMaximumGamepads();
 		connectAllGamepads();
 		lock = false;
-		_resetAllThread.detach();
+		_isResetting = false;
 	});
+	_resetAllThread.detach();
 }
 
 void GamepadClient::toggleLock()
 {
 	lock = !lock;
 	reduce([&](Gamepad& pad) {
-		pad.clearState();
+		pad.requestClear();
 	});
 }
 
 
-Gamepad GamepadClient::connectNextGamepad()
+shared_ptr<Gamepad> GamepadClient::connectNextGamepad()
 {
-	Gamepad rv;
+	shared_ptr<Gamepad> rv;
 
-	bool success = reduceUntilFirst([&](Gamepad& pad) {
-		if (pad.connect())
+	reduceUntilFirst(*getTable(), [&](const GamepadTable::Slot& slot) {
+		if (slot.pad->connect())
 		{
-			rv = pad;
+			rv = slot.pad;
 			return true;
 		}
 		return false;
 	});
 
-	if (success)
+	return rv;
+}
+
+shared_ptr<const GamepadTable> GamepadClient::getTable() const
+{
+	return atomic_load(&_table);
+}
+
+size_t GamepadClient::size() const
+{
+	return getTable()->size();
+}
+
+void GamepadClient::edit(function<void(GamepadTable::Slots&)> func)
+{
+	lock_guard<mutex> guard(_editMutex);
+
+	const shared_ptr<const GamepadTable> current = atomic_load(&_table);
+	shared_ptr<GamepadTable> next = make_shared<GamepadTable>(*current);
+	func(next->slots);
+	next->version = current->version + 1;
+
+	// A new owner gets a full idle grace period.
+	const uint64_t nowMs = (uint64_t)chrono::duration_cast<chrono::milliseconds>(
+		chrono::steady_clock::now().time_since_epoch()
+	).count();
+
+	// Pads whose owner changed start from a neutral state; the input thread applies it.
+	GamepadTable::Slots::iterator si = next->slots.begin();
+	for (; si != next->slots.end(); ++si)
 	{
-		return rv;
+		GamepadTable::Slots::const_iterator ci = current->slots.begin();
+		for (; ci != current->slots.end() && (*ci).pad != (*si).pad; ++ci);
+
+		if (ci == current->slots.end() || !(*si).isSameOwner((*ci).owner))
+		{
+			(*si).pad->setRumbleTarget((*si).owner);
+			(*si).pad->requestClear();
+			(*si).pad->touchInput(nowMs);
+			(*si).ownedSinceMs = nowMs;
+		}
 	}
-	
-	return Gamepad();
+
+	atomic_store(&_table, shared_ptr<const GamepadTable>(next));
+}
+
+bool GamepadClient::connect(int gamepadIndex)
+{
+	const shared_ptr<const GamepadTable> table = getTable();
+	if (!table->isValidIndex(gamepadIndex))
+	{
+		return false;
+	}
+
+	clearOwner(gamepadIndex);
+	return table->slots[gamepadIndex].pad->connect();
 }
 
 bool GamepadClient::disconnect(int gamepadIndex)
 {
-	if (gamepadIndex < 0 || gamepadIndex > gamepads.size())
+	const shared_ptr<const GamepadTable> table = getTable();
+	if (!table->isValidIndex(gamepadIndex))
 	{
 		return false;
 	}
-	bool rv = gamepads[gamepadIndex].disconnect();
+
+	bool rv = table->slots[gamepadIndex].pad->disconnect();
+	if (rv)
+	{
+		clearOwner(gamepadIndex);
+	}
 	return rv;
 }
 
 bool GamepadClient::clearOwner(int gamepadIndex)
 {
-	if (gamepadIndex >= 0 || gamepadIndex < gamepads.size())
-	{
-		gamepads[gamepadIndex].clearOwner();
-		return true;
-	}
-	return false;
+	bool rv = false;
+	edit([&](GamepadTable::Slots& slots) {
+		if (gamepadIndex >= 0 && gamepadIndex < (int)slots.size())
+		{
+			slots[gamepadIndex].owner = GuestDevice();
+			rv = true;
+		}
+	});
+	return rv;
+}
+
+bool GamepadClient::setOwner(int gamepadIndex, Guest guest, uint32_t deviceID, bool isKeyboard)
+{
+	bool rv = false;
+	edit([&](GamepadTable::Slots& slots) {
+		if (gamepadIndex >= 0 && gamepadIndex < (int)slots.size())
+		{
+			slots[gamepadIndex].owner.guest = guest;
+			slots[gamepadIndex].owner.deviceID = deviceID;
+			slots[gamepadIndex].owner.isKeyboard = isKeyboard;
+			rv = true;
+		}
+	});
+	return rv;
+}
+
+bool GamepadClient::setDeviceID(int gamepadIndex, uint32_t deviceID)
+{
+	bool rv = false;
+	edit([&](GamepadTable::Slots& slots) {
+		if (gamepadIndex >= 0 && gamepadIndex < (int)slots.size())
+		{
+			slots[gamepadIndex].owner.deviceID = deviceID;
+			rv = true;
+		}
+	});
+	return rv;
+}
+
+bool GamepadClient::swapOwners(int firstIndex, int secondIndex)
+{
+	bool rv = false;
+	edit([&](GamepadTable::Slots& slots) {
+		if (
+			firstIndex >= 0 && firstIndex < (int)slots.size() &&
+			secondIndex >= 0 && secondIndex < (int)slots.size()
+		)
+		{
+			GuestDevice backup = slots[firstIndex].owner;
+			slots[firstIndex].owner = slots[secondIndex].owner;
+			slots[secondIndex].owner = backup;
+			rv = true;
+		}
+	});
+	return rv;
 }
 
 void GamepadClient::release()
 {
 	releaseGamepads();
+	_rumbleForwarder.stop();
+	flushPreferences();
 	if (_client != nullptr)
 	{
 		vigem_disconnect(_client);
@@ -161,28 +354,33 @@ void GamepadClient::release()
 }
 
 
-Gamepad GamepadClient::getGamepad(int index)
+const GamepadTable::Slot GamepadClient::getGamepad(int index)
 {
-	if (index >= 0 && index < gamepads.size())
+	const shared_ptr<const GamepadTable> table = getTable();
+	if (table->isValidIndex(index))
 	{
-		return gamepads[index];
+		return table->slots[index];
 	}
 
-	return Gamepad();
+	return GamepadTable::Slot();
 }
 
 int GamepadClient::clearAFK(GuestList &guests)
 {
 	int clearCount = 0;
 
-	reduce([&](Gamepad& pad) {
-		if (pad.isOwned())
+	edit([&](GamepadTable::Slots& slots) {
+		GamepadTable::Slots::iterator si = slots.begin();
+		for (; si != slots.end(); ++si)
 		{
-			Guest guest;
-			if (!guests.find(pad.owner.guest.userID, &guest))
+			if ((*si).isOwned())
 			{
-				pad.clearOwner();
-				clearCount++;
+				Guest guest;
+				if (!guests.find((*si).owner.guest.userID, &guest))
+				{
+					(*si).owner = GuestDevice();
+					clearCount++;
+				}
 			}
 		}
 	});
@@ -190,15 +388,144 @@ int GamepadClient::clearAFK(GuestList &guests)
 	return clearCount;
 }
 
+vector<GamepadClient::IdleReclaim> GamepadClient::reclaimIdle(uint64_t thresholdMs, function<bool(const GuestDevice&)> isExempt)
+{
+	vector<IdleReclaim> reclaimed;
+	if (thresholdMs == 0)
+	{
+		return reclaimed;
+	}
+
+	const uint64_t nowMs = (uint64_t)chrono::duration_cast<chrono::milliseconds>(
+		chrono::steady_clock::now().time_since_epoch()
+	).count();
+
+	// Cheap pass on the snapshot first, so a room with nobody to reclaim never publishes.
+	bool hasIdle = false;
+	const shared_ptr<const GamepadTable> table = getTable();
+	GamepadTable::Slots::const_iterator ti = table->slots.begin();
+	for (; ti != table->slots.end() && !hasIdle; ++ti)
+	{
+		const uint64_t lastInputMs = (*ti).pad->getLastInputMs();
+		hasIdle = (*ti).isOwned() && nowMs > lastInputMs && nowMs - lastInputMs >= thresholdMs && !isExempt((*ti).owner);
+	}
+	if (!hasIdle)
+	{
+		return reclaimed;
+	}
+
+	edit([&](GamepadTable::Slots& slots) {
+		for (size_t i = 0; i < slots.size(); ++i)
+		{
+			const uint64_t lastInputMs = slots[i].pad->getLastInputMs();
+			if (
+				slots[i].isOwned() && nowMs > lastInputMs && nowMs - lastInputMs >= thresholdMs &&
+				!isExempt(slots[i].owner)
+			)
+			{
+				IdleReclaim reclaim;
+				reclaim.index = (int)i;
+				reclaim.owner = slots[i].owner;
+				reclaim.idleMs = nowMs - lastInputMs;
+				reclaimed.push_back(reclaim);
+
+				slots[i].owner = GuestDevice();
+			}
+		}
+	});
+
+	return reclaimed;
+}
+
+vector<GamepadClient::Handoff> GamepadClient::serviceQueue(GuestList& guests)
+{
+	vector<Handoff> handoffs;
+	if (_padQueue.isEmpty())
+	{
+		return handoffs;
+	}
+
+	const uint64_t nowMs = (uint64_t)chrono::duration_cast<chrono::milliseconds>(
+		chrono::steady_clock::now().time_since_epoch()
+	).count();
+
+	// A pad is up for grabs when it's free, or when its holder's rotation turn is over.
+	function<bool(const GamepadTable::Slot&, size_t)> isAvailable = [&](const GamepadTable::Slot& slot, size_t index) {
+		if (!slot.isOwned())
+		{
+			return slot.pad->isAttached();
+		}
+		const uint64_t rotationMs = (uint64_t)_padQueue.getRotation(index) * 1000;
+		return rotationMs > 0 && nowMs > slot.ownedSinceMs && nowMs - slot.ownedSinceMs >= rotationMs;
+	};
+
+	bool hasAvailable = false;
+	const shared_ptr<const GamepadTable> table = getTable();
+	for (size_t i = 0; i < table->size() && !hasAvailable; ++i)
+	{
+		hasAvailable = isAvailable(table->slots[i], i);
+	}
+	if (!hasAvailable)
+	{
+		return handoffs;
+	}
+
+	edit([&](GamepadTable::Slots& slots) {
+		for (size_t i = 0; i < slots.size(); ++i)
+		{
+			if (!isAvailable(slots[i], i))
+			{
+				continue;
+			}
+
+			Guest guest;
+			PadQueue::Entry entry;
+			const bool found = _padQueue.popFirst([&](const PadQueue::Entry& candidate) {
+				return candidate.userID != slots[i].owner.guest.userID && guests.find(candidate.userID, &guest);
+			}, entry);
+			if (!found)
+			{
+				break;
+			}
+
+			Handoff handoff;
+			handoff.index = (int)i;
+			handoff.guest = guest;
+			handoff.previous = slots[i].owner;
+			handoff.isRotation = slots[i].isOwned();
+			if (handoff.isRotation)
+			{
+				_padQueue.join(slots[i].owner.guest, slots[i].owner.deviceID, slots[i].owner.isKeyboard);
+			}
+
+			slots[i].owner.guest = guest;
+			slots[i].owner.deviceID = entry.deviceID;
+			slots[i].owner.isKeyboard = entry.isKeyboard;
+			handoffs.push_back(handoff);
+		}
+	});
+
+	return handoffs;
+}
+
+PadQueue& GamepadClient::getPadQueue()
+{
+	return _padQueue;
+}
+
 int GamepadClient::onQuit(Guest& guest)
 {
 	int result = 0;
 
-	reduce([&](Gamepad& gamepad) {
-		if (gamepad.owner.guest.userID == guest.userID)
+	edit([&](GamepadTable::Slots& slots) {
+		GamepadTable::Slots::iterator si = slots.begin();
+		for (; si != slots.end(); ++si)
 		{
-			gamepad.clearOwner();
-			result++;
+			if ((*si).isOwnedBy(guest.userID))
+			{
+				(*si).owner = GuestDevice();
+				result++;
+			}
 		}
 	});
 
@@ -207,108 +534,121 @@ int GamepadClient::onQuit(Guest& guest)
 
 void GamepadClient::setLimit(uint32_t guestUserID, uint8_t padLimit)
 {
-	bool found = findPreferences(guestUserID, [&padLimit](GuestPreferences& prefs) {
+	_preferences.edit(guestUserID, [&padLimit](GuestPreferences& prefs) {
 		prefs.padLimit = padLimit;
 	});
-
-	if (!found)
-	{
-		guestPreferences.push_back(
-			GuestPreferences(guestUserID, padLimit)
-		);
-	}
 }
 
 bool GamepadClient::toggleMirror(uint32_t guestUserID)
 {
-	bool currentValue = false;
-
-	bool found = findPreferences(guestUserID, [&currentValue](GuestPreferences& prefs) {
-		prefs.mirror = !prefs.mirror;
-		currentValue = prefs.mirror;
-	});
-
-	if(!found)
-	{
-		GuestPreferences prefs = GuestPreferences(guestUserID, 1, true);
-		guestPreferences.push_back(prefs);
-		currentValue = prefs.mirror;
-	}
+	InputTransform::Settings settings = getTransformSettings(guestUserID);
+	settings.stickToDpad = !settings.stickToDpad;
+	setTransform(guestUserID, settings);
 
-	return currentValue;
+	return settings.stickToDpad;
 }
 
 bool GamepadClient::toggleIgnoreDeviceID(uint32_t guestUserID)
 {
 	bool currentValue = false;
 
-	bool found = findPreferences(guestUserID, [&currentValue](GuestPreferences& prefs) {
+	_preferences.edit(guestUserID, [&currentValue](GuestPreferences& prefs) {
 		prefs.ignoreDeviceID = !prefs.ignoreDeviceID;
 		currentValue = prefs.ignoreDeviceID;
 	});
 
-	if (!found)
-	{
-		GuestPreferences prefs = GuestPreferences(guestUserID, 1, false, true);
-		guestPreferences.push_back(prefs);
-		currentValue = prefs.ignoreDeviceID;
-	}
-
 	return currentValue;
 }
 
-const GamepadClient::PICK_REQUEST GamepadClient::pick(Guest guest, int gamepadIndex)
+const InputTransform::Settings GamepadClient::getTransformSettings(uint32_t guestUserID)
 {
-
-	if (gamepadIndex < 0 || gamepadIndex >= gamepads.size())
+	InputTransform::Settings settings;
+	const GuestPreferences prefs = _preferences.get(guestUserID);
+	if (prefs.transform != nullptr)
 	{
-		return PICK_REQUEST::OUT_OF_RANGE;
+		settings = prefs.transform->getSettings();
 	}
+	settings.stickToDpad = prefs.mirror;
 
-	if (!gamepads[gamepadIndex].isConnected())
-	{
-		return PICK_REQUEST::DISCONNECTED;
-	}
+	return settings;
+}
 
-	if (gamepads[gamepadIndex].owner.guest.userID == guest.userID)
-	{
-		return PICK_REQUEST::SAME_USER;
-	}
+void GamepadClient::setTransform(uint32_t guestUserID, const InputTransform::Settings settings)
+{
+	// Tables are rebuilt here, on the command thread, so the input path only swaps a pointer.
+	shared_ptr<const InputTransform> transform = settings.isIdentity()
+		? nullptr
+		: make_shared<const InputTransform>(settings);
 
-	if (gamepads[gamepadIndex].isOwned())
-	{
-		return PICK_REQUEST::TAKEN;
-	}
+	_preferences.edit(guestUserID, [&](GuestPreferences& prefs) {
+		prefs.mirror = settings.stickToDpad;
+		prefs.transform = transform;
+	});
+}
+
+void GamepadClient::tickTurbo()
+{
+	const uint64_t nowMs = (uint64_t)chrono::duration_cast<chrono::milliseconds>(
+		chrono::steady_clock::now().time_since_epoch()
+	).count();
 
-	GuestPreferences prefs = GuestPreferences(guest.userID);
-	int limit = 1;
-	bool found = findPreferences(guest.userID, [&limit](GuestPreferences& prefs) {
-		limit = prefs.padLimit;
+	reduce([&nowMs](Gamepad& pad) {
+		pad.refreshTurbo(nowMs);
 	});
+}
 
-	if (limit <= 0)
-	{
-		return PICK_REQUEST::LIMIT_BLOCK;
-	}
+const GamepadClient::PICK_REQUEST GamepadClient::pick(Guest guest, int gamepadIndex)
+{
+	const int limit = _preferences.get(guest.userID).padLimit;
 
-	bool success = reduceUntilFirst([&](Gamepad& gamepad) {
-		if (gamepad.owner.guest.userID == guest.userID)
+	// Checked and applied against the same version, so two guests can't pick one pad.
+	PICK_REQUEST result = PICK_REQUEST::EMPTY_HANDS;
+	edit([&](GamepadTable::Slots& slots) {
+		if (gamepadIndex < 0 || gamepadIndex >= (int)slots.size())
 		{
-			gamepads[gamepadIndex].clearState();
-			gamepads[gamepadIndex].copyOwner(gamepad);
-			gamepad.clearOwner();
-			return true;
+			result = PICK_REQUEST::OUT_OF_RANGE;
+			return;
 		}
 
-		return false;
-	});
+		GamepadTable::Slot& target = slots[gamepadIndex];
+		if (!target.pad->isConnected())
+		{
+			result = PICK_REQUEST::DISCONNECTED;
+			return;
+		}
 
-	if (success)
-	{
-		return PICK_REQUEST::OK;
-	}
+		if (target.isOwnedBy(guest.userID))
+		{
+			result = PICK_REQUEST::SAME_USER;
+			return;
+		}
+
+		if (target.isOwned())
+		{
+			result = PICK_REQUEST::TAKEN;
+			return;
+		}
+
+		if (limit <= 0)
+		{
+			result = PICK_REQUEST::LIMIT_BLOCK;
+			return;
+		}
 
-	return PICK_REQUEST::EMPTY_HANDS;
+		GamepadTable::Slots::iterator si = slots.begin();
+		for (; si != slots.end(); ++si)
+		{
+			if ((*si).isOwnedBy(guest.userID))
+			{
+				target.owner = (*si).owner;
+				(*si).owner = GuestDevice();
+				result = PICK_REQUEST::OK;
+				return;
+			}
+		}
+	});
+
+	return result;
 }
 
 
@@ -325,35 +665,39 @@ bool GamepadClient::sendMessage(Guest guest, ParsecMessage message)
 	bool isGamepadRequest = false;
 	int slots = 0;
 	
-	GuestPreferences guestPrefs = GuestPreferences();
-	findPreferences(guest.userID, [&guestPrefs](GuestPreferences& prefs) {
-		guestPrefs = prefs;
-	});
+	// One snapshot each for the whole message: no lock, and no torn view if an edit lands meanwhile.
+	const shared_ptr<const GamepadTable> table = atomic_load(&_table);
+	const shared_ptr<const GuestPreferencesStore::Table> preferences = _preferences.getTable();
+	const GuestPreferences& guestPrefs = GuestPreferencesStore::find(*preferences, guest.userID);
 
 	switch (message.type)
 	{
 	case MESSAGE_GAMEPAD_STATE:
 		padId = message.gamepadState.id;
 		isGamepadRequest = isRequestState(message);
-		if (sendGamepadStateMessage(message.gamepadState, guest, slots, guestPrefs)) { return true; }
+		if (sendGamepadStateMessage(*table, message.gamepadState, guest, slots, guestPrefs)) { return true; }
 		break;
 
 	case MESSAGE_GAMEPAD_AXIS:
 		padId = message.gamepadAxis.id;
-		if (sendGamepadAxisMessage(message.gamepadAxis, guest, slots, guestPrefs)) { return true; }
+		if (sendGamepadAxisMessage(*table, message.gamepadAxis, guest, slots, guestPrefs)) { return true; }
 		break;
 
 	case MESSAGE_GAMEPAD_BUTTON:
 		padId = message.gamepadButton.id;
 		isGamepadRequest = isRequestButton(message);
-		if (sendGamepadButtonMessage(message.gamepadButton, guest, slots, guestPrefs)) { return true; }
+		if (sendGamepadButtonMessage(*table, message.gamepadButton, guest, slots, guestPrefs)) { return true; }
 		break;
 
 	case MESSAGE_KEYBOARD:
+	{
+		const shared_ptr<const KeyMap::GuestKeyMaps> keyMaps = atomic_load(&_keyMaps);
+		const KeyMap& keyMap = findKeyMap(guest.userID, keyMaps);
 		padId = 0;
-		isGamepadRequest = isRequestKeyboard(message);
-		if (sendKeyboardMessage(message.keyboard, guest, slots, guestPrefs)) { return true; }
+		isGamepadRequest = isRequestKeyboard(message, keyMap);
+		if (sendKeyboardMessage(*table, message.keyboard, guest, slots, keyMap, guestPrefs)) { return true; }
 		break;
+	}
 
 	default:
 		break;
@@ -367,15 +711,16 @@ bool GamepadClient::sendMessage(Guest guest, ParsecMessage message)
 	return success;
 }
 
-bool GamepadClient::sendGamepadStateMessage(ParsecGamepadStateMessage& gamepadState, Guest& guest, int &slots, GuestPreferences prefs)
+bool GamepadClient::sendGamepadStateMessage(const GamepadTable& table, ParsecGamepadStateMessage& gamepadState, Guest& guest, int &slots, const GuestPreferences& prefs)
 {
-	return reduceUntilFirst([&](Gamepad& pad) {
-	if (guest.userID == pad.owner.guest.userID)
+	return reduceUntilFirst(table, [&](const GamepadTable::Slot& slot) {
+	if (guest.userID == slot.owner.guest.userID)
 	{
 		slots++;
-		if (prefs.ignoreDeviceID || gamepadState.id == pad.owner.deviceID)
+		if (prefs.ignoreDeviceID || gamepadState.id == slot.owner.deviceID)
 		{
-			pad.setState(gamepadState);
+			slot.pad->setTransform(prefs.transform);
+			slot.pad->setState(gamepadState);
 			return true;
 		}
 	}
@@ -383,15 +728,16 @@ bool GamepadClient::sendGamepadStateMessage(ParsecGamepadStateMessage& gamepadSt
 	});
 }
 
-bool GamepadClient::sendGamepadAxisMessage(ParsecGamepadAxisMessage& gamepadAxis, Guest& guest, int& slots, GuestPreferences prefs)
+bool GamepadClient::sendGamepadAxisMessage(const GamepadTable& table, ParsecGamepadAxisMessage& gamepadAxis, Guest& guest, int& slots, const GuestPreferences& prefs)
 {
-	return reduceUntilFirst([&](Gamepad& pad) {
-		if (guest.userID == pad.owner.guest.userID)
+	return reduceUntilFirst(table, [&](const GamepadTable::Slot& slot) {
+		if (guest.userID == slot.owner.guest.userID)
 		{
 			slots++;
-			if (prefs.ignoreDeviceID || gamepadAxis.id == pad.owner.deviceID)
+			if (prefs.ignoreDeviceID || gamepadAxis.id == slot.owner.deviceID)
 			{
-				pad.setState(gamepadAxis);
+				slot.pad->setTransform(prefs.transform);
+				slot.pad->setState(gamepadAxis);
 				return true;
 			}
 		}
@@ -399,15 +745,16 @@ bool GamepadClient::sendGamepadAxisMessage(ParsecGamepadAxisMessage& gamepadAxis
 	});
 }
 
-bool GamepadClient::sendGamepadButtonMessage(ParsecGamepadButtonMessage& gamepadButton, Guest& guest, int& slots, GuestPreferences prefs)
+bool GamepadClient::sendGamepadButtonMessage(const GamepadTable& table, ParsecGamepadButtonMessage& gamepadButton, Guest& guest, int& slots, const GuestPreferences& prefs)
 {
-	return reduceUntilFirst([&](Gamepad& pad) {
-		if (guest.userID == pad.owner.guest.userID)
+	return reduceUntilFirst(table, [&](const GamepadTable::Slot& slot) {
+		if (guest.userID == slot.owner.guest.userID)
 		{
 			slots++;
-			if (prefs.ignoreDeviceID || gamepadButton.id == pad.owner.deviceID)
+			if (prefs.ignoreDeviceID || gamepadButton.id == slot.owner.deviceID)
 			{
-				pad.setState(gamepadButton);
+				slot.pad->setTransform(prefs.transform);
+				slot.pad->setState(gamepadButton);
 				return true;
 			}
 		}
@@ -415,15 +762,16 @@ bool GamepadClient::sendGamepadButtonMessage(ParsecGamepadButtonMessage& gamepad
 	});
 }
 
-bool GamepadClient::sendKeyboardMessage(ParsecKeyboardMessage& keyboard, Guest& guest, int& slots, GuestPreferences prefs)
+bool GamepadClient::sendKeyboardMessage(const GamepadTable& table, ParsecKeyboardMessage& keyboard, Guest& guest, int& slots, const KeyMap& keyMap, const GuestPreferences& prefs)
 {
-	return reduceUntilFirst([&](Gamepad& pad) {
-		if (guest.userID == pad.owner.guest.userID)
+	return reduceUntilFirst(table, [&](const GamepadTable::Slot& slot) {
+		if (guest.userID == slot.owner.guest.userID)
 		{
 			slots++;
-			if (prefs.ignoreDeviceID || pad.owner.isKeyboard)
+			if (prefs.ignoreDeviceID || slot.owner.isKeyboard)
 			{
-				pad.setState(keyboard);
+				slot.pad->setTransform(prefs.transform);
+				slot.pad->setState(keyboard, keyMap);
 				return true;
 			}
 		}
@@ -431,57 +779,90 @@ bool GamepadClient::sendKeyboardMessage(ParsecKeyboardMessage& keyboard, Guest&
 		});
 }
 
-bool GamepadClient::tryAssignGamepad(Guest guest, uint32_t deviceID, int currentSlots, bool isKeyboard, GuestPreferences prefs)
+bool GamepadClient::tryAssignGamepad(Guest guest, uint32_t deviceID, int currentSlots, bool isKeyboard, const GuestPreferences& prefs)
 {
 	if (currentSlots >= prefs.padLimit)
 	{
 		return false;
 	}
 	
-	return reduceUntilFirst([&](Gamepad& gamepad) {
-		if (gamepad.isAttached() && !gamepad.owner.guest.isValid())
+	// A line is already waiting: get in it instead of jumping ahead.
+	if (!_padQueue.isEmpty() && !_padQueue.isFront(guest.userID))
+	{
+		if (currentSlots == 0)
 		{
-			gamepad.setOwner(guest, deviceID, isKeyboard);
-			return true;
+			joinQueue(guest, deviceID, isKeyboard);
 		}
-
 		return false;
+	}
+
+	// Cold path: only taken when a guest without a pad asks for one.
+	bool success = false;
+	edit([&](GamepadTable::Slots& slots) {
+		GamepadTable::Slots::iterator si = slots.begin();
+		for (; si != slots.end(); ++si)
+		{
+			if ((*si).pad->isAttached() && !(*si).isOwned())
+			{
+				(*si).owner.guest = guest;
+				(*si).owner.deviceID = deviceID;
+				(*si).owner.isKeyboard = isKeyboard;
+				success = true;
+				return;
+			}
+		}
 	});
+
+	if (success)
+	{
+		_padQueue.leave(guest.userID);
+	}
+	else if (currentSlots == 0)
+	{
+		joinQueue(guest, deviceID, isKeyboard);
+	}
+
+	return success;
 }
 
-void GamepadClient::releaseGamepads()
+void GamepadClient::joinQueue(Guest& guest, uint32_t deviceID, bool isKeyboard)
 {
-	reduce([](Gamepad& pad) {
-		pad.release();
-	});
-
-	gamepads.clear();
+	const size_t position = _padQueue.join(guest, deviceID, isKeyboard);
+	if (position > 0)
+	{
+		_padQueue.notify(CommandReply::format(
+			"[ChatBot] | Every gamepad is taken. ", guest.name, " is number ", position, " in the queue."
+		));
+	}
 }
 
-void GamepadClient::setMirror(uint32_t guestUserID, bool mirror)
+void GamepadClient::releaseGamepads()
 {
-	bool found = findPreferences(guestUserID, [&mirror](GuestPreferences& prefs) {
-		prefs.mirror = mirror;
+	// Unpublish first so new readers stop reaching the pads, then free the targets.
+	shared_ptr<const GamepadTable> released = getTable();
+	edit([](GamepadTable::Slots& slots) {
+		slots.clear();
 	});
 
-	if (!found)
+	GamepadTable::Slots::const_iterator si = released->slots.begin();
+	for (; si != released->slots.end(); ++si)
 	{
-		GuestPreferences prefs = GuestPreferences(guestUserID, 1, mirror);
-		guestPreferences.push_back(prefs);
+		(*si).pad->release();
 	}
 }
 
+void GamepadClient::setMirror(uint32_t guestUserID, bool mirror)
+{
+	InputTransform::Settings settings = getTransformSettings(guestUserID);
+	settings.stickToDpad = mirror;
+	setTransform(guestUserID, settings);
+}
+
 void GamepadClient::setIgnoreDeviceID(uint32_t guestUserID, bool ignoreDeviceID)
 {
-	bool found = findPreferences(guestUserID, [&ignoreDeviceID](GuestPreferences& prefs) {
+	_preferences.edit(guestUserID, [&ignoreDeviceID](GuestPreferences& prefs) {
 		prefs.ignoreDeviceID = ignoreDeviceID;
 	});
-
-	if (!found)
-	{
-		GuestPreferences prefs = GuestPreferences(guestUserID, 1, false, ignoreDeviceID);
-		guestPreferences.push_back(prefs);
-	}
 }
 
 bool GamepadClient::isRequestState(ParsecMessage message)
@@ -499,54 +880,83 @@ bool GamepadClient::isRequestButton(ParsecMessage message)
 		);
 }
 
-bool GamepadClient::isRequestKeyboard(ParsecMessage message)
+bool GamepadClient::isRequestKeyboard(ParsecMessage message, const KeyMap& keyMap)
 {
-	return message.keyboard.pressed && (
-		message.keyboard.code == (int)KEY_TO_GAMEPAD::A ||
-		message.keyboard.code == (int)KEY_TO_GAMEPAD::B ||
-		message.keyboard.code == (int)KEY_TO_GAMEPAD::X ||
-		message.keyboard.code == (int)KEY_TO_GAMEPAD::Y ||
-		message.keyboard.code == (int)KEY_TO_GAMEPAD2::A ||
-		message.keyboard.code == (int)KEY_TO_GAMEPAD2::B ||
-		message.keyboard.code == (int)KEY_TO_GAMEPAD2::X ||
-		message.keyboard.code == (int)KEY_TO_GAMEPAD2::Y
-		);
+	return keyMap.isRequest(message.keyboard);
+}
+
+const KeyMap& GamepadClient::findKeyMap(uint32_t guestUserID, const shared_ptr<const KeyMap::GuestKeyMaps>& keyMaps)
+{
+	KeyMap::GuestKeyMaps::const_iterator it = keyMaps->find(guestUserID);
+	return (it != keyMaps->end()) ? it->second : KeyMap::DEFAULT;
 }
 
 void GamepadClient::reduce(function<void(Gamepad&)> func)
 {
-	vector<Gamepad>::iterator gi = gamepads.begin();
-	for (; gi != gamepads.end(); ++gi)
+	const shared_ptr<const GamepadTable> table = getTable();
+	GamepadTable::Slots::const_iterator si = table->slots.begin();
+	for (; si != table->slots.end(); ++si)
 	{
-		func(*gi);
+		func(*(*si).pad);
 	}
 }
 
-bool GamepadClient::reduceUntilFirst(function<bool(Gamepad&)> func)
+void GamepadClient::reduceParallel(function<void(Gamepad&, size_t)> func)
 {
-	vector<Gamepad>::iterator gi = gamepads.begin();
-	for (; gi != gamepads.end(); ++gi)
+	const shared_ptr<const GamepadTable> table = getTable();
+	vector<future<void>> tasks;
+	tasks.reserve(table->size());
+
+	for (size_t i = 0; i < table->size(); ++i)
 	{
-		if (func(*gi))
-		{
-			return true;
-		}
+		Gamepad* pad = table->slots[i].pad.get();
+		tasks.push_back(async(launch::async, [&func, pad, i]() {
+			func(*pad, i);
+		}));
 	}
 
-	return false;
+	vector<future<void>>::iterator ti = tasks.begin();
+	for (; ti != tasks.end(); ++ti)
+	{
+		(*ti).wait();
+	}
 }
 
-bool GamepadClient::findPreferences(uint32_t guestUserID, function<void(GamepadClient::GuestPreferences&)> callback)
+bool GamepadClient::reduceUntilFirst(const GamepadTable& table, function<bool(const GamepadTable::Slot&)> func)
 {
-	std::vector<GuestPreferences>::iterator it;
-	for (it = guestPreferences.begin(); it != guestPreferences.end(); ++it)
+	GamepadTable::Slots::const_iterator si = table.slots.begin();
+	for (; si != table.slots.end(); ++si)
 	{
-		if ((*it).userID == guestUserID)
+		if (func(*si))
 		{
-			callback(*it);
 			return true;
 		}
 	}
 
 	return false;
+}
+
+size_t GamepadClient::loadKeyMaps()
+{
+	shared_ptr<const KeyMap::GuestKeyMaps> keyMaps = make_shared<const KeyMap::GuestKeyMaps>(
+		KeyMap::load(MetadataCache::getUserDir() + KEYMAP_FILENAME)
+	);
+	atomic_store(&_keyMaps, keyMaps);
+	return keyMaps->size();
+}
+
+size_t GamepadClient::loadPreferences()
+{
+	return _preferences.load(MetadataCache::getUserDir() + GUEST_PREFERENCES_FILENAME);
+}
+
+bool GamepadClient::flushPreferences()
+{
+	return _preferences.flush(MetadataCache::getUserDir() + GUEST_PREFERENCES_FILENAME);
+}
+
+void GamepadClient::setPersistence(PersistenceWorker* persistence)
+{
+	_preferences.setPersistence(persistence);
+	_padQueue.setPersistence(persistence);
 }
\ No newline at end of file
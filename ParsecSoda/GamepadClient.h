@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Gamepad.h"
+#include "GamepadTable.h"
 #include <Windows.h>
 #include <Xinput.h>
 #include "ViGEm/Client.h"
@@ -9,9 +10,19 @@
 #include <algorithm>
 #include <functional>
 #include <thread>
+#include <future>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
 #include "GuestData.h"
-#include "KeyboardMaps.h"
+#include "KeyMap.h"
 #include "GuestList.h"
+#include "MetadataCache.h"
+#include "RumbleForwarder.h"
+#include "PadQueue.h"
+#include "GuestPreferences.h"
+#include "Commands/CommandReply.h"
 
 using namespace std;
 
@@ -32,73 +43,120 @@ public:
 		OUT_OF_RANGE
 	};
 
-	class GuestPreferences
+	class IdleReclaim
 	{
 	public:
-		GuestPreferences()
-			: userID(0), padLimit(1), mirror(false), ignoreDeviceID(false)
-		{}
-		GuestPreferences(uint32_t userID, int padLimit = 1, bool mirror = false, bool ignoreDeviceID = false)
-			: userID(userID), padLimit(padLimit), mirror(mirror), ignoreDeviceID(ignoreDeviceID)
-		{}
-
-		uint32_t userID = 0;
-		int padLimit = 1;
-		bool mirror = false;
-		bool ignoreDeviceID = false;
+		int index = -1;
+		GuestDevice owner;
+		uint64_t idleMs = 0;
+	};
+
+	class Handoff
+	{
+	public:
+		int index = -1;
+		Guest guest;
+		GuestDevice previous;
+		bool isRotation = false;
+	};
+
+	class BringUpReport
+	{
+	public:
+		vector<double> padMs;
+		double totalMs = 0;
+		int failedCount = 0;
 	};
 
 	~GamepadClient();
 	void setParsec(ParsecDSO* parsec);
 	bool init();
-	Gamepad createGamepad(uint16_t index);
+	shared_ptr<Gamepad> createGamepad(uint16_t index, Gamepad::Type type = Gamepad::Type::XBOX);
 	void createMaximumGamepads();
 	void connectAllGamepads();
 	void disconnectAllGamepads();
+	const BringUpReport getBringUpReport();
+	const RumbleForwarder::Stats getRumbleStats() const;
 	void sortGamepads();
 	void resetAll();
 	void toggleLock();
-	Gamepad connectNextGamepad();
+	shared_ptr<Gamepad> connectNextGamepad();
 	void release();
-	Gamepad getGamepad(int index);
+	const GamepadTable::Slot getGamepad(int index);
 	int clearAFK(GuestList &guests);
+	vector<IdleReclaim> reclaimIdle(uint64_t thresholdMs, function<bool(const GuestDevice&)> isExempt);
+	vector<Handoff> serviceQueue(GuestList& guests);
+	PadQueue& getPadQueue();
+
+	shared_ptr<const GamepadTable> getTable() const;
+	size_t size() const;
+	void edit(function<void(GamepadTable::Slots&)> func);
 
+	bool connect(int gamepadIndex);
 	bool disconnect(int gamepadIndex);
 	bool clearOwner(int gamepadIndex);
+	bool setOwner(int gamepadIndex, Guest guest, uint32_t deviceID, bool isKeyboard = false);
+	bool setDeviceID(int gamepadIndex, uint32_t deviceID);
+	bool swapOwners(int firstIndex, int secondIndex);
 
 	bool sendMessage(Guest guest, ParsecMessage message);
 	int onQuit(Guest &guest);
 	void setLimit(uint32_t guestUserId, uint8_t padLimit);
 	bool toggleMirror(uint32_t guestUserID);
 	bool toggleIgnoreDeviceID(uint32_t guestUserID);
+	const InputTransform::Settings getTransformSettings(uint32_t guestUserID);
+	void setTransform(uint32_t guestUserID, const InputTransform::Settings settings);
+	void tickTurbo();
 	const PICK_REQUEST pick(Guest guest, int gamepadIndex);
-	bool findPreferences(uint32_t guestUserID, function<void(GuestPreferences&)> callback);
-	
-	vector<Gamepad> gamepads;
-	vector<GuestPreferences> guestPreferences;
+	size_t loadKeyMaps();
+	size_t loadPreferences();
+	bool flushPreferences();
+
+	/** Preference and queue saves go through the worker once set. */
+	void setPersistence(PersistenceWorker* persistence);
 
 	bool lock = false;
 
 
 private:
-	bool sendGamepadStateMessage(ParsecGamepadStateMessage& gamepadState, Guest& guest, int& slots, GuestPreferences prefs = GuestPreferences());
-	bool sendGamepadAxisMessage(ParsecGamepadAxisMessage& gamepadAxis, Guest& guest, int& slots, GuestPreferences prefs = GuestPreferences());
-	bool sendGamepadButtonMessage(ParsecGamepadButtonMessage& gamepadButton, Guest& guest, int& slots, GuestPreferences prefs = GuestPreferences());
-	bool sendKeyboardMessage(ParsecKeyboardMessage& keyboard, Guest& guest, int& slots, GuestPreferences prefs = GuestPreferences());
+	bool sendGamepadStateMessage(const GamepadTable& table, ParsecGamepadStateMessage& gamepadState, Guest& guest, int& slots, const GuestPreferences& prefs = GuestPreferences::DEFAULT);
+	bool sendGamepadAxisMessage(const GamepadTable& table, ParsecGamepadAxisMessage& gamepadAxis, Guest& guest, int& slots, const GuestPreferences& prefs = GuestPreferences::DEFAULT);
+	bool sendGamepadButtonMessage(const GamepadTable& table, ParsecGamepadButtonMessage& gamepadButton, Guest& guest, int& slots, const GuestPreferences& prefs = GuestPreferences::DEFAULT);
+	bool sendKeyboardMessage(const GamepadTable& table, ParsecKeyboardMessage& keyboard, Guest& guest, int& slots, const KeyMap& keyMap, const GuestPreferences& prefs = GuestPreferences::DEFAULT);
 
 	void releaseGamepads();
+	void joinQueue(Guest& guest, uint32_t deviceID, bool isKeyboard);
 	void setMirror(uint32_t guestUserID, bool mirror);
 	void setIgnoreDeviceID(uint32_t guestUserID, bool ignoreDeviceID);
-	bool tryAssignGamepad(Guest guest, uint32_t padId, int currentSlots, bool isKeyboard, GuestPreferences prefs = GuestPreferences());
+	bool tryAssignGamepad(Guest guest, uint32_t padId, int currentSlots, bool isKeyboard, const GuestPreferences& prefs = GuestPreferences::DEFAULT);
 	bool isRequestState(ParsecMessage message);
 	bool isRequestButton(ParsecMessage message);
-	bool isRequestKeyboard(ParsecMessage message);
+	bool isRequestKeyboard(ParsecMessage message, const KeyMap& keyMap);
+	const KeyMap& findKeyMap(uint32_t guestUserID, const shared_ptr<const KeyMap::GuestKeyMaps>& keyMaps);
 
 	void reduce(function<void(Gamepad&)> func);
-	bool reduceUntilFirst(function<bool(Gamepad&)> func);
+	void reduceParallel(function<void(Gamepad&, size_t)> func);
+	bool reduceUntilFirst(const GamepadTable& table, function<bool(const GamepadTable::Slot&)> func);
+
+	PVIGEM_CLIENT _client = nullptr;
+	ParsecDSO* _parsec = nullptr;
 
-	PVIGEM_CLIENT _client;
-	ParsecDSO* _parsec;
+	/**
+	 * Current gamepad table, read with atomic_load and replaced with atomic_store.
+	 * Readers (input, UI, commands) never lock; writers serialize on _editMutex.
+	 */
+	shared_ptr<const GamepadTable> _table = make_shared<const GamepadTable>();
+	mutex _editMutex;
 
 	thread _resetAllThread;
+	atomic<bool> _isResetting { false };
+
+	shared_ptr<const KeyMap::GuestKeyMaps> _keyMaps = make_shared<const KeyMap::GuestKeyMaps>();
+
+	RumbleForwarder _rumbleForwarder;
+	PadQueue _padQueue;
+	GuestPreferencesStore _preferences;
+
+	BringUpReport _bringUpReport;
+	mutex _bringUpMutex;
 };
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include "GamepadTable.h"
+
+bool GamepadTable::Slot::isOwned() const
+{
+	return owner.guest.isValid();
+}
+
+bool GamepadTable::Slot::isOwnedBy(uint32_t userID) const
+{
+	return owner.guest.isValid() && owner.guest.userID == userID;
+}
+
+bool GamepadTable::Slot::isSameOwner(const GuestDevice& device) const
+{
+	return owner.guest.isValid() == device.guest.isValid()
+		&& owner.guest.userID == device.guest.userID
+		&& owner.deviceID == device.deviceID
+		&& owner.isKeyboard == device.isKeyboard;
+}
+
+size_t GamepadTable::size() const
+{
+	return slots.size();
+}
+
+bool GamepadTable::isValidIndex(int index) const
+{
+	return index >= 0 && index < (int)slots.size();
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include "Gamepad.h"
+#include "GuestDevice.h"
+
+using namespace std;
+
+/**
+ * One published version of the gamepad engine: which device sits in each slot
+ * and who owns it. A table is never modified once GamepadClient publishes it;
+ * edits copy the slots, change the copy and publish a new version, so a reader
+ * holding a table always sees a consistent one and keeps its devices alive.
+ */
+class GamepadTable
+{
+public:
+	class Slot
+	{
+	public:
+		bool isOwned() const;
+		bool isOwnedBy(uint32_t userID) const;
+		bool isSameOwner(const GuestDevice& device) const;
+
+		/** Device handle: shared across versions, never copied. */
+		shared_ptr<Gamepad> pad;
+		GuestDevice owner = GuestDevice();
+
+		/** Steady clock ms when the current owner got this pad (for timed rotation). */
+		uint64_t ownedSinceMs = 0;
+	};
+
+	typedef vector<Slot> Slots;
+
+	size_t size() const;
+	bool isValidIndex(int index) const;
+
+	uint64_t version = 0;
+	Slots slots;
+};
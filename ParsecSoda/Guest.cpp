@@ -12,7 +12,7 @@ Guest::Guest(ParsecGuest guest)
 	: name(guest.name), userID(guest.userID), id(guest.id), status(Status::OK)
 {}
 
-const bool Guest::isValid()
+const bool Guest::isValid() const
 {
 	return status == Status::OK;
 }
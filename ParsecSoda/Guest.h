@@ -33,7 +33,7 @@ public:
 	 */
 	Guest(ParsecGuest guest);
 
-	const bool isValid();
+	const bool isValid() const;
 
 	Guest copy(const Guest& guest);
 
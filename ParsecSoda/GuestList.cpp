@@ -1,47 +1,116 @@
 #include "GuestList.h"
 
+GuestList::GuestList()
+{
+	_guests.reserve(GUESTLIST_MAX_GUESTS);
+	for (size_t i = 0; i < GUESTLIST_MAX_GUESTS; i++)
+	{
+		_names[i][0] = '\0';
+		guestNames[i] = _names[i];
+	}
+}
+
 void GuestList::setGuests(ParsecGuest* guests, int guestCount)
 {
-	stringstream comboStringStream;
+	lock_guard<mutex> lock(_mutex);
+
 	_guests.clear();
+	for (int i = 0; i < guestCount && i < GUESTLIST_MAX_GUESTS; i++)
+	{
+		_guests.push_back(Guest(guests[i].name, guests[i].userID, guests[i].id));
+	}
 
-	for (size_t i = 0; i < guestCount; i++)
+	reindex();
+}
+
+bool GuestList::onStateChange(const ParsecGuest& guest)
+{
+	if (guest.state == GUEST_CONNECTED)
 	{
-		_guests.push_back
-		(
-			Guest
-			(
-				guests[i].name,
-				guests[i].userID,
-				guests[i].id
-			)
-		);
-
-		if (i < GUESTLIST_MAX_GUESTS)
-		{
-			guestNames[i] = guests[i].name;
-		}
+		return add(guest);
+	}
+	else if (guest.state == GUEST_DISCONNECTED || guest.state == GUEST_FAILED)
+	{
+		return remove(guest.userID);
 	}
+
+	return false;
 }
 
-vector<Guest>& GuestList::getGuests()
+bool GuestList::add(const ParsecGuest& guest)
 {
-    return _guests;
+	lock_guard<mutex> lock(_mutex);
+
+	if (_indexByUserId.find(guest.userID) != _indexByUserId.end() || _guests.size() >= GUESTLIST_MAX_GUESTS)
+	{
+		return false;
+	}
+
+	const size_t index = _guests.size();
+	_guests.push_back(Guest(guest.name, guest.userID, guest.id));
+	_indexByUserId[guest.userID] = index;
+	snprintf(_names[index], GUEST_NAME_LEN, "%s", guest.name);
+
+	return true;
+}
+
+bool GuestList::remove(uint32_t userID)
+{
+	lock_guard<mutex> lock(_mutex);
+
+	unordered_map<uint32_t, size_t>::iterator it = _indexByUserId.find(userID);
+	if (it == _indexByUserId.end())
+	{
+		return false;
+	}
+
+	// Swap and pop: the last guest takes the freed slot, so only its entry moves.
+	const size_t index = it->second;
+	const size_t last = _guests.size() - 1;
+	_indexByUserId.erase(it);
+	if (index != last)
+	{
+		_guests[index] = std::move(_guests[last]);
+		_indexByUserId[_guests[index].userID] = index;
+		memcpy(_names[index], _names[last], GUEST_NAME_LEN);
+	}
+	_guests.pop_back();
+	_names[last][0] = '\0';
+
+	return true;
+}
+
+vector<Guest> GuestList::getGuests()
+{
+	lock_guard<mutex> lock(_mutex);
+	return _guests;
+}
+
+size_t GuestList::getIds(uint32_t* ids, size_t maxCount)
+{
+	lock_guard<mutex> lock(_mutex);
+
+	size_t count = 0;
+	for (; count < _guests.size() && count < maxCount; count++)
+	{
+		ids[count] = _guests[count].id;
+	}
+
+	return count;
 }
 
 const bool GuestList::find(uint32_t targetGuestID, Guest* result)
 {
-	vector<Guest>::iterator i;
-	for (i = _guests.begin(); i != _guests.end(); ++i)
+	lock_guard<mutex> lock(_mutex);
+
+	unordered_map<uint32_t, size_t>::const_iterator it = _indexByUserId.find(targetGuestID);
+	if (it == _indexByUserId.end())
 	{
-		if ((*i).userID == targetGuestID)
-		{
-			*result = *i;
-			return true;
-		}
+		return false;
 	}
 
-	return false;
+	*result = _guests[it->second];
+	return true;
 }
 
 const bool GuestList::find(const char* targetName, Guest* result)
@@ -61,6 +130,8 @@ const bool GuestList::find(string targetName, Guest* result)
 		return false;
 	}
 
+	lock_guard<mutex> lock(_mutex);
+
 	vector<Guest>::iterator gi;
 	for (gi = _guests.begin(); gi != _guests.end(); ++gi)
 	{
@@ -104,3 +175,24 @@ const bool GuestList::find(string targetName, Guest* result)
 
 	return found;
 }
+
+
+// =============================================================
+//
+//  Private
+//
+// =============================================================
+
+void GuestList::reindex()
+{
+	_indexByUserId.clear();
+	for (size_t i = 0; i < _guests.size(); i++)
+	{
+		_indexByUserId[_guests[i].userID] = i;
+		snprintf(_names[i], GUEST_NAME_LEN, "%s", _guests[i].name.c_str());
+	}
+	for (size_t i = _guests.size(); i < GUESTLIST_MAX_GUESTS; i++)
+	{
+		_names[i][0] = '\0';
+	}
+}
@@ -2,6 +2,10 @@
 
 #include <vector>
 #include <sstream>
+#include <unordered_map>
+#include <mutex>
+#include <cstdio>
+#include <cstring>
 #include "parsec.h"
 #include "Guest.h"
 #include "Stringer.h"
@@ -9,18 +13,41 @@
 using namespace std;
 
 #define GUESTLIST_MAX_GUESTS 64
+#define GUESTLIST_RECONCILE_MS 15000
 
+/**
+ * Guests in the room. The event thread applies each GUEST_STATE_CHANGE with
+ * onStateChange(); guests are indexed by user id, the same id find() takes,
+ * so joins, leaves and lookups are O(1). A leave moves the last guest into
+ * the freed slot, so the order is join order only until someone leaves.
+ * setGuests() replaces the whole roster and is only meant for the slow
+ * reconcile against ParsecHostGetGuests. guestNames points into buffers
+ * owned by the list, so the pointers stay valid even after the SDK frees
+ * its guest array.
+ */
 class GuestList
 {
 public:
+	GuestList();
 	void setGuests(ParsecGuest* guests, int guestCount);
-	vector<Guest> &getGuests();
+	bool onStateChange(const ParsecGuest& guest);
+	bool add(const ParsecGuest& guest);
+	bool remove(uint32_t userID);
+	/** A copy of the roster taken under the lock, safe to walk from any thread. */
+	vector<Guest> getGuests();
+	/** Copies up to maxCount connection ids, in roster order, without touching the heap. */
+	size_t getIds(uint32_t* ids, size_t maxCount);
 	const bool find(uint32_t targetGuestID, Guest *result);
 	const bool find(const char* targetName, Guest* result);
 	const bool find(string targetName, Guest* result);
 
 	const char* guestNames[GUESTLIST_MAX_GUESTS];
 private:
+	void reindex();
+
 	vector<Guest> _guests;
+	unordered_map<uint32_t, size_t> _indexByUserId;
+	char _names[GUESTLIST_MAX_GUESTS][GUEST_NAME_LEN];
+	mutex _mutex;
 };
 
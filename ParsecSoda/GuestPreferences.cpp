@@ -0,0 +1,207 @@
+#include "GuestPreferences.h"
+#include "MetadataCache.h"
+
+const GuestPreferences GuestPreferences::DEFAULT = GuestPreferences();
+
+bool GuestPreferences::isDefault() const
+{
+	return padLimit == DEFAULT.padLimit && mirror == DEFAULT.mirror && ignoreDeviceID == DEFAULT.ignoreDeviceID && transform == nullptr;
+}
+
+shared_ptr<const GuestPreferencesStore::Table> GuestPreferencesStore::getTable() const
+{
+	return atomic_load(&_table);
+}
+
+const GuestPreferences GuestPreferencesStore::get(uint32_t userID) const
+{
+	const shared_ptr<const Table> table = getTable();
+	return find(*table, userID);
+}
+
+void GuestPreferencesStore::edit(uint32_t userID, function<void(GuestPreferences&)> func)
+{
+	lock_guard<mutex> lock(_editMutex);
+
+	shared_ptr<Table> next = make_shared<Table>(*atomic_load(&_table));
+	Table::iterator it = next->find(userID);
+	GuestPreferences prefs = (it != next->end()) ? it->second : GuestPreferences(userID);
+
+	func(prefs);
+	prefs.userID = userID;
+
+	if (prefs.isDefault())
+	{
+		if (it == next->end())
+		{
+			return;
+		}
+		next->erase(it);
+	}
+	else
+	{
+		(*next)[userID] = prefs;
+	}
+
+	atomic_store(&_table, shared_ptr<const Table>(next));
+	_version++;
+}
+
+size_t GuestPreferencesStore::size() const
+{
+	return getTable()->size();
+}
+
+bool GuestPreferencesStore::isDirty() const
+{
+	return _version.load() != _savedVersion.load();
+}
+
+bool GuestPreferencesStore::flush(string path)
+{
+	return isDirty() ? save(path) : true;
+}
+
+bool GuestPreferencesStore::save(string path)
+{
+	const uint64_t version = _version.load();
+	const shared_ptr<const Table> table = getTable();
+
+	if (_persistence == nullptr)
+	{
+		const bool success = write(path, table);
+		if (success)
+		{
+			_savedVersion = version;
+		}
+		return success;
+	}
+
+	// The snapshot is immutable, so the worker can serialize it whenever it gets to it.
+	_persistence->submit(PersistenceWorker::Target::PREFERENCES, [path, table]() {
+		return write(path, table);
+	});
+	_savedVersion = version;
+	return true;
+}
+
+size_t GuestPreferencesStore::load(string path)
+{
+	if (!MTY_FileExists(path.c_str()))
+	{
+		return 0;
+	}
+
+	MTY_JSON* json = MTY_JSONReadFile(path.c_str());
+	if (json == nullptr)
+	{
+		return 0;
+	}
+
+	shared_ptr<Table> next = make_shared<Table>();
+
+	uint32_t size = MTY_JSONGetLength(json);
+	for (uint32_t i = 0; i < size; i++)
+	{
+		const MTY_JSON* item = MTY_JSONArrayGetItem(json, i);
+
+		GuestPreferences prefs;
+		uint32_t padLimit = 1;
+		if (!MTY_JSONObjGetUInt(item, "userID", &prefs.userID))
+		{
+			continue;
+		}
+
+		MTY_JSONObjGetUInt(item, "padLimit", &padLimit);
+		MTY_JSONObjGetBool(item, "mirror", &prefs.mirror);
+		MTY_JSONObjGetBool(item, "ignoreDeviceID", &prefs.ignoreDeviceID);
+		prefs.padLimit = (uint8_t)min(padLimit, (uint32_t)GUEST_PREFERENCES_MAX_PAD_LIMIT);
+
+		InputTransform::Settings settings;
+		uint32_t value = 0;
+		if (MTY_JSONObjGetUInt(item, "deadzone", &value) && value <= (uint32_t)InputTransform::Deadzone::RADIAL)
+			settings.deadzone = (InputTransform::Deadzone)value;
+		if (MTY_JSONObjGetUInt(item, "deadzoneSize", &value) && value <= INT16_MAX)
+			settings.deadzoneSize = (uint16_t)value;
+		if (MTY_JSONObjGetUInt(item, "curve", &value) && value <= (uint32_t)InputTransform::Curve::SHARP)
+			settings.curve = (InputTransform::Curve)value;
+		if (MTY_JSONObjGetUInt(item, "triggerThreshold", &value) && value <= UINT8_MAX)
+			settings.triggerThreshold = (uint8_t)value;
+		if (MTY_JSONObjGetUInt(item, "turboButtons", &value) && value <= UINT16_MAX)
+			settings.turboButtons = (uint16_t)value;
+		if (MTY_JSONObjGetUInt(item, "turboHz", &value) && value > 0 && value <= TRANSFORM_TURBO_HZ_MAX)
+			settings.turboHz = (uint8_t)value;
+		settings.stickToDpad = prefs.mirror;
+
+		if (!settings.isIdentity())
+		{
+			prefs.transform = make_shared<const InputTransform>(settings);
+		}
+
+		if (!prefs.isDefault())
+		{
+			(*next)[prefs.userID] = prefs;
+		}
+	}
+
+	MTY_JSONDestroy(&json);
+
+	lock_guard<mutex> lock(_editMutex);
+	atomic_store(&_table, shared_ptr<const Table>(next));
+	_savedVersion = _version.load();
+
+	return next->size();
+}
+
+const GuestPreferences& GuestPreferencesStore::find(const Table& table, uint32_t userID)
+{
+	Table::const_iterator it = table.find(userID);
+	return (it != table.end()) ? it->second : GuestPreferences::DEFAULT;
+}
+
+void GuestPreferencesStore::setPersistence(PersistenceWorker* persistence)
+{
+	_persistence = persistence;
+}
+
+
+// =============================================================
+//
+//  Private
+//
+// =============================================================
+
+bool GuestPreferencesStore::write(string path, shared_ptr<const Table> table)
+{
+	MTY_JSON* json = MTY_JSONArrayCreate();
+
+	Table::const_iterator it = table->begin();
+	for (; it != table->end(); ++it)
+	{
+		const GuestPreferences& prefs = it->second;
+
+		MTY_JSON* item = MTY_JSONObjCreate();
+		MTY_JSONObjSetUInt(item, "userID", prefs.userID);
+		MTY_JSONObjSetUInt(item, "padLimit", prefs.padLimit);
+		MTY_JSONObjSetBool(item, "mirror", prefs.mirror);
+		MTY_JSONObjSetBool(item, "ignoreDeviceID", prefs.ignoreDeviceID);
+
+		if (prefs.transform != nullptr)
+		{
+			const InputTransform::Settings& settings = prefs.transform->getSettings();
+			MTY_JSONObjSetUInt(item, "deadzone", (uint32_t)settings.deadzone);
+			MTY_JSONObjSetUInt(item, "deadzoneSize", settings.deadzoneSize);
+			MTY_JSONObjSetUInt(item, "curve", (uint32_t)settings.curve);
+			MTY_JSONObjSetUInt(item, "triggerThreshold", settings.triggerThreshold);
+			MTY_JSONObjSetUInt(item, "turboButtons", settings.turboButtons);
+			MTY_JSONObjSetUInt(item, "turboHz", settings.turboHz);
+		}
+
+		MTY_JSONArrayAppendItem(json, item);
+	}
+
+	bool success = MetadataCache::writeJsonAtomic(path, json);
+	MTY_JSONDestroy(&json);
+
+	return success;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+#include "matoya.h"
+#include "InputTransform.h"
+#include "PersistenceWorker.h"
+
+#define GUEST_PREFERENCES_FILENAME "guestprefs.json"
+#define GUEST_PREFERENCES_MAX_PAD_LIMIT 255
+
+using namespace std;
+
+/**
+ * Gamepad settings a guest picked with !limit, !mirror, !one and !transform.
+ */
+class GuestPreferences
+{
+public:
+	GuestPreferences() {}
+	GuestPreferences(uint32_t userID, uint8_t padLimit = 1, bool mirror = false, bool ignoreDeviceID = false)
+		: userID(userID), padLimit(padLimit), mirror(mirror), ignoreDeviceID(ignoreDeviceID)
+	{}
+
+	/** True when nothing differs from DEFAULT, so the store doesn't need to keep it. */
+	bool isDefault() const;
+
+	uint32_t userID = 0;
+	uint8_t padLimit = 1;
+	bool mirror = false;
+	bool ignoreDeviceID = false;
+
+	/** Built from the guest's InputTransform::Settings; null when they are all defaults. */
+	shared_ptr<const InputTransform> transform;
+
+	static const GuestPreferences DEFAULT;
+};
+
+/**
+ * Guest preferences by userID, published as immutable snapshots like GamepadTable.
+ * The input thread takes one snapshot per message and reads the guest's entry
+ * by reference, so it neither locks nor copies. Commands edit through edit(),
+ * which only marks the store dirty; flush() later hands the current snapshot
+ * to the persistence worker, from whoever owns the save cadence. Guests left
+ * on defaults are not stored.
+ */
+class GuestPreferencesStore
+{
+public:
+	typedef unordered_map<uint32_t, GuestPreferences> Table;
+
+	shared_ptr<const Table> getTable() const;
+	const GuestPreferences get(uint32_t userID) const;
+	void edit(uint32_t userID, function<void(GuestPreferences&)> func);
+	size_t size() const;
+
+	bool isDirty() const;
+	bool flush(string path);
+	bool save(string path);
+	size_t load(string path);
+
+	/** Saves go through the worker once set; until then they are written right away. */
+	void setPersistence(PersistenceWorker* persistence);
+
+	/** Entry for userID in table, or GuestPreferences::DEFAULT. */
+	static const GuestPreferences& find(const Table& table, uint32_t userID);
+
+private:
+	static bool write(string path, shared_ptr<const Table> table);
+
+	shared_ptr<const Table> _table = make_shared<const Table>();
+	PersistenceWorker* _persistence = nullptr;
+	mutex _editMutex;
+	atomic<uint64_t> _version { 0 };
+	atomic<uint64_t> _savedVersion { 0 };
+};
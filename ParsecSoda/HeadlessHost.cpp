@@ -0,0 +1,370 @@
+#include "HeadlessHost.h"
+
+atomic<HeadlessHost*> HeadlessHost::_instance { nullptr };
+
+HeadlessHost::HeadlessHost(Hosting& hosting)
+	: _hosting(hosting)
+{}
+
+int HeadlessHost::run()
+{
+	_instance = this;
+	_hasConsole = attachConsole();
+	if (_hasConsole)
+	{
+		SetConsoleCtrlHandler(onConsoleCtrl, TRUE);
+	}
+
+	_hosting.init();
+	if (!_hosting.isReady())
+	{
+		cout << "[Headless] | Parsec SDK failed to load." << endl;
+		_hosting.release();
+		return 1;
+	}
+
+	if (!_hosting.getSession().isValid())
+	{
+		cout << "[Headless] | No cached session. Log in once with the window to create one." << endl;
+		_hosting.release();
+		return 1;
+	}
+
+	_isRunning = true;
+	_hosting.startHosting();
+	cout << "[Headless] | Hosting \"" << _hosting.getHostConfig().name << "\". Commands on " << HEADLESS_PIPE_NAME << endl;
+
+	_pipeThread = thread([this]() { servePipe(); });
+	if (_hasConsole)
+	{
+		// getline can't be interrupted; the process exits right after run() anyway.
+		_consoleThread = thread([this]() { serveConsole(); });
+		_consoleThread.detach();
+	}
+
+	while (_isRunning)
+	{
+		Sleep(HEADLESS_POLL_MS);
+	}
+
+	stopPipe();
+	_hosting.release();
+	MetadataCache::savePreferences();
+
+	cout << "[Headless] | Stopped." << endl;
+	_instance = nullptr;
+	return 0;
+}
+
+bool HeadlessHost::isRequested(const char* cmdLine)
+{
+	return cmdLine != nullptr && strstr(cmdLine, HEADLESS_ARG) != nullptr;
+}
+
+bool HeadlessHost::isSendRequested(const char* cmdLine, string& line)
+{
+	const char* arg = (cmdLine != nullptr) ? strstr(cmdLine, HEADLESS_SEND_ARG) : nullptr;
+	if (arg == nullptr)
+	{
+		return false;
+	}
+
+	line = Stringer::trim(string(arg + strlen(HEADLESS_SEND_ARG)));
+	if (line.size() >= 2 && line.front() == '"' && line.back() == '"')
+	{
+		line = line.substr(1, line.size() - 2);
+	}
+
+	return !line.empty();
+}
+
+int HeadlessHost::send(const string line)
+{
+	attachConsole();
+
+	if (!WaitNamedPipeA(HEADLESS_PIPE_NAME, HEADLESS_PIPE_TIMEOUT_MS))
+	{
+		cout << "[Headless] | No headless host is running." << endl;
+		return 1;
+	}
+
+	HANDLE pipe = CreateFileA(HEADLESS_PIPE_NAME, GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_EXISTING, 0, NULL);
+	if (pipe == INVALID_HANDLE_VALUE)
+	{
+		cout << "[Headless] | Could not connect to " << HEADLESS_PIPE_NAME << endl;
+		return 1;
+	}
+
+	const string request = line + "\n";
+	DWORD written = 0;
+	WriteFile(pipe, request.c_str(), (DWORD)request.size(), &written, NULL);
+
+	string reply;
+	char buffer[HEADLESS_PIPE_BUFFER];
+	DWORD read = 0;
+	while (reply.find('\0') == string::npos && ReadFile(pipe, buffer, sizeof(buffer), &read, NULL) && read > 0)
+	{
+		reply.append(buffer, read);
+	}
+	CloseHandle(pipe);
+
+	size_t end = reply.find('\0');
+	cout << reply.substr(0, end) << endl;
+	return (end == string::npos) ? 1 : 0;
+}
+
+
+// =============================================================
+//
+//  Private
+//
+// =============================================================
+
+const string HeadlessHost::execute(string line)
+{
+	line = Stringer::trim(line);
+	if (line.empty())
+	{
+		return "";
+	}
+
+	lock_guard<mutex> lock(_executeMutex);
+
+	if (line == "quit" || line == "exit")
+	{
+		_isRunning = false;
+		return "[Headless] | Shutting down.";
+	}
+
+	if (line == "start")
+	{
+		if (_hosting.isRunning())
+		{
+			return "[Headless] | Already hosting.";
+		}
+		_hosting.startHosting();
+		return "[Headless] | Hosting started.";
+	}
+
+	if (line == "stop")
+	{
+		_hosting.stopHosting();
+		return "[Headless] | Hosting stopped.";
+	}
+
+	if (line == "status")
+	{
+		return status();
+	}
+
+	if (line == "tail" || line.rfind("tail ", 0) == 0)
+	{
+		const unsigned long count = (line.size() > 5) ? strtoul(line.c_str() + 5, nullptr, 10) : 0;
+		return sessionLines(SessionLogReader::tail(
+			MetadataCache::getSessionLogDir(), (count > 0) ? count : HEADLESS_TAIL_DEFAULT
+		));
+	}
+
+	if (line.rfind("find ", 0) == 0)
+	{
+		return sessionLines(SessionLogReader::search(
+			MetadataCache::getSessionLogDir(), SessionLogReader::parseQuery(line.substr(5)), HEADLESS_TAIL_DEFAULT
+		));
+	}
+
+	if (line == "help")
+	{
+		return string("[Headless] | Control:")
+			+ "\n  " + "start\t\t|\tStart hosting."
+			+ "\n  " + "stop\t\t|\tStop hosting."
+			+ "\n  " + "status\t|\tRoom, guests, gamepads, chat queue and disk writes."
+			+ "\n  " + "tail [n]\t|\tLast n session log records."
+			+ "\n  " + "find <query>\t|\tSearch the session logs: [#userID] [<N>m|<N>h] [to <N>m|<N>h] [text]."
+			+ "\n  " + "quit\t\t|\tStop hosting and exit."
+			+ "\n  " + "!<command>\t|\tRun a chat command as the host (!help lists them)."
+			+ "\n  " + "<text>\t\t|\tSay something in chat.";
+	}
+
+	string reply = _hosting.sendHostMessage(line.c_str());
+	reply.erase(remove(reply.begin(), reply.end(), '\0'), reply.end());
+	return reply.empty() ? "[Headless] | No reply." : reply;
+}
+
+const string HeadlessHost::status()
+{
+	ParsecHostConfig& config = _hosting.getHostConfig();
+	const shared_ptr<const GamepadTable> table = _hosting.getGamepads();
+
+	std::ostringstream reply;
+	reply << "[Headless] | " << (_hosting.isRunning() ? "Hosting" : "Not hosting")
+		<< "\n  Room:\t\t" << config.name
+		<< "\n  Public:\t" << (config.publicGame ? "yes" : "no")
+		<< "\n  Guests:\t" << _hosting.getGuestList().size() << "/" << config.maxGuests;
+
+	for (size_t i = 0; i < table->size(); i++)
+	{
+		const GamepadTable::Slot& slot = table->slots[i];
+		reply << "\n  Pad " << (i + 1) << ":\t";
+		if (!slot.pad->isConnected())	reply << "(disconnected)";
+		else if (slot.isOwned())		reply << slot.owner.guest.name;
+		else							reply << "(free)";
+	}
+
+	const GamepadClient::BringUpReport bringUp = _hosting.getGamepadClient().getBringUpReport();
+	reply << "\n  Bring-up:\t" << (int)bringUp.totalMs << " ms";
+	if (bringUp.failedCount > 0) reply << " (" << bringUp.failedCount << " failed)";
+	for (size_t i = 0; i < bringUp.padMs.size(); i++)
+	{
+		reply << (i == 0 ? " |" : ",") << " " << (i + 1) << ": " << (int)bringUp.padMs[i] << " ms";
+	}
+
+	reply << "\n" << _hosting.chatReport();
+	reply << "\n" << _hosting.persistenceReport();
+	reply << "\n" << _hosting.sessionLogReport();
+	return reply.str();
+}
+
+const string HeadlessHost::sessionLines(const vector<SessionLogReader::Entry>& entries)
+{
+	if (entries.empty())
+	{
+		return "[Headless] | No session log records found.";
+	}
+
+	std::ostringstream reply;
+	reply << "[Headless] | " << entries.size() << " records:";
+	for (const SessionLogReader::Entry& entry : entries)
+	{
+		reply << "\n  " << entry.toString();
+	}
+	return reply.str();
+}
+
+void HeadlessHost::servePipe()
+{
+	_isPipeServing = true;
+
+	while (_isRunning)
+	{
+		HANDLE pipe = CreateNamedPipeA(
+			HEADLESS_PIPE_NAME,
+			PIPE_ACCESS_DUPLEX,
+			PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+			1, HEADLESS_PIPE_BUFFER, HEADLESS_PIPE_BUFFER, 0, NULL
+		);
+		if (pipe == INVALID_HANDLE_VALUE)
+		{
+			Sleep(HEADLESS_PIPE_TIMEOUT_MS);
+			continue;
+		}
+
+		bool isConnected = ConnectNamedPipe(pipe, NULL) || GetLastError() == ERROR_PIPE_CONNECTED;
+		if (isConnected && _isRunning)
+		{
+			string pending;
+			char buffer[HEADLESS_PIPE_BUFFER];
+			DWORD read = 0;
+			while (_isRunning && ReadFile(pipe, buffer, sizeof(buffer), &read, NULL) && read > 0)
+			{
+				pending.append(buffer, read);
+
+				size_t end = pending.find('\n');
+				while (end != string::npos)
+				{
+					string reply = execute(pending.substr(0, end));
+					reply.push_back('\0');
+					pending.erase(0, end + 1);
+
+					DWORD written = 0;
+					WriteFile(pipe, reply.c_str(), (DWORD)reply.size(), &written, NULL);
+					end = pending.find('\n');
+				}
+			}
+			FlushFileBuffers(pipe);
+		}
+
+		DisconnectNamedPipe(pipe);
+		CloseHandle(pipe);
+	}
+
+	_isPipeServing = false;
+}
+
+void HeadlessHost::serveConsole()
+{
+	string line;
+	while (_isRunning && getline(cin, line))
+	{
+		if (!_isRunning)
+		{
+			break;
+		}
+
+		const string reply = execute(line);
+		if (!reply.empty())
+		{
+			cout << reply << endl;
+		}
+	}
+}
+
+void HeadlessHost::stopPipe()
+{
+	if (!_pipeThread.joinable())
+	{
+		return;
+	}
+
+	// The pipe thread blocks in ConnectNamedPipe or ReadFile: cancel the read,
+	// and connect once ourselves so a pending accept returns too.
+	while (_isPipeServing)
+	{
+		CancelSynchronousIo(_pipeThread.native_handle());
+
+		HANDLE self = CreateFileA(HEADLESS_PIPE_NAME, GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_EXISTING, 0, NULL);
+		if (self != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(self);
+		}
+
+		Sleep(HEADLESS_POLL_MS);
+	}
+
+	_pipeThread.join();
+}
+
+bool HeadlessHost::attachConsole()
+{
+	// The app is built for the Windows subsystem, so it has no console unless it borrows the parent's.
+	if (!AttachConsole(ATTACH_PARENT_PROCESS))
+	{
+		return false;
+	}
+
+	FILE* stream = nullptr;
+	freopen_s(&stream, "CONOUT$", "w", stdout);
+	freopen_s(&stream, "CONIN$", "r", stdin);
+	return true;
+}
+
+BOOL WINAPI HeadlessHost::onConsoleCtrl(DWORD ctrlType)
+{
+	HeadlessHost* host = _instance;
+	if (host == nullptr)
+	{
+		return FALSE;
+	}
+
+	host->_isRunning = false;
+
+	// Closing the console kills the process once this returns; give run() time to release.
+	if (ctrlType == CTRL_CLOSE_EVENT)
+	{
+		while (_instance != nullptr)
+		{
+			Sleep(HEADLESS_POLL_MS);
+		}
+	}
+
+	return TRUE;
+}
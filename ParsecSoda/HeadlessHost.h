@@ -0,0 +1,67 @@
+#pragma once
+
+#include <Windows.h>
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include "Hosting.h"
+#include "SessionLogReader.h"
+
+#define HEADLESS_ARG "--headless"
+#define HEADLESS_SEND_ARG "--send"
+#define HEADLESS_PIPE_NAME "\\\\.\\pipe\\ParsecSoda"
+#define HEADLESS_PIPE_BUFFER 4096
+#define HEADLESS_PIPE_TIMEOUT_MS 2000
+#define HEADLESS_POLL_MS 100
+#define HEADLESS_TAIL_DEFAULT 20
+
+using namespace std;
+
+/**
+ * Runs Hosting without the window: no swap chain, no ImGui frames, no vsync.
+ * Started with --headless, it loads preferences and the cached session, starts
+ * hosting right away and then takes one command per line from a local named
+ * pipe (and from the console, if it was launched from one). Lines starting
+ * with ! go through the ChatBot as the host, so !kick, !name, !guests and the
+ * rest work as they do in chat; anything else is said in chat. A few control
+ * words are handled here: start, stop, status, bench, tail, find, help and
+ * quit. tail and find read the session logs (see SessionLogReader).
+ * Every reply goes back to the pipe client terminated by a single '\0'.
+ *
+ * ParsecSoda.exe --send "<line>" is the matching client: it hands one line
+ * to a running headless host, prints the reply and exits.
+ */
+class HeadlessHost
+{
+public:
+	HeadlessHost(Hosting& hosting);
+	int run();
+
+	static bool isRequested(const char* cmdLine);
+	static bool isSendRequested(const char* cmdLine, string& line);
+	static int send(const string line);
+
+private:
+	const string execute(string line);
+	const string status();
+	const string sessionLines(const vector<SessionLogReader::Entry>& entries);
+	void servePipe();
+	void serveConsole();
+	void stopPipe();
+
+	static bool attachConsole();
+	static BOOL WINAPI onConsoleCtrl(DWORD ctrlType);
+	static atomic<HeadlessHost*> _instance;
+
+	Hosting& _hosting;
+	atomic<bool> _isRunning { false };
+	atomic<bool> _isPipeServing { false };
+	mutex _executeMutex;
+	bool _hasConsole = false;
+	thread _pipeThread;
+	thread _consoleThread;
+};
@@ -50,15 +50,12 @@ void Hosting::applyHostConfig()
 	}
 }
 
-void Hosting::broadcastChatMessage(string message)
+void Hosting::broadcastChatMessage(const string& message, bool isSystem)
 {
-	vector<Guest> guests = _guestList.getGuests();
-	vector<Guest>::iterator gi;
+	uint32_t ids[GUESTLIST_MAX_GUESTS];
+	const size_t count = _guestList.getIds(ids, GUESTLIST_MAX_GUESTS);
 
-	for (gi = guests.begin(); gi != guests.end(); ++gi)
-	{
-		ParsecHostSendUserData(_parsec, (*gi).id, HOSTING_CHAT_MSG_ID, message.c_str());
-	}
+	_chatOutbox.enqueue(ids, count, message, isSystem);
 }
 
 void Hosting::init()
@@ -67,11 +64,8 @@ void Hosting::init()
 	_dx11.init();
 	_gamepadClient.setParsec(_parsec);
 	_gamepadClient.init();
-
-	_createGamepadsThread = thread([&]() {
-		_gamepadClient.createMaximumGamepads();
-		_createGamepadsThread.detach();
-	});
+	_chatOutbox.start(_parsec, HOSTING_CHAT_MSG_ID);
+	_gamepadClient.createMaximumGamepads();
 	
 	MetadataCache::Preferences preferences = MetadataCache::loadPreferences();
 
@@ -103,11 +97,16 @@ void Hosting::init()
 		_parsecSession.fetchAccountData(&_host);
 	}
 
+	_persistence.start();
+	_banList.setPersistence(&_persistence);
+	_tierList.setPersistence(&_persistence);
+	_gamepadClient.setPersistence(&_persistence);
+
 	_chatBot = new ChatBot(
 		audioIn, audioOut, _banList, _dice, _dx11,
 		_gamepadClient, _guestList, _guestHistory, _parsec,
 		_hostConfig, _parsecSession, _sfxList, _tierList,
-		_isRunning, _host
+		_isRunning, _host, _mouseRouter
 	);
 }
 
@@ -120,6 +119,9 @@ void Hosting::release()
 	}
 	_dx11.clear();
 	_gamepadClient.release();
+	_chatOutbox.stop();
+	_sessionLog.stop();
+	_persistence.stop();
 }
 
 bool Hosting::isReady()
@@ -152,17 +154,17 @@ ParsecHostConfig& Hosting::getHostConfig()
 	return _hostConfig;
 }
 
-vector<string>& Hosting::getMessageLog()
+LogRing& Hosting::getMessageLog()
 {
 	return _chatLog.getMessageLog();
 }
 
-vector<string>& Hosting::getCommandLog()
+LogRing& Hosting::getCommandLog()
 {
 	return _chatLog.getCommandLog();
 }
 
-vector<Guest>& Hosting::getGuestList()
+vector<Guest> Hosting::getGuestList()
 {
 	return _guestList.getGuests();
 }
@@ -177,9 +179,9 @@ BanList& Hosting::getBanList()
 	return _banList;
 }
 
-vector<Gamepad>& Hosting::getGamepads()
+shared_ptr<const GamepadTable> Hosting::getGamepads()
 {
-	return _gamepadClient.gamepads;
+	return _gamepadClient.getTable();
 }
 
 GamepadClient& Hosting::getGamepadClient()
@@ -257,6 +259,14 @@ void Hosting::startHosting()
 	{
 		_isRunning = true;
 		initAllModules();
+		_lastGuestReconcileMs = 0;
+		_sessionLog.start(MetadataCache::getSessionLogDir());
+
+		// Restored guests keep their spot for a while so they have time to reconnect.
+		_gamepadClient.getPadQueue().load(MetadataCache::getUserDir() + PAD_QUEUE_FILENAME);
+		_queueRestoredMs = (uint64_t)chrono::duration_cast<chrono::milliseconds>(
+			chrono::steady_clock::now().time_since_epoch()
+		).count();
 
 		try
 		{
@@ -285,22 +295,105 @@ void Hosting::stripGamepad(int index)
 	_gamepadClient.clearOwner(index);
 }
 
-void Hosting::setOwner(Gamepad& gamepad, Guest newOwner, int padId)
+void Hosting::setOwner(int gamepadIndex, Guest newOwner, int padId)
 {
-	bool found = _gamepadClient.findPreferences(newOwner.userID, [&](GamepadClient::GuestPreferences& prefs) {
-		gamepad.setOwner(newOwner, padId, prefs.mirror);
-	});
+	_gamepadClient.setOwner(gamepadIndex, newOwner, padId);
+}
 
-	if (!found)
+bool Hosting::toggleInputRecording()
+{
+	if (_inputRecorder.isRecording())
 	{
-		gamepad.setOwner(newOwner, padId, false);
+		_inputRecorder.stop();
+		_chatLog.logCommand(string("[Replay] | Recorded ") + to_string(_inputRecorder.recordedCount()) + " input messages.");
+		return false;
 	}
+
+	return _inputRecorder.start(MetadataCache::getUserDir() + INPUT_TRACE_FILENAME);
+}
+
+bool Hosting::isRecordingInputs()
+{
+	return _inputRecorder.isRecording();
 }
 
-void Hosting::handleMessage(const char* message, Guest& guest, bool isHost)
+bool Hosting::replayInputs(bool realtime)
+{
+	if (!_isRunning || _inputRecorder.isRecording() || _isReplaying.exchange(true))
+	{
+		return false;
+	}
+
+	// Picked up by the input thread, the only thread that feeds the pads.
+	_isReplayRealtime = realtime;
+	_isReplayRequested = true;
+
+	return true;
+}
+
+bool Hosting::isReplayingInputs()
+{
+	return _isReplaying;
+}
+
+bool Hosting::toggleInputLatency()
+{
+	if (InputLatency::isEnabled())
+	{
+		_inputLatency.setEnabled(false);
+
+		const string path = MetadataCache::getUserDir() + INPUT_LATENCY_FILENAME;
+		if (_inputLatency.dump(path))
+		{
+			_chatLog.logCommand(string("[Latency] | Input latency written to ") + path);
+		}
+		return false;
+	}
+
+	_inputLatency.clear();
+	return _inputLatency.setEnabled(true);
+}
+
+bool Hosting::isMeasuringInputLatency()
+{
+	return InputLatency::isEnabled();
+}
+
+const InputLatency::Summary Hosting::getInputLatency(uint32_t userID)
+{
+	return _inputLatency.getSummary(userID);
+}
+
+const string Hosting::persistenceReport()
+{
+	return _persistence.report();
+}
+
+const string Hosting::chatReport()
+{
+	return _chatOutbox.report();
+}
+
+const string Hosting::sessionLogReport()
+{
+	return _sessionLog.report();
+}
+
+void Hosting::handleMessage(const char* message, Guest& guest, bool isHost, string* reply)
 {
 	ACommand* command = _chatBot->identifyUserDataMessage(message, guest, isHost);
-	command->run();
+	_sessionLog.record(
+		command->type() == COMMAND_TYPE::DEFAULT_MESSAGE ? SessionLogFormat::Kind::CHAT
+			: command->type() == COMMAND_TYPE::IP ? SessionLogFormat::Kind::MODERATION
+			: SessionLogFormat::Kind::COMMAND,
+		guest.userID, guest.name.c_str(), message
+	);
+
+	// Plain chat is formatted below with the right tier; running it here too would only format it twice.
+	if (command->type() != COMMAND_TYPE::DEFAULT_MESSAGE)
+	{
+		command->run();
+	}
 
 	// Non-blocked default message
 	if (!isFilteredCommand(command))
@@ -311,30 +404,35 @@ void Hosting::handleMessage(const char* message, Guest& guest, bool isHost)
 		defaultMessage.run();
 		_chatBot->setLastUserId(guest.userID);
 
-		if (!defaultMessage.replyMessage().empty())
+		const string& text = defaultMessage.replyMessage();
+		if (!text.empty())
 		{
-			_chatLog.logMessage(defaultMessage.replyMessage());
-			broadcastChatMessage(defaultMessage.replyMessage());
-			cout << endl << defaultMessage.replyMessage();
+			_chatLog.logMessage(text);
+			broadcastChatMessage(text, false);
+			cout << endl << text;
+			if (reply != nullptr) *reply = text;
 		}
 	}
 
 	// Chatbot's command reply
-	if (!command->replyMessage().empty() && command->type() != COMMAND_TYPE::DEFAULT_MESSAGE)
+	if (command->type() != COMMAND_TYPE::DEFAULT_MESSAGE && !command->replyMessage().empty())
 	{
-		_chatLog.logCommand(command->replyMessage());
-		broadcastChatMessage(command->replyMessage());
-		cout << endl << command->replyMessage();
+		const string& text = command->replyMessage();
+		_chatLog.logCommand(text);
+		broadcastChatMessage(text);
+		cout << endl << text;
 		_chatBot->setLastUserId();
+		if (reply != nullptr) *reply = text;
 	}
 
-	delete command;
+	CommandArena::release(command);
 }
 
-void Hosting::sendHostMessage(const char* message)
+const string Hosting::sendHostMessage(const char* message)
 {
-	static bool isAdmin = true;
-	handleMessage(message, _host, true);
+	string reply;
+	handleMessage(message, _host, true, &reply);
+	return reply;
 }
 
 
@@ -408,6 +506,7 @@ void Hosting::mainLoopControl()
 	_eventMutex.lock();
 
 	ParsecHostStop(_parsec);
+	_inputRecorder.stop();
 	_gamepadClient.disconnectAllGamepads();
 	_isRunning = false;
 
@@ -425,30 +524,29 @@ void Hosting::pollEvents()
 
 	string chatBotReply;
 
-	ParsecGuest* guests = nullptr;
-	int guestCount = 0;
-
 	ParsecHostEvent event;
 
+	_chatLimiter.reset();
+	reconcileGuests();
+
 	while (_isRunning)
 	{
 		if (ParsecHostPollEvents(_parsec, 30, &event)) {
 			ParsecGuest parsecGuest = event.guestStateChange.guest;
 			ParsecGuestState state = parsecGuest.state;
 			Guest guest = Guest(parsecGuest.name, parsecGuest.userID, parsecGuest.id);
-			guestCount = ParsecHostGetGuests(_parsec, GUEST_CONNECTED, &guests);
-			_guestList.setGuests(guests, guestCount);
 
 			switch (event.type)
 			{
 			case HOST_EVENT_GUEST_STATE_CHANGE:
+				_guestList.onStateChange(parsecGuest);
 				onGuestStateChange(state, guest);
 				break;
 
 			case HOST_EVENT_USER_DATA:
 				char* msg = (char*)ParsecGetBuffer(_parsec, event.userData.key);
 
-				if (event.userData.id == PARSEC_APP_CHAT_MSG)
+				if (event.userData.id == PARSEC_APP_CHAT_MSG && isChatAllowed(msg, guest))
 				{
 					handleMessage(msg, guest);
 				}
@@ -457,9 +555,21 @@ void Hosting::pollEvents()
 				break;
 			}
 		}
+
+		reconcileGuests();
+		// The replay owns the pads until it puts the guests back.
+		if (!_isReplaying)
+		{
+			reclaimIdlePads();
+			serviceQueue();
+		}
+		flushPreferences();
 	}
 
-	ParsecFree(_parsec, guests);
+	_gamepadClient.getPadQueue().save(MetadataCache::getUserDir() + PAD_QUEUE_FILENAME);
+	_gamepadClient.flushPreferences();
+	_sessionLog.stop();
+
 	_isEventThreadRunning = false;
 	_eventMutex.unlock();
 	_eventThread.detach();
@@ -472,23 +582,331 @@ void Hosting::pollInputs()
 
 	ParsecGuest inputGuest;
 	ParsecMessage inputGuestMsg;
+	ParsecGuest floodGuest;
+
+	_inputLimiter.reset();
 
 	while (_isRunning)
 	{
-		if (ParsecHostPollInput(_parsec, 4, &inputGuest, &inputGuestMsg))
+		if (_isReplayRequested.exchange(false))
 		{
+			beginReplay();
+		}
+
+		// A realtime replay is paced by this loop, so it cannot block for long.
+		const bool hasInput = ParsecHostPollInput(_parsec, _inputReplayer.isActive() ? 1 : 4, &inputGuest, &inputGuestMsg);
+
+		// Stamped after the poll returns: this is also the "received" time for latency.
+		const uint64_t nowUs = InputLatency::now();
+
+		if (hasInput)
+		{
+			_inputRecorder.record(inputGuest, inputGuestMsg);
+
+			if (!_gamepadClient.lock && _inputLimiter.check(inputGuest, inputGuestMsg, nowUs) == InputRateLimiter::Verdict::PASS)
+			{
+				if (!_mouseRouter.route(inputGuest.userID, inputGuestMsg))
+				{
+					sendInput(inputGuest, inputGuestMsg, nowUs);
+				}
+			}
+		}
+
+		_mouseRouter.flush();
+
+		_inputLimiter.flush(nowUs, [this](ParsecGuest& guest, ParsecMessage& message, uint64_t receivedUs) {
 			if (!_gamepadClient.lock)
 			{
-				_gamepadClient.sendMessage(inputGuest, inputGuestMsg);
+				sendInput(guest, message, receivedUs);
 			}
+		});
+
+		while (_inputLimiter.popFlagged(floodGuest))
+		{
+			onInputFlood(floodGuest);
 		}
+
+		if (_inputReplayer.isActive() && _inputReplayer.step(_gamepadClient))
+		{
+			endReplay();
+		}
+
+		_gamepadClient.tickTurbo();
+	}
+
+	if (_inputReplayer.isActive())
+	{
+		endReplay();
 	}
+	_isReplayRequested = false;
+	_isReplaying = false;
 
 	_isInputThreadRunning = false;
 	_inputMutex.unlock();
 	_inputThread.detach();
 }
 
+void Hosting::beginReplay()
+{
+	if (!_inputReplayer.start(MetadataCache::getUserDir() + INPUT_TRACE_FILENAME, _isReplayRealtime))
+	{
+		_chatLog.logCommand(InputReplayer::Report().toString());
+		_isReplaying = false;
+		return;
+	}
+
+	// Guests are locked out while the trace drives the pads; owners are put back afterwards.
+	_wasLockedBeforeReplay = _gamepadClient.lock;
+	_gamepadClient.lock = true;
+
+	_replayOwners.clear();
+	_gamepadClient.edit([this](GamepadTable::Slots& slots) {
+		GamepadTable::Slots::iterator si = slots.begin();
+		for (; si != slots.end(); ++si)
+		{
+			_replayOwners.push_back(make_pair((*si).pad, (*si).owner));
+			(*si).owner = GuestDevice();
+		}
+	});
+}
+
+void Hosting::endReplay()
+{
+	const InputReplayer::Report report = _inputReplayer.finish(_gamepadClient);
+
+	// Pads are matched by identity and owners by user id, so edits made during the
+	// replay (sorting, !ff, drag and drop) survive and guests who left stay out.
+	_gamepadClient.edit([this](GamepadTable::Slots& slots) {
+		GamepadTable::Slots::iterator si = slots.begin();
+		for (; si != slots.end(); ++si)
+		{
+			if ((*si).isOwned() && _inputReplayer.isTraceGuest((*si).owner.guest.userID))
+			{
+				(*si).owner = GuestDevice();
+			}
+		}
+
+		Guest guest;
+		vector<pair<shared_ptr<Gamepad>, GuestDevice>>::iterator oi = _replayOwners.begin();
+		for (; oi != _replayOwners.end(); ++oi)
+		{
+			if (!(*oi).second.guest.isValid() || !_guestList.find((*oi).second.guest.userID, &guest))
+			{
+				continue;
+			}
+
+			for (si = slots.begin(); si != slots.end(); ++si)
+			{
+				if ((*si).pad == (*oi).first && !(*si).isOwned())
+				{
+					(*si).owner = (*oi).second;
+					break;
+				}
+			}
+		}
+	});
+	_replayOwners.clear();
+
+	_gamepadClient.lock = _wasLockedBeforeReplay;
+	_chatLog.logCommand(report.toString());
+	cout << endl << report.toString();
+	_isReplaying = false;
+}
+
+void Hosting::sendInput(ParsecGuest& guest, ParsecMessage& message, uint64_t receivedUs)
+{
+	if (!InputLatency::isEnabled())
+	{
+		_gamepadClient.sendMessage(guest, message);
+		return;
+	}
+
+	const uint64_t dispatchedUs = InputLatency::now();
+	InputLatency::beginApply();
+	_gamepadClient.sendMessage(guest, message);
+
+	// Only messages that reached a driver update are counted.
+	const uint64_t appliedUs = InputLatency::takeApplied();
+	if (appliedUs != 0)
+	{
+		_inputLatency.record(guest.userID, guest.name, message, receivedUs, dispatchedUs, appliedUs);
+	}
+}
+
+void Hosting::onInputFlood(ParsecGuest& guest)
+{
+	const bool isKicked = MetadataCache::preferences.kickInputFlood && _tierList.getTier(guest.userID) < Tier::ADMIN;
+
+	string& reply = CommandReply::buffer<Hosting>();
+	reply.clear();
+	CommandReply::append(reply, "[ChatBot] | ", guest.name, " \t(#", guest.userID, ") is flooding inputs", (isKicked ? " and was kicked." : "."));
+	_chatLog.logCommand(reply);
+	_sessionLog.record(SessionLogFormat::Kind::MODERATION, guest.userID, guest.name, reply.c_str());
+	cout << endl << reply;
+
+	if (isKicked)
+	{
+		ParsecHostKickGuest(_parsec, guest.id);
+	}
+}
+
+bool Hosting::isChatAllowed(const char* message, Guest& guest)
+{
+	const ChatRateLimiter::Action action = _chatLimiter.check(guest.userID, _tierList.getTier(guest.userID), message, ChatRateLimiter::now());
+	if (action == ChatRateLimiter::Action::PASS || action == ChatRateLimiter::Action::DROP)
+	{
+		return action == ChatRateLimiter::Action::PASS;
+	}
+
+	string& reply = CommandReply::buffer<Hosting>();
+	reply.clear();
+	if (action == ChatRateLimiter::Action::WARN)
+	{
+		// Only the spammer needs to read this one.
+		CommandReply::append(reply, "[ChatBot] | ", guest.name, ", slow down. Your messages are being dropped.");
+		_chatOutbox.enqueue(&guest.id, 1, reply);
+		_sessionLog.record(SessionLogFormat::Kind::MODERATION, guest.userID, guest.name.c_str(), reply.c_str());
+		return false;
+	}
+
+	if (action == ChatRateLimiter::Action::MUTE)
+	{
+		CommandReply::append(reply, "[ChatBot] | ", guest.name, " \t(#", guest.userID, ") is muted for ",
+			_chatLimiter.getPolicy(_tierList.getTier(guest.userID)).muteSeconds, " seconds for spamming.");
+	}
+	else
+	{
+		ParsecHostKickGuest(_parsec, guest.id);
+		CommandReply::append(reply, "[ChatBot] | ", guest.name, " \t(#", guest.userID, ") was kicked for spamming.");
+	}
+
+	broadcastChatMessage(reply);
+	_chatLog.logCommand(reply);
+	_sessionLog.record(SessionLogFormat::Kind::MODERATION, guest.userID, guest.name.c_str(), reply.c_str());
+	cout << endl << reply;
+	return false;
+}
+
+void Hosting::reclaimIdlePads()
+{
+	const uint64_t nowMs = (uint64_t)chrono::duration_cast<chrono::milliseconds>(
+		chrono::steady_clock::now().time_since_epoch()
+	).count();
+
+	if (MetadataCache::preferences.idleReclaimSeconds == 0 || nowMs - _lastIdleCheckMs < IDLE_CHECK_INTERVAL_MS)
+	{
+		return;
+	}
+	_lastIdleCheckMs = nowMs;
+
+	const Tier exemptTier = (Tier)MetadataCache::preferences.idleExemptTier;
+	vector<GamepadClient::IdleReclaim> reclaimed = _gamepadClient.reclaimIdle(
+		(uint64_t)MetadataCache::preferences.idleReclaimSeconds * 1000,
+		[&](const GuestDevice& owner) {
+			return _tierList.getTier(owner.guest.userID) >= exemptTier;
+		}
+	);
+
+	vector<GamepadClient::IdleReclaim>::iterator ri = reclaimed.begin();
+	for (; ri != reclaimed.end(); ++ri)
+	{
+		const string& reply = CommandReply::format(
+			"[ChatBot] | ", (*ri).owner.guest.name, " was idle for ", ((*ri).idleMs / 1000),
+			" seconds. Gamepad ", ((*ri).index + 1), " is free."
+		);
+		broadcastChatMessage(reply);
+		_chatLog.logCommand(reply);
+	}
+}
+
+void Hosting::reconcileGuests()
+{
+	const uint64_t nowMs = (uint64_t)chrono::duration_cast<chrono::milliseconds>(
+		chrono::steady_clock::now().time_since_epoch()
+	).count();
+
+	// State changes keep the roster current; the full fetch only catches missed events.
+	if (_lastGuestReconcileMs > 0 && nowMs - _lastGuestReconcileMs < GUESTLIST_RECONCILE_MS)
+	{
+		return;
+	}
+	_lastGuestReconcileMs = nowMs;
+
+	ParsecGuest* guests = nullptr;
+	int guestCount = ParsecHostGetGuests(_parsec, GUEST_CONNECTED, &guests);
+	_guestList.setGuests(guests, guestCount);
+	if (guests != nullptr)
+	{
+		ParsecFree(_parsec, guests);
+	}
+}
+
+void Hosting::flushPreferences()
+{
+	const uint64_t nowMs = (uint64_t)chrono::duration_cast<chrono::milliseconds>(
+		chrono::steady_clock::now().time_since_epoch()
+	).count();
+
+	// Commands only mark preferences dirty; a burst of !transform edits costs one write.
+	if (nowMs - _lastPreferencesFlushMs < PREFERENCES_FLUSH_INTERVAL_MS)
+	{
+		return;
+	}
+	_lastPreferencesFlushMs = nowMs;
+
+	_gamepadClient.flushPreferences();
+}
+
+void Hosting::serviceQueue()
+{
+	PadQueue& queue = _gamepadClient.getPadQueue();
+
+	if (_queueRestoredMs > 0)
+	{
+		const uint64_t nowMs = (uint64_t)chrono::duration_cast<chrono::milliseconds>(
+			chrono::steady_clock::now().time_since_epoch()
+		).count();
+
+		if (nowMs - _queueRestoredMs >= PAD_QUEUE_RESTORE_GRACE_MS)
+		{
+			_queueRestoredMs = 0;
+			queue.prune([this](const PadQueue::Entry& entry) {
+				Guest guest;
+				return _guestList.find(entry.userID, &guest);
+			});
+		}
+	}
+
+	vector<GamepadClient::Handoff> handoffs = _gamepadClient.serviceQueue(_guestList);
+	vector<GamepadClient::Handoff>::iterator hi = handoffs.begin();
+	for (; hi != handoffs.end(); ++hi)
+	{
+		string& reply = CommandReply::buffer<Hosting>();
+		reply.clear();
+		CommandReply::append(reply, "[ChatBot] | ");
+		if ((*hi).isRotation)
+		{
+			CommandReply::append(reply, (*hi).previous.guest.name, "'s turn is over. ");
+		}
+		CommandReply::append(reply, (*hi).guest.name, ", gamepad ", ((*hi).index + 1), " is yours!");
+
+		const vector<PadQueue::Entry> entries = queue.getEntries();
+		if (!entries.empty())
+		{
+			CommandReply::append(reply, " Next up: ", entries.front().name, " (", entries.size(), " waiting).");
+		}
+
+		broadcastChatMessage(reply);
+		_chatLog.logCommand(reply);
+	}
+
+	string notice;
+	while (queue.popNotice(notice))
+	{
+		broadcastChatMessage(notice);
+	}
+}
+
 bool Hosting::parsecArcadeStart()
 {
 	if (isReady()) {
@@ -525,16 +943,17 @@ void Hosting::onGuestStateChange(ParsecGuestState& state, Guest& guest)
 		ParsecHostKickGuest(_parsec, guest.id);
 		logMessage = _chatBot->formatBannedGuestMessage(guest);
 		broadcastChatMessage(logMessage);
+		_sessionLog.record(SessionLogFormat::Kind::MODERATION, guest.userID, guest.name.c_str(), logMessage.c_str());
 	}
 	else if (state == GUEST_CONNECTED || state == GUEST_DISCONNECTED)
 	{
-		static string guestMsg;
-		guestMsg.clear();
-		guestMsg = string(guest.name);
-
 		logMessage = _chatBot->formatGuestConnection(guest, state);
 		broadcastChatMessage(logMessage);
 		_chatLog.logCommand(logMessage);
+		_sessionLog.record(
+			state == GUEST_CONNECTED ? SessionLogFormat::Kind::JOIN : SessionLogFormat::Kind::LEAVE,
+			guest.userID, guest.name.c_str(), nullptr
+		);
 
 		if (state == GUEST_CONNECTED)
 		{
@@ -542,6 +961,11 @@ void Hosting::onGuestStateChange(ParsecGuestState& state, Guest& guest)
 		}
 		else
 		{
+			_chatOutbox.clear(guest.id);
+			_chatLimiter.forget(guest.userID);
+			_mouseRouter.onGuestLeft(guest.userID);
+			_gamepadClient.getPadQueue().leave(guest.userID);
+
 			int droppedPads = 0;
 			CommandFF command(guest, _gamepadClient);
 			command.run();
@@ -22,10 +22,19 @@
 #include "AudioMix.h"
 #include "GamepadClient.h"
 #include "BanList.h"
+#include "ChatOutbox.h"
+#include "ChatRateLimiter.h"
+#include "SessionLog.h"
+#include "PersistenceWorker.h"
 #include "Dice.h"
 #include "GuestList.h"
 #include "SFXList.h"
 #include "MetadataCache.h"
+#include "InputRecorder.h"
+#include "InputReplayer.h"
+#include "InputRateLimiter.h"
+#include "InputLatency.h"
+#include "MouseRouter.h"
 
 #define PARSEC_APP_CHAT_MSG 0
 #define HOSTING_CHAT_MSG_ID 0
@@ -33,6 +42,10 @@
 #define ROOM_NAME "Coding my own Parsec\nGamepad streaming\0"
 #define ROOM_SECRET "melonsod"
 
+#define IDLE_CHECK_INTERVAL_MS 1000
+#define PAD_QUEUE_RESTORE_GRACE_MS 60000
+#define PREFERENCES_FLUSH_INTERVAL_MS 5000
+
 using namespace std;
 
 class Hosting
@@ -40,7 +53,8 @@ class Hosting
 public:
 	Hosting();
 	void applyHostConfig();
-	void broadcastChatMessage(string message);
+	/** Queues the line for everyone in the room; guest chat passes isSystem = false so it is never merged. */
+	void broadcastChatMessage(const string& message, bool isSystem = true);
 	void init();
 	void release();
 	bool isReady();
@@ -49,12 +63,12 @@ public:
 	Guest& getHost();
 	ParsecSession& getSession();
 	ParsecHostConfig& getHostConfig();
-	vector<string>& getMessageLog();
-	vector<string>& getCommandLog();
-	vector<Guest>& getGuestList();
+	LogRing& getMessageLog();
+	LogRing& getCommandLog();
+	vector<Guest> getGuestList();
 	vector<GuestData>& getGuestHistory();
 	BanList& getBanList();
-	vector<Gamepad>& getGamepads();
+	shared_ptr<const GamepadTable> getGamepads();
 	GamepadClient& getGamepadClient();
 	const char** getGuestNames();
 	void toggleGamepadLock();
@@ -68,10 +82,20 @@ public:
 	void startHosting();
 	void stopHosting();
 	void stripGamepad(int index);
-	void setOwner(Gamepad& gamepad, Guest newOwner, int padId);
+	void setOwner(int gamepadIndex, Guest newOwner, int padId);
+	bool toggleInputRecording();
+	bool isRecordingInputs();
+	bool replayInputs(bool realtime = false);
+	bool isReplayingInputs();
+	bool toggleInputLatency();
+	bool isMeasuringInputLatency();
+	const InputLatency::Summary getInputLatency(uint32_t userID);
+	const string persistenceReport();
+	const string chatReport();
+	const string sessionLogReport();
 
-	void handleMessage(const char* message, Guest& guest, bool isHost = false);
-	void sendHostMessage(const char* message);
+	void handleMessage(const char* message, Guest& guest, bool isHost = false, string* reply = nullptr);
+	const string sendHostMessage(const char* message);
 
 	AudioIn audioIn;
 	AudioOut audioOut;
@@ -82,6 +106,15 @@ private:
 	void mainLoopControl();
 	void pollEvents();
 	void pollInputs();
+	void sendInput(ParsecGuest& guest, ParsecMessage& message, uint64_t receivedUs);
+	void onInputFlood(ParsecGuest& guest);
+	bool isChatAllowed(const char* message, Guest& guest);
+	void reconcileGuests();
+	void reclaimIdlePads();
+	void serviceQueue();
+	void beginReplay();
+	void endReplay();
+	void flushPreferences();
 	bool parsecArcadeStart();
 	bool isFilteredCommand(ACommand* command);
 	void onGuestStateChange(ParsecGuestState& state, Guest& guest);
@@ -91,8 +124,10 @@ private:
 	DX11 _dx11;
 	BanList _banList;
 	GuestDataList _guestHistory;
-	ChatBot *_chatBot;
+	ChatBot *_chatBot = nullptr;
 	ChatLog _chatLog;
+	ChatOutbox _chatOutbox;
+	SessionLog _sessionLog;
 	Dice _dice;
 	GamepadClient _gamepadClient;
 	GuestList _guestList;
@@ -104,17 +139,33 @@ private:
 	Guest _host;
 	SFXList _sfxList;
 	TierList _tierList;
+	PersistenceWorker _persistence;
+	InputRecorder _inputRecorder;
+	InputReplayer _inputReplayer;
+	vector<pair<shared_ptr<Gamepad>, GuestDevice>> _replayOwners;
+	bool _wasLockedBeforeReplay = false;
+	InputRateLimiter _inputLimiter;
+	ChatRateLimiter _chatLimiter;
+	InputLatency _inputLatency;
+	MouseRouter _mouseRouter;
+
+	uint64_t _lastGuestReconcileMs = 0;
+	uint64_t _lastIdleCheckMs = 0;
+	uint64_t _queueRestoredMs = 0;
+	uint64_t _lastPreferencesFlushMs = 0;
 
 	bool _isRunning = false;
 	bool _isMediaThreadRunning = false;
 	bool _isInputThreadRunning = false;
 	bool _isEventThreadRunning = false;
+	atomic<bool> _isReplaying { false };
+	atomic<bool> _isReplayRequested { false };
+	atomic<bool> _isReplayRealtime { false };
 
 	thread _mainLoopControlThread;
 	thread _mediaThread;
 	thread _inputThread;
 	thread _eventThread;
-	thread _createGamepadsThread;
 	thread _connectGamepadsThread;
 
 	mutex _mediaMutex;
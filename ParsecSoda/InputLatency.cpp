@@ -0,0 +1,269 @@
+#include "InputLatency.h"
+#include <fstream>
+#include <sstream>
+
+atomic<bool> InputLatency::_isEnabled { false };
+thread_local uint64_t InputLatency::_appliedUs = 0;
+
+// =============================================================
+//
+//  Hot path
+//
+// =============================================================
+
+bool InputLatency::isEnabled()
+{
+	return _isEnabled.load(memory_order_relaxed);
+}
+
+uint64_t InputLatency::now()
+{
+	return (uint64_t)chrono::duration_cast<chrono::microseconds>(
+		chrono::steady_clock::now().time_since_epoch()
+	).count();
+}
+
+void InputLatency::beginApply()
+{
+	_appliedUs = 0;
+}
+
+void InputLatency::markApplied()
+{
+	if (isEnabled())
+	{
+		_appliedUs = now();
+	}
+}
+
+uint64_t InputLatency::takeApplied()
+{
+	const uint64_t appliedUs = _appliedUs;
+	_appliedUs = 0;
+	return appliedUs;
+}
+
+bool InputLatency::setEnabled(bool enabled)
+{
+	_isEnabled = enabled;
+	return enabled;
+}
+
+void InputLatency::record(uint32_t userID, const char* name, const ParsecMessage& message, uint64_t receivedUs, uint64_t dispatchedUs, uint64_t appliedUs)
+{
+	if (appliedUs < receivedUs || dispatchedUs < receivedUs)
+	{
+		return;
+	}
+
+	const int kind = (int)toKind(message);
+
+	lock_guard<mutex> lock(_mutex);
+	GuestHistograms& histograms = _guests[userID];
+	if (histograms.name != name)
+	{
+		histograms.name = name;
+	}
+	histograms.total[kind].add(appliedUs - receivedUs);
+	histograms.queue[kind].add(dispatchedUs - receivedUs);
+}
+
+void InputLatency::clear()
+{
+	lock_guard<mutex> lock(_mutex);
+	_guests.clear();
+}
+
+const InputLatency::Summary InputLatency::getSummary(uint32_t userID) const
+{
+	lock_guard<mutex> lock(_mutex);
+
+	unordered_map<uint32_t, GuestHistograms>::const_iterator it = _guests.find(userID);
+	if (it == _guests.end())
+	{
+		return Summary();
+	}
+
+	Histogram total, queue;
+	for (int kind = 0; kind < (int)Kind::COUNT; ++kind)
+	{
+		const Histogram& t = (*it).second.total[kind];
+		const Histogram& q = (*it).second.queue[kind];
+		for (size_t b = 0; b < INPUT_LATENCY_BUCKETS; ++b)
+		{
+			total.buckets[b] += t.buckets[b];
+			queue.buckets[b] += q.buckets[b];
+		}
+		total.count += t.count;
+		queue.count += q.count;
+		total.maxUs = max(total.maxUs, t.maxUs);
+		queue.maxUs = max(queue.maxUs, q.maxUs);
+	}
+
+	return summarize(total, queue);
+}
+
+const InputLatency::Summary InputLatency::getSummary(uint32_t userID, Kind kind) const
+{
+	lock_guard<mutex> lock(_mutex);
+
+	unordered_map<uint32_t, GuestHistograms>::const_iterator it = _guests.find(userID);
+	if (it == _guests.end() || kind == Kind::COUNT)
+	{
+		return Summary();
+	}
+
+	return summarize((*it).second.total[(int)kind], (*it).second.queue[(int)kind]);
+}
+
+bool InputLatency::dump(string path) const
+{
+	ofstream file(path, ios::trunc);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	file << "# Input-to-driver latency (microseconds): received by ParsecHostPollInput -> applied by vigem." << endl
+		<< "# queue p99 is received -> handed to GamepadClient." << endl;
+
+	lock_guard<mutex> lock(_mutex);
+	unordered_map<uint32_t, GuestHistograms>::const_iterator gi = _guests.begin();
+	for (; gi != _guests.end(); ++gi)
+	{
+		file << endl << "(#" << (*gi).first << ") " << (*gi).second.name << endl;
+		for (int kind = 0; kind < (int)Kind::COUNT; ++kind)
+		{
+			const Summary summary = summarize((*gi).second.total[kind], (*gi).second.queue[kind]);
+			if (summary.count > 0)
+			{
+				file << "\t" << kindName((Kind)kind) << "\t" << summary.toString() << endl;
+			}
+		}
+	}
+
+	return file.good();
+}
+
+InputLatency::Kind InputLatency::toKind(const ParsecMessage& message)
+{
+	switch (message.type)
+	{
+	case MESSAGE_GAMEPAD_STATE:		return Kind::STATE;
+	case MESSAGE_GAMEPAD_AXIS:		return Kind::AXIS;
+	case MESSAGE_GAMEPAD_BUTTON:	return Kind::BUTTON;
+	case MESSAGE_KEYBOARD:			return Kind::KEYBOARD;
+	default:						return Kind::OTHER;
+	}
+}
+
+const char* InputLatency::kindName(Kind kind)
+{
+	switch (kind)
+	{
+	case Kind::STATE:		return "state";
+	case Kind::AXIS:		return "axis";
+	case Kind::BUTTON:		return "button";
+	case Kind::KEYBOARD:	return "keyboard";
+	default:				return "other";
+	}
+}
+
+const string InputLatency::Summary::toString() const
+{
+	std::ostringstream out;
+	out << count << " msgs, p50 " << p50Us << " us, p99 " << p99Us << " us, max " << maxUs << " us, queue p99 " << queueP99Us << " us";
+	return out.str();
+}
+
+
+// =============================================================
+//
+//  Histogram
+//
+// =============================================================
+
+void InputLatency::Histogram::add(uint64_t us)
+{
+	buckets[bucketOf(us)]++;
+	count++;
+	if (us > maxUs) maxUs = us;
+}
+
+uint64_t InputLatency::Histogram::percentile(double p) const
+{
+	if (count == 0)
+	{
+		return 0;
+	}
+
+	const uint64_t rank = max((uint64_t)1, (uint64_t)(p * count + 0.5));
+	uint64_t seen = 0;
+	for (size_t b = 0; b < INPUT_LATENCY_BUCKETS; ++b)
+	{
+		seen += buckets[b];
+		if (seen >= rank)
+		{
+			return min(bucketCeiling(b), maxUs);
+		}
+	}
+
+	return maxUs;
+}
+
+void InputLatency::Histogram::clear()
+{
+	*this = Histogram();
+}
+
+
+// =============================================================
+//
+//  Private
+//
+// =============================================================
+
+const InputLatency::Summary InputLatency::summarize(const Histogram& total, const Histogram& queue)
+{
+	Summary summary;
+	summary.count = total.count;
+	summary.p50Us = total.percentile(0.50);
+	summary.p99Us = total.percentile(0.99);
+	summary.maxUs = total.maxUs;
+	summary.queueP99Us = queue.percentile(0.99);
+	return summary;
+}
+
+size_t InputLatency::bucketOf(uint64_t us)
+{
+	if (us < INPUT_LATENCY_SUB_BUCKETS)
+	{
+		return (size_t)us;
+	}
+
+	// Exponent of the highest set bit; values past the last group land in the last bucket.
+	size_t exponent = 0;
+	for (uint64_t v = us; v > 1; v >>= 1) exponent++;
+
+	const size_t group = exponent - 2;
+	if (group > INPUT_LATENCY_MAX_EXPONENT)
+	{
+		return INPUT_LATENCY_BUCKETS - 1;
+	}
+
+	const size_t sub = (size_t)(us >> (exponent - 3)) & (INPUT_LATENCY_SUB_BUCKETS - 1);
+	return group * INPUT_LATENCY_SUB_BUCKETS + sub;
+}
+
+uint64_t InputLatency::bucketCeiling(size_t bucket)
+{
+	if (bucket < INPUT_LATENCY_SUB_BUCKETS)
+	{
+		return bucket;
+	}
+
+	const size_t group = bucket / INPUT_LATENCY_SUB_BUCKETS;
+	const size_t sub = bucket % INPUT_LATENCY_SUB_BUCKETS;
+	const size_t shift = group - 1;
+	return (((uint64_t)INPUT_LATENCY_SUB_BUCKETS + sub + 1) << shift) - 1;
+}
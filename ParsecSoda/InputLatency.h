@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include "parsec-dso.h"
+
+#define INPUT_LATENCY_FILENAME "input-latency.txt"
+#define INPUT_LATENCY_SUB_BUCKETS 8
+#define INPUT_LATENCY_MAX_EXPONENT 24
+#define INPUT_LATENCY_BUCKETS (INPUT_LATENCY_SUB_BUCKETS * (INPUT_LATENCY_MAX_EXPONENT + 1))
+
+using namespace std;
+
+/**
+ * Input-to-driver latency, per guest and per message type.
+ * Three stamps per message: when ParsecHostPollInput returned it (received), when
+ * it was handed to GamepadClient (dispatched, later than received when the rate
+ * limiter held it back) and right after the vigem update that applied it.
+ * Histograms are log-linear in microseconds (8 steps per power of two, up to ~16 s).
+ *
+ * Disabled by default. When off, the input thread only reads one atomic flag:
+ * no clock reads, no lock, nothing recorded.
+ */
+class InputLatency
+{
+public:
+	enum class Kind
+	{
+		STATE,
+		AXIS,
+		BUTTON,
+		KEYBOARD,
+		OTHER,
+		COUNT
+	};
+
+	class Histogram
+	{
+	public:
+		void add(uint64_t us);
+		uint64_t percentile(double p) const;
+		void clear();
+
+		uint32_t buckets[INPUT_LATENCY_BUCKETS] = {};
+		uint64_t count = 0;
+		uint64_t maxUs = 0;
+	};
+
+	class Summary
+	{
+	public:
+		const string toString() const;
+
+		uint64_t count = 0;
+		uint64_t p50Us = 0;
+		uint64_t p99Us = 0;
+		uint64_t maxUs = 0;
+		uint64_t queueP99Us = 0;
+	};
+
+	static bool isEnabled();
+	static uint64_t now();
+	static void beginApply();
+	static void markApplied();
+	static uint64_t takeApplied();
+
+	bool setEnabled(bool enabled);
+	void record(uint32_t userID, const char* name, const ParsecMessage& message, uint64_t receivedUs, uint64_t dispatchedUs, uint64_t appliedUs);
+	void clear();
+	const Summary getSummary(uint32_t userID) const;
+	const Summary getSummary(uint32_t userID, Kind kind) const;
+	bool dump(string path) const;
+
+	static Kind toKind(const ParsecMessage& message);
+	static const char* kindName(Kind kind);
+
+private:
+	class GuestHistograms
+	{
+	public:
+		string name;
+		Histogram total[(int)Kind::COUNT];
+		Histogram queue[(int)Kind::COUNT];
+	};
+
+	static const Summary summarize(const Histogram& total, const Histogram& queue);
+	static size_t bucketOf(uint64_t us);
+	static uint64_t bucketCeiling(size_t bucket);
+
+	static atomic<bool> _isEnabled;
+	static thread_local uint64_t _appliedUs;
+
+	mutable mutex _mutex;
+	unordered_map<uint32_t, GuestHistograms> _guests;
+};
@@ -0,0 +1,324 @@
+#include "InputRateLimiter.h"
+
+#define INPUT_LIMIT_TOKEN 1000000ULL
+
+InputRateLimiter::InputRateLimiter()
+{
+	// Generous enough for a guest holding a few pads at full polling rate.
+	_budgets[(int)Channel::STATE]		= { 1000, 200 };
+	_budgets[(int)Channel::AXIS]		= { 2000, 400 };
+	_budgets[(int)Channel::BUTTON]		= { 200, 50 };
+	_budgets[(int)Channel::KEYBOARD]	= { 200, 50 };
+	_budgets[(int)Channel::MOUSE]		= { 2000, 400 };
+	_budgets[(int)Channel::OTHER]		= { 100, 20 };
+}
+
+void InputRateLimiter::reset()
+{
+	_guests.clear();
+	_pendingGuests.clear();
+	_flagged.clear();
+	_stats = Stats();
+}
+
+void InputRateLimiter::setBudget(Channel channel, Budget budget)
+{
+	_budgets[(int)channel] = budget;
+}
+
+InputRateLimiter::Verdict InputRateLimiter::check(const ParsecGuest& guest, const ParsecMessage& message, uint64_t nowUs)
+{
+	GuestState& state = _guests[guest.userID];
+	if (state.guest.id != guest.id || state.guest.userID != guest.userID)
+	{
+		state.guest = guest;
+	}
+
+	const Channel channel = toChannel(message);
+
+	if (isRelease(message) || take(state.buckets[(int)channel], _budgets[(int)channel], nowUs))
+	{
+		supersede(state, message);
+		_stats.passed++;
+		return Verdict::PASS;
+	}
+
+	const bool isCoalesced = coalesce(state, message, nowUs);
+	countDrop(state, nowUs);
+
+	if (isCoalesced)
+	{
+		if (!state.isQueued)
+		{
+			state.isQueued = true;
+			_pendingGuests.push_back(guest.userID);
+		}
+		_stats.coalesced++;
+		return Verdict::COALESCED;
+	}
+
+	_stats.dropped++;
+	return Verdict::DROPPED;
+}
+
+void InputRateLimiter::flush(uint64_t nowUs, function<void(ParsecGuest&, ParsecMessage&, uint64_t)> send)
+{
+	if (_pendingGuests.empty())
+	{
+		return;
+	}
+
+	size_t kept = 0;
+	for (size_t i = 0; i < _pendingGuests.size(); i++)
+	{
+		GuestState& state = _guests[_pendingGuests[i]];
+		state.isQueued = false;
+
+		for (PendingPad& pad : state.pads)
+		{
+			if (pad.hasState && take(state.buckets[(int)Channel::STATE], _budgets[(int)Channel::STATE], nowUs))
+			{
+				pad.hasState = false;
+				send(state.guest, pad.state, pad.stateUs);
+			}
+
+			for (uint8_t axis = 0; axis < INPUT_LIMIT_AXIS_COUNT && pad.axisMask != 0; axis++)
+			{
+				const uint8_t bit = 1 << axis;
+				if ((pad.axisMask & bit) && take(state.buckets[(int)Channel::AXIS], _budgets[(int)Channel::AXIS], nowUs))
+				{
+					pad.axisMask &= ~bit;
+					send(state.guest, pad.axis[axis], pad.axisUs[axis]);
+				}
+			}
+
+			if (!pad.isEmpty()) state.isQueued = true;
+		}
+
+		if (state.isQueued)
+		{
+			_pendingGuests[kept++] = _pendingGuests[i];
+		}
+	}
+	_pendingGuests.resize(kept);
+}
+
+bool InputRateLimiter::popFlagged(ParsecGuest& guest)
+{
+	if (_flagged.empty())
+	{
+		return false;
+	}
+
+	guest = _flagged.back();
+	_flagged.pop_back();
+	return true;
+}
+
+const InputRateLimiter::Stats InputRateLimiter::getStats() const
+{
+	return _stats;
+}
+
+InputRateLimiter::Channel InputRateLimiter::toChannel(const ParsecMessage& message)
+{
+	switch (message.type)
+	{
+	case MESSAGE_GAMEPAD_STATE:		return Channel::STATE;
+	case MESSAGE_GAMEPAD_AXIS:		return Channel::AXIS;
+	case MESSAGE_GAMEPAD_BUTTON:	return Channel::BUTTON;
+	case MESSAGE_KEYBOARD:			return Channel::KEYBOARD;
+	case MESSAGE_MOUSE_BUTTON:
+	case MESSAGE_MOUSE_WHEEL:
+	case MESSAGE_MOUSE_MOTION:		return Channel::MOUSE;
+	default:						return Channel::OTHER;
+	}
+}
+
+
+// =============================================================
+//
+//  Private
+//
+// =============================================================
+
+bool InputRateLimiter::take(Bucket& bucket, const Budget& budget, uint64_t nowUs)
+{
+	const uint64_t capacity = (uint64_t)budget.burst * INPUT_LIMIT_TOKEN;
+
+	if (bucket.lastUs == 0)
+	{
+		bucket.tokens = capacity;
+	}
+	else if (nowUs > bucket.lastUs)
+	{
+		bucket.tokens += (nowUs - bucket.lastUs) * budget.perSecond;
+		if (bucket.tokens > capacity) bucket.tokens = capacity;
+	}
+	bucket.lastUs = nowUs;
+
+	if (bucket.tokens >= INPUT_LIMIT_TOKEN)
+	{
+		bucket.tokens -= INPUT_LIMIT_TOKEN;
+		return true;
+	}
+
+	return false;
+}
+
+bool InputRateLimiter::coalesce(GuestState& state, const ParsecMessage& message, uint64_t nowUs)
+{
+	if (message.type == MESSAGE_GAMEPAD_STATE)
+	{
+		PendingPad* pad = findPad(state, message.gamepadState.id, true);
+		if (pad == nullptr) return false;
+
+		// A full state is newer than any axis still waiting for the same pad.
+		pad->id = message.gamepadState.id;
+		pad->state = message;
+		pad->stateUs = nowUs;
+		pad->hasState = true;
+		pad->axisMask = 0;
+		return true;
+	}
+
+	if (message.type == MESSAGE_GAMEPAD_AXIS && message.gamepadAxis.axis < INPUT_LIMIT_AXIS_COUNT)
+	{
+		PendingPad* pad = findPad(state, message.gamepadAxis.id, true);
+		if (pad == nullptr) return false;
+
+		pad->id = message.gamepadAxis.id;
+		pad->axis[message.gamepadAxis.axis] = message;
+		pad->axisUs[message.gamepadAxis.axis] = nowUs;
+		pad->axisMask |= 1 << message.gamepadAxis.axis;
+		return true;
+	}
+
+	return false;
+}
+
+void InputRateLimiter::supersede(GuestState& state, const ParsecMessage& message)
+{
+	if (!state.isQueued)
+	{
+		return;
+	}
+
+	switch (message.type)
+	{
+	case MESSAGE_GAMEPAD_STATE:
+	{
+		PendingPad* pad = findPad(state, message.gamepadState.id, false);
+		if (pad != nullptr)
+		{
+			pad->hasState = false;
+			pad->axisMask = 0;
+		}
+		break;
+	}
+
+	case MESSAGE_GAMEPAD_AXIS:
+	{
+		PendingPad* pad = findPad(state, message.gamepadAxis.id, false);
+		if (pad != nullptr && message.gamepadAxis.axis < INPUT_LIMIT_AXIS_COUNT)
+		{
+			pad->axisMask &= ~(1 << message.gamepadAxis.axis);
+			if (pad->hasState)
+			{
+				ParsecGamepadStateMessage& pending = pad->state.gamepadState;
+				const int16_t value = message.gamepadAxis.value;
+				switch (message.gamepadAxis.axis)
+				{
+				case GAMEPAD_AXIS_LX:		pending.thumbLX = value; break;
+				case GAMEPAD_AXIS_LY:		pending.thumbLY = value; break;
+				case GAMEPAD_AXIS_RX:		pending.thumbRX = value; break;
+				case GAMEPAD_AXIS_RY:		pending.thumbRY = value; break;
+				case GAMEPAD_AXIS_TRIGGERL:	pending.leftTrigger = (uint8_t)value; break;
+				case GAMEPAD_AXIS_TRIGGERR:	pending.rightTrigger = (uint8_t)value; break;
+				default: break;
+				}
+			}
+		}
+		break;
+	}
+
+	case MESSAGE_GAMEPAD_BUTTON:
+	{
+		// Same bit order as ParsecGamepadButton, so a held state can't undo a newer press or release.
+		static const uint16_t stateBits[GAMEPAD_BUTTON_MAX] = {
+			GAMEPAD_STATE_A, GAMEPAD_STATE_B, GAMEPAD_STATE_X, GAMEPAD_STATE_Y,
+			GAMEPAD_STATE_BACK, GAMEPAD_STATE_GUIDE, GAMEPAD_STATE_START,
+			GAMEPAD_STATE_LEFT_THUMB, GAMEPAD_STATE_RIGHT_THUMB,
+			GAMEPAD_STATE_LEFT_SHOULDER, GAMEPAD_STATE_RIGHT_SHOULDER,
+			GAMEPAD_STATE_DPAD_UP, GAMEPAD_STATE_DPAD_DOWN, GAMEPAD_STATE_DPAD_LEFT, GAMEPAD_STATE_DPAD_RIGHT
+		};
+
+		PendingPad* pad = findPad(state, message.gamepadButton.id, false);
+		if (pad != nullptr && pad->hasState && message.gamepadButton.button < GAMEPAD_BUTTON_MAX)
+		{
+			const uint16_t bit = stateBits[message.gamepadButton.button];
+			uint16_t& buttons = pad->state.gamepadState.buttons;
+			buttons = message.gamepadButton.pressed ? (buttons | bit) : (buttons & ~bit);
+		}
+		break;
+	}
+
+	default:
+		break;
+	}
+}
+
+void InputRateLimiter::countDrop(GuestState& state, uint64_t nowUs)
+{
+	if (nowUs - state.windowStartUs >= INPUT_LIMIT_WINDOW_US)
+	{
+		const bool wasFlooding = state.windowDrops > INPUT_LIMIT_FLAG_DROPS;
+		const bool isNextWindow = nowUs - state.windowStartUs < 2 * INPUT_LIMIT_WINDOW_US;
+		state.floodedWindows = (wasFlooding && isNextWindow) ? state.floodedWindows + 1 : 0;
+		if (state.floodedWindows == 0)
+		{
+			state.isFlagged = false;
+		}
+
+		state.windowStartUs = nowUs;
+		state.windowDrops = 0;
+	}
+
+	state.windowDrops++;
+
+	if (!state.isFlagged && state.floodedWindows >= INPUT_LIMIT_FLAG_WINDOWS - 1 && state.windowDrops > INPUT_LIMIT_FLAG_DROPS)
+	{
+		state.isFlagged = true;
+		_flagged.push_back(state.guest);
+		_stats.flagged++;
+	}
+}
+
+bool InputRateLimiter::isRelease(const ParsecMessage& message)
+{
+	switch (message.type)
+	{
+	case MESSAGE_GAMEPAD_BUTTON:	return !message.gamepadButton.pressed;
+	case MESSAGE_KEYBOARD:			return !message.keyboard.pressed;
+	case MESSAGE_MOUSE_BUTTON:		return !message.mouseButton.pressed;
+	default:						return false;
+	}
+}
+
+InputRateLimiter::PendingPad* InputRateLimiter::findPad(GuestState& state, uint32_t id, bool isClaiming)
+{
+	PendingPad* empty = nullptr;
+	for (PendingPad& pad : state.pads)
+	{
+		if (pad.isEmpty())
+		{
+			if (empty == nullptr) empty = &pad;
+		}
+		else if (pad.id == id)
+		{
+			return &pad;
+		}
+	}
+
+	return isClaiming ? empty : nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include "parsec-dso.h"
+
+#define INPUT_LIMIT_AXIS_COUNT 6
+#define INPUT_LIMIT_PAD_SLOTS 4
+#define INPUT_LIMIT_FLAG_DROPS 200
+#define INPUT_LIMIT_FLAG_WINDOWS 3
+#define INPUT_LIMIT_WINDOW_US 1000000
+
+using namespace std;
+
+/**
+ * Per-guest token buckets in front of GamepadClient::sendMessage.
+ * Every message type has its own budget. Over budget, gamepad state and axis
+ * messages are coalesced into one pending slot per pad (and axis) that flush()
+ * sends once tokens refill (with the time it was received); everything else is
+ * dropped. Releases (button up, key up) are never limited, and a message that
+ * passes overrides whatever is still pending for its pad, so throttling can't
+ * leave a button stuck down.
+ * A guest that keeps dropping more than INPUT_LIMIT_FLAG_DROPS per second for
+ * INPUT_LIMIT_FLAG_WINDOWS seconds in a row is flagged once.
+ * Not thread safe: meant to live on the input thread.
+ */
+class InputRateLimiter
+{
+public:
+	enum class Verdict
+	{
+		PASS,
+		COALESCED,
+		DROPPED
+	};
+
+	enum class Channel
+	{
+		STATE,
+		AXIS,
+		BUTTON,
+		KEYBOARD,
+		MOUSE,
+		OTHER,
+		COUNT
+	};
+
+	class Budget
+	{
+	public:
+		uint32_t perSecond;
+		uint32_t burst;
+	};
+
+	class Stats
+	{
+	public:
+		uint64_t passed = 0;
+		uint64_t coalesced = 0;
+		uint64_t dropped = 0;
+		uint64_t flagged = 0;
+	};
+
+	InputRateLimiter();
+	void reset();
+	void setBudget(Channel channel, Budget budget);
+	Verdict check(const ParsecGuest& guest, const ParsecMessage& message, uint64_t nowUs);
+	void flush(uint64_t nowUs, function<void(ParsecGuest&, ParsecMessage&, uint64_t)> send);
+	bool popFlagged(ParsecGuest& guest);
+	const Stats getStats() const;
+
+	static Channel toChannel(const ParsecMessage& message);
+
+private:
+	class Bucket
+	{
+	public:
+		/** Scaled by 1e6 so refill is integer math on microseconds. */
+		uint64_t tokens = 0;
+		uint64_t lastUs = 0;
+	};
+
+	/** The newest state and axis messages of one pad that are waiting for tokens. */
+	class PendingPad
+	{
+	public:
+		uint32_t id = 0;
+		ParsecMessage state;
+		ParsecMessage axis[INPUT_LIMIT_AXIS_COUNT];
+		uint64_t stateUs = 0;
+		uint64_t axisUs[INPUT_LIMIT_AXIS_COUNT] = {};
+		bool hasState = false;
+		uint8_t axisMask = 0;
+
+		bool isEmpty() const { return !hasState && axisMask == 0; }
+	};
+
+	class GuestState
+	{
+	public:
+		ParsecGuest guest = {};
+		Bucket buckets[(int)Channel::COUNT];
+		PendingPad pads[INPUT_LIMIT_PAD_SLOTS];
+		bool isQueued = false;
+		uint64_t windowStartUs = 0;
+		uint32_t windowDrops = 0;
+		uint32_t floodedWindows = 0;
+		bool isFlagged = false;
+	};
+
+	bool take(Bucket& bucket, const Budget& budget, uint64_t nowUs);
+	bool coalesce(GuestState& state, const ParsecMessage& message, uint64_t nowUs);
+	void supersede(GuestState& state, const ParsecMessage& message);
+	void countDrop(GuestState& state, uint64_t nowUs);
+	static bool isRelease(const ParsecMessage& message);
+	static PendingPad* findPad(GuestState& state, uint32_t id, bool isClaiming);
+
+	Budget _budgets[(int)Channel::COUNT];
+	unordered_map<uint32_t, GuestState> _guests;
+	vector<uint32_t> _pendingGuests;
+	vector<ParsecGuest> _flagged;
+	Stats _stats;
+};
@@ -0,0 +1,126 @@
+#include "InputRecorder.h"
+
+InputRecorder::~InputRecorder()
+{
+	stop();
+}
+
+bool InputRecorder::start(string path)
+{
+	stop();
+
+	_file.open(path, ios::binary | ios::trunc);
+	if (!_file.is_open())
+	{
+		return false;
+	}
+
+	InputTrace::FileHeader header;
+	header.magic = INPUT_TRACE_MAGIC;
+	header.version = INPUT_TRACE_VERSION;
+	header.messageSize = sizeof(ParsecMessage);
+	_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	_pending.clear();
+	_knownGuests.clear();
+	_lastTimestamp = chrono::steady_clock::now();
+	_recordedCount = 0;
+	_isRecording = true;
+
+	_writerThread = thread([this]() { writeLoop(); });
+	return true;
+}
+
+void InputRecorder::stop()
+{
+	if (!_isRecording.exchange(false))
+	{
+		return;
+	}
+
+	_signal.notify_one();
+	if (_writerThread.joinable())
+	{
+		_writerThread.join();
+	}
+	_file.close();
+}
+
+const bool InputRecorder::isRecording() const
+{
+	return _isRecording;
+}
+
+const uint64_t InputRecorder::recordedCount() const
+{
+	return _recordedCount;
+}
+
+void InputRecorder::record(const ParsecGuest& guest, const ParsecMessage& message)
+{
+	if (!_isRecording)
+	{
+		return;
+	}
+
+	chrono::steady_clock::time_point now = chrono::steady_clock::now();
+
+	lock_guard<mutex> lock(_mutex);
+
+	if (_knownGuests.insert(guest.userID).second)
+	{
+		InputTrace::GuestRecord guestRecord;
+		guestRecord.type = (uint8_t)InputTrace::RecordType::GUEST;
+		guestRecord.userID = guest.userID;
+		guestRecord.id = guest.id;
+		guestRecord.nameLength = (uint8_t)strnlen(guest.name, min((size_t)GUEST_NAME_LEN, (size_t)UINT8_MAX));
+		append(&guestRecord, sizeof(guestRecord));
+		append(guest.name, guestRecord.nameLength);
+	}
+
+	InputTrace::InputRecord inputRecord;
+	inputRecord.type = (uint8_t)InputTrace::RecordType::INPUT;
+	inputRecord.deltaUs = (uint32_t)chrono::duration_cast<chrono::microseconds>(now - _lastTimestamp).count();
+	inputRecord.userID = guest.userID;
+	inputRecord.message = message;
+	append(&inputRecord, sizeof(inputRecord));
+
+	_lastTimestamp = now;
+	_recordedCount++;
+}
+
+// =============================================================
+//
+//  Private
+//
+// =============================================================
+
+void InputRecorder::writeLoop()
+{
+	vector<uint8_t> writing;
+	bool isRunning = true;
+
+	while (isRunning)
+	{
+		{
+			unique_lock<mutex> lock(_mutex);
+			_signal.wait_for(lock, chrono::milliseconds(INPUT_RECORDER_FLUSH_MS));
+			writing.swap(_pending);
+			isRunning = _isRecording;
+		}
+
+		if (!writing.empty())
+		{
+			_file.write(reinterpret_cast<const char*>(writing.data()), writing.size());
+			writing.clear();
+		}
+	}
+
+	_file.flush();
+}
+
+void InputRecorder::append(const void* data, size_t size)
+{
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+	_pending.insert(_pending.end(), bytes, bytes + size);
+}
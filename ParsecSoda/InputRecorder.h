@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <unordered_set>
+#include "parsec.h"
+#include "InputTrace.h"
+
+#define INPUT_RECORDER_FLUSH_MS 100
+
+using namespace std;
+
+/**
+ * Streams (timestamp, guest, ParsecMessage) tuples to disk.
+ * record() only appends to a memory buffer; a background thread does the writing.
+ */
+class InputRecorder
+{
+public:
+	~InputRecorder();
+	bool start(string path);
+	void stop();
+	const bool isRecording() const;
+	const uint64_t recordedCount() const;
+	void record(const ParsecGuest& guest, const ParsecMessage& message);
+
+private:
+	void writeLoop();
+	void append(const void* data, size_t size);
+
+	ofstream _file;
+	thread _writerThread;
+	mutex _mutex;
+	condition_variable _signal;
+	vector<uint8_t> _pending;
+	unordered_set<uint32_t> _knownGuests;
+	chrono::steady_clock::time_point _lastTimestamp;
+	atomic<bool> _isRecording { false };
+	atomic<uint64_t> _recordedCount { 0 };
+};
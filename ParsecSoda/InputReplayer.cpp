@@ -0,0 +1,223 @@
+#include "InputReplayer.h"
+
+bool InputReplayer::load(string path, vector<Entry>& entries)
+{
+	ifstream file(path, ios::binary);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	InputTrace::FileHeader header;
+	if (
+		!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+		header.magic != INPUT_TRACE_MAGIC ||
+		header.version != INPUT_TRACE_VERSION ||
+		header.messageSize != sizeof(ParsecMessage)
+	)
+	{
+		return false;
+	}
+
+	unordered_map<uint32_t, Guest> guests;
+	uint8_t type = 0;
+
+	while (file.read(reinterpret_cast<char*>(&type), sizeof(type)))
+	{
+		if (type == (uint8_t)InputTrace::RecordType::GUEST)
+		{
+			InputTrace::GuestRecord record;
+			record.type = type;
+			char name[UINT8_MAX + 1] = "";
+			if (
+				!file.read(reinterpret_cast<char*>(&record) + 1, sizeof(record) - 1) ||
+				!file.read(name, record.nameLength)
+			)
+			{
+				break;
+			}
+			guests[record.userID] = Guest(string(name, record.nameLength), record.userID, record.id);
+		}
+		else if (type == (uint8_t)InputTrace::RecordType::INPUT)
+		{
+			InputTrace::InputRecord record;
+			record.type = type;
+			if (!file.read(reinterpret_cast<char*>(&record) + 1, sizeof(record) - 1))
+			{
+				break;
+			}
+
+			Entry entry;
+			entry.deltaUs = record.deltaUs;
+			entry.message = record.message;
+			unordered_map<uint32_t, Guest>::iterator gi = guests.find(record.userID);
+			entry.guest = (gi != guests.end()) ? gi->second : Guest("", record.userID, 0);
+			entries.push_back(entry);
+		}
+		else
+		{
+			// Unknown record: the rest of the stream cannot be framed.
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool InputReplayer::start(string path, bool realtime)
+{
+	vector<Entry> entries;
+	if (!load(path, entries))
+	{
+		_isActive = false;
+		return false;
+	}
+
+	return start(entries, realtime);
+}
+
+bool InputReplayer::start(const vector<Entry>& entries, bool realtime)
+{
+	_entries = entries;
+	_traceGuests.clear();
+	vector<Entry>::const_iterator ei = _entries.begin();
+	for (; ei != _entries.end(); ++ei)
+	{
+		_traceGuests.insert((*ei).guest.userID);
+	}
+
+	_next = 0;
+	_isRealtime = realtime;
+	_latencies.clear();
+	_latencies.reserve(_entries.size());
+	_start = _target = chrono::steady_clock::now();
+	_isActive = true;
+
+	return true;
+}
+
+bool InputReplayer::step(GamepadClient& gamepadClient)
+{
+	using clock = chrono::steady_clock;
+	using micro = chrono::duration<double, micro>;
+
+	const size_t end = _isRealtime ? _entries.size() : min(_entries.size(), _next + INPUT_REPLAY_BATCH);
+	for (; _next < end; _next++)
+	{
+		const Entry& entry = _entries[_next];
+		if (_isRealtime)
+		{
+			const clock::time_point due = _target + chrono::microseconds(entry.deltaUs);
+			if (clock::now() < due)
+			{
+				break;
+			}
+			_target = due;
+		}
+
+		clock::time_point before = clock::now();
+		gamepadClient.sendMessage(entry.guest, entry.message);
+		_latencies.push_back(micro(clock::now() - before).count());
+	}
+
+	return _next >= _entries.size();
+}
+
+const InputReplayer::Report InputReplayer::finish(GamepadClient& gamepadClient)
+{
+	using clock = chrono::steady_clock;
+
+	Report report;
+	_isActive = false;
+
+	report.totalMs = chrono::duration<double, milli>(clock::now() - _start).count();
+	report.messageCount = _next;
+	report.messagesPerSecond = report.totalMs > 0 ? 1000.0 * report.messageCount / report.totalMs : 0;
+
+	if (!_latencies.empty())
+	{
+		sort(_latencies.begin(), _latencies.end());
+		report.p50Us = _latencies[_latencies.size() / 2];
+		report.p99Us = _latencies[min(_latencies.size() - 1, _latencies.size() * 99 / 100)];
+		report.maxUs = _latencies.back();
+	}
+
+	const shared_ptr<const GamepadTable> table = gamepadClient.getTable();
+	GamepadTable::Slots::const_iterator si = table->slots.begin();
+	for (; si != table->slots.end(); ++si)
+	{
+		PadState padState;
+		padState.ownerUserID = (*si).owner.guest.userID;
+		padState.state = (*si).pad->getState();
+		report.padStates.push_back(padState);
+	}
+
+	report.isValid = true;
+	return report;
+}
+
+bool InputReplayer::isActive() const
+{
+	return _isActive;
+}
+
+bool InputReplayer::isTraceGuest(uint32_t userID) const
+{
+	return _traceGuests.find(userID) != _traceGuests.end();
+}
+
+InputReplayer::Report InputReplayer::replay(const vector<Entry>& entries, GamepadClient& gamepadClient, bool realtime)
+{
+	InputReplayer replayer;
+	replayer.start(entries, realtime);
+	while (!replayer.step(gamepadClient))
+	{
+		if (realtime)
+		{
+			this_thread::sleep_for(chrono::microseconds(100));
+		}
+	}
+
+	return replayer.finish(gamepadClient);
+}
+
+InputReplayer::Report InputReplayer::replay(string path, GamepadClient& gamepadClient, bool realtime)
+{
+	vector<Entry> entries;
+	if (!load(path, entries))
+	{
+		return Report();
+	}
+
+	return replay(entries, gamepadClient, realtime);
+}
+
+const string InputReplayer::Report::toString() const
+{
+	std::ostringstream reply;
+
+	if (!isValid)
+	{
+		reply << "[Replay] | Could not read input trace.\0";
+		return reply.str();
+	}
+
+	reply
+		<< "[Replay] | " << messageCount << " messages in " << (int)totalMs << " ms"
+		<< " (" << (int)messagesPerSecond << " msg/s)\n"
+		<< "\t\tLatency p50: " << p50Us << " us | p99: " << p99Us << " us | max: " << maxUs << " us";
+
+	for (size_t i = 0; i < padStates.size(); ++i)
+	{
+		const XINPUT_GAMEPAD& pad = padStates[i].state.Gamepad;
+		reply
+			<< "\n\t\t[" << (i + 1) << "] (" << padStates[i].ownerUserID << ")"
+			<< " buttons: " << pad.wButtons
+			<< " L: " << pad.sThumbLX << "," << pad.sThumbLY
+			<< " R: " << pad.sThumbRX << "," << pad.sThumbRY
+			<< " T: " << (int)pad.bLeftTrigger << "," << (int)pad.bRightTrigger;
+	}
+	reply << "\0";
+
+	return reply.str();
+}
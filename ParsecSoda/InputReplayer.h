@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include "GamepadClient.h"
+#include "InputTrace.h"
+
+using namespace std;
+
+#define INPUT_REPLAY_BATCH 256
+
+/**
+ * Feeds a trace written by InputRecorder into GamepadClient::sendMessage,
+ * either at the original pace or as fast as possible.
+ * A replay is stepped by whichever thread feeds the pads (the input thread
+ * in Hosting), so the pads keep a single writer: start() loads the trace,
+ * each step() sends whatever is due and finish() reports.
+ */
+class InputReplayer
+{
+public:
+	class Entry
+	{
+	public:
+		uint32_t deltaUs = 0;
+		Guest guest;
+		ParsecMessage message;
+	};
+
+	class PadState
+	{
+	public:
+		uint32_t ownerUserID = 0;
+		XINPUT_STATE state = {};
+	};
+
+	class Report
+	{
+	public:
+		bool isValid = false;
+		uint64_t messageCount = 0;
+		double totalMs = 0;
+		double messagesPerSecond = 0;
+		double p50Us = 0;
+		double p99Us = 0;
+		double maxUs = 0;
+		vector<PadState> padStates;
+
+		const string toString() const;
+	};
+
+	bool start(string path, bool realtime = false);
+	bool start(const vector<Entry>& entries, bool realtime = false);
+	/** Sends the entries that are due (a batch when not realtime); true once all were sent. */
+	bool step(GamepadClient& gamepadClient);
+	const Report finish(GamepadClient& gamepadClient);
+	bool isActive() const;
+	/** True when the trace feeds input as this user. */
+	bool isTraceGuest(uint32_t userID) const;
+
+	static bool load(string path, vector<Entry>& entries);
+	/** Runs a whole replay on the calling thread. */
+	static Report replay(const vector<Entry>& entries, GamepadClient& gamepadClient, bool realtime = false);
+	static Report replay(string path, GamepadClient& gamepadClient, bool realtime = false);
+
+private:
+	vector<Entry> _entries;
+	unordered_set<uint32_t> _traceGuests;
+	size_t _next = 0;
+	bool _isActive = false;
+	bool _isRealtime = false;
+	chrono::steady_clock::time_point _start;
+	chrono::steady_clock::time_point _target;
+	vector<double> _latencies;
+};
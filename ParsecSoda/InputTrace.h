@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include "parsec.h"
+
+#define INPUT_TRACE_MAGIC 0x54495350
+#define INPUT_TRACE_VERSION 1
+#define INPUT_TRACE_FILENAME "input-trace.pstrace"
+
+/**
+ * Binary layout shared by InputRecorder and InputReplayer.
+ *
+ * A trace is a FileHeader followed by a stream of records. The first byte of
+ * every record is its RecordType. A GuestRecord (followed by nameLength bytes
+ * of UTF-8 name) is written the first time a user shows up; InputRecords then
+ * refer to guests by userID only. Timestamps are microsecond deltas from the
+ * previous InputRecord, so traces can be of any length.
+ */
+namespace InputTrace
+{
+	enum class RecordType : uint8_t
+	{
+		GUEST = 1,
+		INPUT = 2
+	};
+
+#pragma pack(push, 1)
+	typedef struct FileHeader
+	{
+		uint32_t magic;
+		uint16_t version;
+		uint16_t messageSize;
+	} FileHeader;
+
+	typedef struct GuestRecord
+	{
+		uint8_t type;
+		uint32_t userID;
+		uint32_t id;
+		uint8_t nameLength;
+	} GuestRecord;
+
+	typedef struct InputRecord
+	{
+		uint8_t type;
+		uint32_t deltaUs;
+		uint32_t userID;
+		ParsecMessage message;
+	} InputRecord;
+#pragma pack(pop)
+}
@@ -0,0 +1,182 @@
+#include "InputTransform.h"
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+InputTransform::InputTransform(const Settings settings)
+	: _settings(settings)
+{
+	if (_settings.turboHz == 0)						_settings.turboHz = TRANSFORM_TURBO_HZ_DEFAULT;
+	if (_settings.turboHz > TRANSFORM_TURBO_HZ_MAX)	_settings.turboHz = TRANSFORM_TURBO_HZ_MAX;
+
+	const double deadzone = (_settings.deadzone == Deadzone::AXIAL) ? _settings.deadzoneSize / 32768.0 : 0.0;
+	_isShapingSticks = (_settings.deadzone == Deadzone::AXIAL || _settings.curve != Curve::LINEAR);
+	_radialDeadzoneSquared = (_settings.deadzone == Deadzone::RADIAL)
+		? (uint32_t)_settings.deadzoneSize * _settings.deadzoneSize
+		: 0;
+
+	for (size_t i = 0; i < TRANSFORM_STICK_LUT_SIZE; i++)
+	{
+		double x = (double)(i << TRANSFORM_STICK_LUT_SHIFT) / 32768.0;
+		if (x > 1.0) x = 1.0;
+
+		x = (x <= deadzone) ? 0.0 : (x - deadzone) / (1.0 - deadzone);
+
+		switch (_settings.curve)
+		{
+		case Curve::SOFT:	x = x * x;		break;
+		case Curve::SOFTER:	x = x * x * x;	break;
+		case Curve::SHARP:	x = sqrt(x);	break;
+		default:							break;
+		}
+
+		_stick[i] = (int16_t)lround(x * 32767.0);
+	}
+
+	for (size_t i = 0; i < 256; i++)
+	{
+		_trigger[i] = (i < _settings.triggerThreshold) ? 0 : (uint8_t)i;
+	}
+}
+
+const InputTransform::Settings& InputTransform::getSettings() const
+{
+	return _settings;
+}
+
+bool InputTransform::hasTurbo() const
+{
+	return _settings.turboButtons != 0;
+}
+
+void InputTransform::apply(XINPUT_GAMEPAD& gamepad, uint32_t turboPhase) const
+{
+	// Stick-to-DPad reads the raw stick, exactly like the old mirror mode did.
+	if (_settings.stickToDpad)
+	{
+		const SHORT threshold = (SHORT)_settings.deadzoneSize;
+		gamepad.wButtons |=
+			(gamepad.sThumbLX < -threshold ? XUSB_GAMEPAD_DPAD_LEFT : 0)
+			| (gamepad.sThumbLX > threshold ? XUSB_GAMEPAD_DPAD_RIGHT : 0)
+			| (gamepad.sThumbLY > threshold ? XUSB_GAMEPAD_DPAD_UP : 0)
+			| (gamepad.sThumbLY < -threshold ? XUSB_GAMEPAD_DPAD_DOWN : 0);
+	}
+
+	if (_radialDeadzoneSquared > 0)
+	{
+		const int32_t lx = gamepad.sThumbLX, ly = gamepad.sThumbLY;
+		const int32_t rx = gamepad.sThumbRX, ry = gamepad.sThumbRY;
+		if ((uint32_t)(lx * lx) + (uint32_t)(ly * ly) < _radialDeadzoneSquared)
+		{
+			gamepad.sThumbLX = gamepad.sThumbLY = 0;
+		}
+		if ((uint32_t)(rx * rx) + (uint32_t)(ry * ry) < _radialDeadzoneSquared)
+		{
+			gamepad.sThumbRX = gamepad.sThumbRY = 0;
+		}
+	}
+
+	if (_isShapingSticks)
+	{
+		gamepad.sThumbLX = shapeStick(gamepad.sThumbLX);
+		gamepad.sThumbLY = shapeStick(gamepad.sThumbLY);
+		gamepad.sThumbRX = shapeStick(gamepad.sThumbRX);
+		gamepad.sThumbRY = shapeStick(gamepad.sThumbRY);
+	}
+
+	gamepad.bLeftTrigger = _trigger[gamepad.bLeftTrigger];
+	gamepad.bRightTrigger = _trigger[gamepad.bRightTrigger];
+
+	if (turboPhase & 1)
+	{
+		gamepad.wButtons &= ~_settings.turboButtons;
+	}
+}
+
+uint32_t InputTransform::turboPhase(uint64_t nowMs) const
+{
+	// Two phases (pressed, released) per turbo cycle.
+	return (uint32_t)((nowMs * _settings.turboHz * 2) / 1000);
+}
+
+bool InputTransform::parseCurve(const char* name, Curve& curve)
+{
+	if		(strcmp(name, "linear") == 0)	curve = Curve::LINEAR;
+	else if	(strcmp(name, "soft") == 0)		curve = Curve::SOFT;
+	else if	(strcmp(name, "softer") == 0)	curve = Curve::SOFTER;
+	else if	(strcmp(name, "sharp") == 0)	curve = Curve::SHARP;
+	else									return false;
+
+	return true;
+}
+
+bool InputTransform::parseButton(const char* name, uint16_t& button)
+{
+	static const struct { const char* name; uint16_t button; } buttons[] = {
+		{ "a", XUSB_GAMEPAD_A }, { "b", XUSB_GAMEPAD_B }, { "x", XUSB_GAMEPAD_X }, { "y", XUSB_GAMEPAD_Y },
+		{ "lb", XUSB_GAMEPAD_LEFT_SHOULDER }, { "rb", XUSB_GAMEPAD_RIGHT_SHOULDER },
+		{ "ls", XUSB_GAMEPAD_LEFT_THUMB }, { "rs", XUSB_GAMEPAD_RIGHT_THUMB }
+	};
+
+	for (size_t i = 0; i < sizeof(buttons) / sizeof(buttons[0]); i++)
+	{
+		if (strcmp(buttons[i].name, name) == 0)
+		{
+			button = buttons[i].button;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool InputTransform::Settings::isIdentity() const
+{
+	return deadzone == Deadzone::NONE
+		&& curve == Curve::LINEAR
+		&& triggerThreshold == 0
+		&& !stickToDpad
+		&& turboButtons == 0;
+}
+
+const string InputTransform::Settings::toString() const
+{
+	static const char* deadzoneNames[] = { "off", "axial", "radial" };
+	static const char* curveNames[] = { "linear", "soft", "softer", "sharp" };
+
+	std::ostringstream result;
+	result
+		<< "deadzone " << deadzoneNames[(int)deadzone];
+	if (deadzone != Deadzone::NONE)
+	{
+		result << " " << (deadzoneSize * 100 / 32768) << "%";
+	}
+	result
+		<< " | curve " << curveNames[(int)curve]
+		<< " | trigger " << (int)triggerThreshold
+		<< " | mirror " << (stickToDpad ? "ON" : "OFF")
+		<< " | turbo ";
+	if (turboButtons != 0)	result << (int)turboHz << "Hz";
+	else					result << "OFF";
+
+	return result.str();
+}
+
+
+// =============================================================
+//
+//  Private
+//
+// =============================================================
+
+int16_t InputTransform::shapeStick(int16_t value) const
+{
+	// |value| in [0, 32768]: table index plus linear interpolation between neighbours.
+	const uint32_t magnitude = (value < 0) ? (uint32_t)(-(int32_t)value) : (uint32_t)value;
+	const uint32_t index = magnitude >> TRANSFORM_STICK_LUT_SHIFT;
+	const int32_t fraction = magnitude & ((1 << TRANSFORM_STICK_LUT_SHIFT) - 1);
+	const int32_t low = _stick[index];
+	const int32_t shaped = low + (((_stick[index + 1] - low) * fraction) >> TRANSFORM_STICK_LUT_SHIFT);
+
+	return (int16_t)(value < 0 ? -shaped : shaped);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Windows.h>
+#include <Xinput.h>
+#include <cstdint>
+#include <string>
+#include "ViGEm/Common.h"
+
+using namespace std;
+
+#define GAMEPAD_DEADZONE 4096
+
+#define TRANSFORM_STICK_LUT_SHIFT 6
+#define TRANSFORM_STICK_LUT_SIZE ((32768 >> TRANSFORM_STICK_LUT_SHIFT) + 2)
+#define TRANSFORM_TURBO_HZ_DEFAULT 10
+#define TRANSFORM_TURBO_HZ_MAX 30
+
+/**
+ * Per-guest shaping of the gamepad report, applied right before the ViGEm update.
+ * The raw state kept by Gamepad is never modified; curves and deadzones are baked
+ * into fixed-point tables when the settings change, so apply() is a handful of
+ * table loads no matter what the guest picked.
+ */
+class InputTransform
+{
+public:
+	enum class Deadzone : uint8_t
+	{
+		NONE,
+		AXIAL,
+		RADIAL
+	};
+
+	enum class Curve : uint8_t
+	{
+		LINEAR,
+		SOFT,
+		SOFTER,
+		SHARP
+	};
+
+	class Settings
+	{
+	public:
+		Deadzone deadzone = Deadzone::NONE;
+		uint16_t deadzoneSize = GAMEPAD_DEADZONE;
+		Curve curve = Curve::LINEAR;
+		uint8_t triggerThreshold = 0;
+		bool stickToDpad = false;
+		uint16_t turboButtons = 0;
+		uint8_t turboHz = TRANSFORM_TURBO_HZ_DEFAULT;
+
+		bool isIdentity() const;
+		const string toString() const;
+	};
+
+	InputTransform(const Settings settings);
+	const Settings& getSettings() const;
+	bool hasTurbo() const;
+
+	/** Turbo buttons are released on odd phases; see turboPhase(). */
+	void apply(XINPUT_GAMEPAD& gamepad, uint32_t turboPhase) const;
+	uint32_t turboPhase(uint64_t nowMs) const;
+
+	static bool parseCurve(const char* name, Curve& curve);
+	static bool parseButton(const char* name, uint16_t& button);
+
+private:
+	int16_t shapeStick(int16_t value) const;
+
+	Settings _settings;
+	bool _isShapingSticks = false;
+	uint32_t _radialDeadzoneSquared = 0;
+	int16_t _stick[TRANSFORM_STICK_LUT_SIZE];
+	uint8_t _trigger[256];
+};
@@ -0,0 +1,167 @@
+#include "KeyMap.h"
+#include <cstring>
+#include <cctype>
+
+static constexpr KeyMap KEYMAP_BUILT_IN = KeyMap::fromLayouts();
+
+static_assert(KEYMAP_BUILT_IN.get((uint32_t)KEY_TO_GAMEPAD::A).button == XUSB_GAMEPAD_A, "KeyMap: WASD layout A");
+static_assert(KEYMAP_BUILT_IN.get((uint32_t)KEY_TO_GAMEPAD2::A).button == XUSB_GAMEPAD_A, "KeyMap: arrows layout A");
+static_assert(KEYMAP_BUILT_IN.get((uint32_t)KEY_TO_GAMEPAD::LEFT).value == INT16_MIN, "KeyMap: WASD layout LEFT");
+static_assert(KEYMAP_BUILT_IN.get((uint32_t)KEY_TO_GAMEPAD2::RT).axis == KeyAction::Axis::RT, "KeyMap: arrows layout RT");
+static_assert(KEYMAP_BUILT_IN.get(KEY_AUDIOMUTE).isEmpty(), "KeyMap: out of range keys are unbound");
+
+const KeyMap KeyMap::WASD = KeyMap::fromLayout<KEY_TO_GAMEPAD>();
+const KeyMap KeyMap::ARROWS = KeyMap::fromLayout<KEY_TO_GAMEPAD2>();
+const KeyMap KeyMap::DEFAULT = KEYMAP_BUILT_IN;
+
+bool KeyMap::fromJSON(const MTY_JSON* json, KeyMap& keyMap)
+{
+	char base[16] = "";
+	if (!MTY_JSONObjGetString(json, "base", base, 16))
+	{
+		keyMap = KeyMap();
+	}
+	else if (strcmp(base, "wasd") == 0)		keyMap = WASD;
+	else if (strcmp(base, "arrows") == 0)	keyMap = ARROWS;
+	else if (strcmp(base, "default") == 0)	keyMap = DEFAULT;
+	else									keyMap = KeyMap();
+
+	const MTY_JSON* keys = MTY_JSONObjGetItem(json, "keys");
+	if (keys == nullptr)
+	{
+		return false;
+	}
+
+	bool isOk = false;
+	uint32_t size = MTY_JSONGetLength(keys);
+	for (uint32_t i = 0; i < size; i++)
+	{
+		const char* actionName = MTY_JSONObjGetKey(keys, i);
+		KeyAction action;
+		if (actionName == nullptr || !findAction(actionName, action))
+		{
+			continue;
+		}
+
+		uint32_t code = findKeyCode(keys, actionName);
+		if (code > 0 && code < KEYMAP_SIZE)
+		{
+			keyMap.unbindAction(action);
+			keyMap.bind(code, action);
+			isOk = true;
+		}
+	}
+
+	return isOk;
+}
+
+KeyMap::GuestKeyMaps KeyMap::load(string filepath)
+{
+	GuestKeyMaps result;
+
+	if (MTY_FileExists(filepath.c_str()))
+	{
+		MTY_JSON* json = MTY_JSONReadFile(filepath.c_str());
+		uint32_t size = MTY_JSONGetLength(json);
+
+		for (uint32_t i = 0; i < size; i++)
+		{
+			const MTY_JSON* guest = MTY_JSONArrayGetItem(json, i);
+
+			uint32_t userID = 0;
+			KeyMap keyMap;
+			if (MTY_JSONObjGetUInt(guest, "userID", &userID) && fromJSON(guest, keyMap))
+			{
+				result[userID] = keyMap;
+			}
+		}
+
+		MTY_JSONDestroy(&json);
+	}
+
+	return result;
+}
+
+
+// =============================================================
+//
+//  Private
+//
+// =============================================================
+
+bool KeyMap::findAction(const char* name, KeyAction& action)
+{
+	// Resolve the action through the WASD layout so names stay in sync with KEY_TO_GAMEPAD.
+	static const struct { const char* name; KEY_TO_GAMEPAD key; } names[] = {
+		{ "LEFT", KEY_TO_GAMEPAD::LEFT },	{ "RIGHT", KEY_TO_GAMEPAD::RIGHT },
+		{ "UP", KEY_TO_GAMEPAD::UP },		{ "DOWN", KEY_TO_GAMEPAD::DOWN },
+		{ "A", KEY_TO_GAMEPAD::A },			{ "B", KEY_TO_GAMEPAD::B },
+		{ "X", KEY_TO_GAMEPAD::X },			{ "Y", KEY_TO_GAMEPAD::Y },
+		{ "BACK", KEY_TO_GAMEPAD::BACK },	{ "START", KEY_TO_GAMEPAD::START },
+		{ "LB", KEY_TO_GAMEPAD::LB },		{ "RB", KEY_TO_GAMEPAD::RB },
+		{ "LT", KEY_TO_GAMEPAD::LT },		{ "RT", KEY_TO_GAMEPAD::RT },
+		{ "LTHUMB", KEY_TO_GAMEPAD::LTHUMB },	{ "RTHUMB", KEY_TO_GAMEPAD::RTHUMB }
+	};
+
+	for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+	{
+		if (strcmp(names[i].name, name) == 0)
+		{
+			action = WASD.get((uint32_t)names[i].key);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+uint32_t KeyMap::findKeyCode(const MTY_JSON* keys, const char* actionName)
+{
+	uint32_t code = 0;
+	if (MTY_JSONObjGetUInt(keys, actionName, &code))
+	{
+		return code;
+	}
+
+	char name[16] = "";
+	if (!MTY_JSONObjGetString(keys, actionName, name, 16))
+	{
+		return 0;
+	}
+
+	if (name[0] != '\0' && name[1] == '\0')
+	{
+		const char c = (char)toupper(name[0]);
+		if (c >= 'A' && c <= 'Z')	return KEY_A + (c - 'A');
+		if (c >= '1' && c <= '9')	return KEY_1 + (c - '1');
+		if (c == '0')				return KEY_0;
+	}
+
+	static const struct { const char* name; ParsecKeycode code; } named[] = {
+		{ "LEFT", KEY_LEFT }, { "RIGHT", KEY_RIGHT }, { "UP", KEY_UP }, { "DOWN", KEY_DOWN },
+		{ "SPACE", KEY_SPACE }, { "ENTER", KEY_ENTER }, { "BACKSPACE", KEY_BACKSPACE },
+		{ "TAB", KEY_TAB }, { "ESCAPE", KEY_ESCAPE },
+		{ "LSHIFT", KEY_LSHIFT }, { "LCTRL", KEY_LCTRL }
+	};
+
+	for (size_t i = 0; i < sizeof(named) / sizeof(named[0]); i++)
+	{
+		if (_stricmp(named[i].name, name) == 0)
+		{
+			return named[i].code;
+		}
+	}
+
+	return 0;
+}
+
+void KeyMap::unbindAction(const KeyAction& action)
+{
+	for (size_t i = 1; i < KEYMAP_SIZE; i++)
+	{
+		if (actions[i].button == action.button && actions[i].axis == action.axis && actions[i].value == action.value)
+		{
+			actions[i] = KeyAction();
+		}
+	}
+}
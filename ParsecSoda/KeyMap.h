@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <memory>
+#include "parsec-dso.h"
+#include <Windows.h>
+#include "ViGEm/Common.h"
+#include "matoya.h"
+#include "KeyboardMaps.h"
+
+using namespace std;
+
+#define KEYMAP_SIZE 256
+#define KEYMAP_FILENAME "keymaps.json"
+#define KEYMAP_FACE_BUTTONS (XUSB_GAMEPAD_A | XUSB_GAMEPAD_B | XUSB_GAMEPAD_X | XUSB_GAMEPAD_Y)
+
+/**
+ * What a single keyboard key does to the gamepad state.
+ * A key either toggles button bits or drives one stick/trigger axis.
+ */
+class KeyAction
+{
+public:
+	enum class Axis : uint8_t
+	{
+		NONE,
+		LX,
+		LY,
+		LT,
+		RT
+	};
+
+	constexpr KeyAction()
+		: button(0), axis(Axis::NONE), value(0)
+	{}
+	constexpr KeyAction(uint16_t button, Axis axis, int16_t value)
+		: button(button), axis(axis), value(value)
+	{}
+
+	static constexpr KeyAction makeButton(uint16_t button) { return KeyAction(button, Axis::NONE, 0); }
+	static constexpr KeyAction makeAxis(Axis axis, int16_t value) { return KeyAction(0, axis, value); }
+
+	constexpr bool isEmpty() const { return button == 0 && axis == Axis::NONE; }
+
+	uint16_t button;
+	Axis axis;
+	int16_t value;
+};
+
+/**
+ * Flat lookup table from Parsec keycode to KeyAction.
+ * Built-in layouts are generated at compile time from KEY_TO_GAMEPAD and
+ * KEY_TO_GAMEPAD2; custom per-guest layouts are parsed from KEYMAP_FILENAME
+ * into the same table, so the input path is a single indexed load either way.
+ * Entry 0 is never bound and doubles as the result for out-of-range keys.
+ */
+class KeyMap
+{
+public:
+	typedef unordered_map<uint32_t, KeyMap> GuestKeyMaps;
+
+	constexpr KeyMap()
+		: actions()
+	{}
+
+	constexpr const KeyAction& get(uint32_t code) const
+	{
+		return actions[code < KEYMAP_SIZE ? code : 0];
+	}
+
+	constexpr bool isRequest(const ParsecKeyboardMessage& key) const
+	{
+		return key.pressed && (get(key.code).button & KEYMAP_FACE_BUTTONS) != 0;
+	}
+
+	constexpr void bind(uint32_t code, KeyAction action)
+	{
+		if (code > 0 && code < KEYMAP_SIZE)
+		{
+			actions[code] = action;
+		}
+	}
+
+	template <typename LAYOUT>
+	constexpr void bindLayout()
+	{
+		bind((uint32_t)LAYOUT::LEFT, KeyAction::makeAxis(KeyAction::Axis::LX, INT16_MIN));
+		bind((uint32_t)LAYOUT::RIGHT, KeyAction::makeAxis(KeyAction::Axis::LX, INT16_MAX));
+		bind((uint32_t)LAYOUT::UP, KeyAction::makeAxis(KeyAction::Axis::LY, INT16_MAX));
+		bind((uint32_t)LAYOUT::DOWN, KeyAction::makeAxis(KeyAction::Axis::LY, INT16_MIN));
+		bind((uint32_t)LAYOUT::A, KeyAction::makeButton(XUSB_GAMEPAD_A));
+		bind((uint32_t)LAYOUT::B, KeyAction::makeButton(XUSB_GAMEPAD_B));
+		bind((uint32_t)LAYOUT::X, KeyAction::makeButton(XUSB_GAMEPAD_X));
+		bind((uint32_t)LAYOUT::Y, KeyAction::makeButton(XUSB_GAMEPAD_Y));
+		bind((uint32_t)LAYOUT::BACK, KeyAction::makeButton(XUSB_GAMEPAD_BACK));
+		bind((uint32_t)LAYOUT::START, KeyAction::makeButton(XUSB_GAMEPAD_START));
+		bind((uint32_t)LAYOUT::LB, KeyAction::makeButton(XUSB_GAMEPAD_LEFT_SHOULDER));
+		bind((uint32_t)LAYOUT::RB, KeyAction::makeButton(XUSB_GAMEPAD_RIGHT_SHOULDER));
+		bind((uint32_t)LAYOUT::LT, KeyAction::makeAxis(KeyAction::Axis::LT, UINT8_MAX));
+		bind((uint32_t)LAYOUT::RT, KeyAction::makeAxis(KeyAction::Axis::RT, UINT8_MAX));
+		bind((uint32_t)LAYOUT::LTHUMB, KeyAction::makeButton(XUSB_GAMEPAD_LEFT_THUMB));
+		bind((uint32_t)LAYOUT::RTHUMB, KeyAction::makeButton(XUSB_GAMEPAD_RIGHT_THUMB));
+	}
+
+	template <typename LAYOUT>
+	static constexpr KeyMap fromLayout()
+	{
+		KeyMap map;
+		map.bindLayout<LAYOUT>();
+		return map;
+	}
+
+	static constexpr KeyMap fromLayouts()
+	{
+		KeyMap map;
+		map.bindLayout<KEY_TO_GAMEPAD>();
+		map.bindLayout<KEY_TO_GAMEPAD2>();
+		return map;
+	}
+
+	static bool fromJSON(const MTY_JSON* json, KeyMap& keyMap);
+	static GuestKeyMaps load(string filepath);
+
+	KeyAction actions[KEYMAP_SIZE];
+
+	/** KEY_TO_GAMEPAD only (WASD + L O K I). */
+	static const KeyMap WASD;
+	/** KEY_TO_GAMEPAD2 only (arrows + keypad). */
+	static const KeyMap ARROWS;
+	/** Both built-in layouts at once; what guests without a custom keymap get. */
+	static const KeyMap DEFAULT;
+
+private:
+	static bool findAction(const char* name, KeyAction& action);
+	static uint32_t findKeyCode(const MTY_JSON* keys, const char* actionName);
+	void unbindAction(const KeyAction& action);
+};
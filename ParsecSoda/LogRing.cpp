@@ -0,0 +1,106 @@
+#include "LogRing.h"
+
+LogRing::LogRing(size_t capacity, size_t bytesPerLine)
+	: _capacity(capacity > 0 ? capacity : 1),
+	_byteCapacity(_capacity * (bytesPerLine > 0 ? bytesPerLine : 1)),
+	_slots(new Slot[_capacity]),
+	_bytes(new char[_byteCapacity])
+{
+}
+
+uint64_t LogRing::push(const string& text)
+{
+	lock_guard<mutex> lock(_writeMutex);
+
+	// One huge line shouldn't wipe out the whole log.
+	size_t length = text.size();
+	if (length > _byteCapacity / 4)
+	{
+		length = _byteCapacity / 4;
+	}
+
+	const uint64_t seq = _next.load(memory_order_relaxed);
+	const uint64_t offset = _written.load(memory_order_relaxed);
+	Slot& slot = _slots[seq % _capacity];
+
+	// Claim the slot and the bytes before touching them, so readers can tell.
+	slot.seq.store(0, memory_order_relaxed);
+	_written.store(offset + length, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+
+	copyIn(offset, text.c_str(), length);
+	slot.offset.store(offset, memory_order_relaxed);
+	slot.length.store((uint32_t)length, memory_order_relaxed);
+	slot.seq.store(seq, memory_order_release);
+	_next.store(seq + 1, memory_order_release);
+
+	return seq;
+}
+
+uint64_t LogRing::end() const
+{
+	return _next.load(memory_order_acquire);
+}
+
+size_t LogRing::capacity() const
+{
+	return _capacity;
+}
+
+uint64_t LogRing::readFrom(uint64_t from, deque<string>& lines) const
+{
+	const uint64_t last = _next.load(memory_order_acquire);
+	const uint64_t oldest = (last > _capacity) ? last - _capacity : 1;
+	uint64_t seq = (from > oldest) ? from : oldest;
+
+	for (; seq < last; seq++)
+	{
+		const Slot& slot = _slots[seq % _capacity];
+		if (slot.seq.load(memory_order_acquire) != seq)
+		{
+			continue;
+		}
+
+		const uint64_t offset = slot.offset.load(memory_order_relaxed);
+		const uint32_t length = slot.length.load(memory_order_relaxed);
+		string line(length, '\0');
+		copyOut(offset, &line[0], length);
+
+		atomic_thread_fence(memory_order_acquire);
+		if (slot.seq.load(memory_order_relaxed) != seq || _written.load(memory_order_relaxed) > offset + _byteCapacity)
+		{
+			continue;
+		}
+
+		lines.push_back(std::move(line));
+		if (lines.size() > _capacity)
+		{
+			lines.pop_front();
+		}
+	}
+
+	return last;
+}
+
+
+// =============================================================
+//
+//  Private
+//
+// =============================================================
+
+void LogRing::copyIn(uint64_t offset, const char* text, size_t length)
+{
+	const size_t start = (size_t)(offset % _byteCapacity);
+	const size_t head = (length < _byteCapacity - start) ? length : _byteCapacity - start;
+	memcpy(&_bytes[start], text, head);
+	memcpy(&_bytes[0], text + head, length - head);
+}
+
+void LogRing::copyOut(uint64_t offset, char* text, size_t length) const
+{
+	const size_t start = (size_t)(offset % _byteCapacity);
+	const size_t head = (length < _byteCapacity - start) ? length : _byteCapacity - start;
+	memcpy(text, &_bytes[start], head);
+	memcpy(text + head, &_bytes[0], length - head);
+}
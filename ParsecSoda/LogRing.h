@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <memory>
+
+#define LOG_RING_BYTES_PER_LINE 256
+
+using namespace std;
+
+/**
+ * Fixed-capacity log of text lines, numbered from 1 as they are pushed.
+ * Line n lives in slot n % capacity and its text in a circular byte buffer
+ * sized for capacity lines of LOG_RING_BYTES_PER_LINE on average, so pushing
+ * never allocates or moves older lines: the oldest simply get overwritten.
+ *
+ * Writers take a mutex among themselves; readers take nothing. A reader
+ * copies a line and then checks that neither its slot nor its bytes were
+ * reused meanwhile (a seqlock), skipping any line lost to a concurrent
+ * writer, so the UI never stalls the thread that logs.
+ */
+class LogRing
+{
+public:
+	LogRing(size_t capacity, size_t bytesPerLine = LOG_RING_BYTES_PER_LINE);
+
+	uint64_t push(const string& text);
+
+	/** Number the next line will get; lines below it have been pushed. */
+	uint64_t end() const;
+	size_t capacity() const;
+
+	/**
+	 * Appends every intact line numbered from onwards to lines, oldest first,
+	 * and trims lines to capacity. Returns the number to pass next time.
+	 */
+	uint64_t readFrom(uint64_t from, deque<string>& lines) const;
+
+private:
+	class Slot
+	{
+	public:
+		atomic<uint64_t> seq { 0 };
+		atomic<uint64_t> offset { 0 };
+		atomic<uint32_t> length { 0 };
+	};
+
+	void copyIn(uint64_t offset, const char* text, size_t length);
+	void copyOut(uint64_t offset, char* text, size_t length) const;
+
+	const size_t _capacity;
+	const size_t _byteCapacity;
+	unique_ptr<Slot[]> _slots;
+	unique_ptr<char[]> _bytes;
+
+	atomic<uint64_t> _next { 1 };
+	atomic<uint64_t> _written { 0 };
+	mutex _writeMutex;
+};
@@ -13,6 +13,7 @@
 #include <string>
 #include "resource.h"
 #include "Hosting.h"
+#include "HeadlessHost.h"
 #include "Texture.h"
 #include "globals/AppIcons.h"
 #include "globals/AppFonts.h"
@@ -52,6 +53,18 @@ int CALLBACK WinMain( _In_ HINSTANCE hInstance, _In_ HINSTANCE hPrevInstance, _I
 
     MetadataCache::loadPreferences();
 
+    // Dedicated hosts skip the window, D3D11 and ImGui entirely.
+    string sendLine;
+    if (HeadlessHost::isSendRequested(lpCmdLine, sendLine))
+    {
+        return HeadlessHost::send(sendLine);
+    }
+    if (HeadlessHost::isRequested(lpCmdLine))
+    {
+        HeadlessHost headless(g_hosting);
+        return headless.run();
+    }
+
     WNDCLASSEX wc;
     wc.cbSize = sizeof(WNDCLASSEX);
     wc.style = CS_CLASSDC;
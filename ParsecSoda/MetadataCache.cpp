@@ -1,5 +1,20 @@
 #include "MetadataCache.h"
 
+// Only getAppDataDir() and writeJsonAtomic() touch the OS; everything else goes through matoya.
+#if defined(_WIN32)
+    #include <Windows.h>
+    #include <ShlObj.h>
+    #define USER_DIR_NAME "\\ParsecSoda\\"
+    #define PATH_SEPARATOR "\\"
+#else
+    #include <cstdlib>
+    #include <cstdio>
+    #define USER_DIR_NAME "/ParsecSoda/"
+    #define PATH_SEPARATOR "/"
+#endif
+
+#define METADATA_TEMP_SUFFIX ".tmp"
+
 // This is not ideal, especially in an open source environment.
 // I'm using these values just as placeholders until I find an
 // actual solution. You should change them in your build.
@@ -159,6 +174,26 @@ MetadataCache::Preferences MetadataCache::loadPreferences()
             if (!MTY_JSONObjGetUInt(json, "windowH", &preferences.windowH) || preferences.windowH < 400) {
                 preferences.windowH = 720;
             }
+
+            if (!MTY_JSONObjGetUInt(json, "xboxCount", &preferences.xboxCount)) {
+                preferences.xboxCount = 4;
+            }
+
+            if (!MTY_JSONObjGetUInt(json, "ds4Count", &preferences.ds4Count)) {
+                preferences.ds4Count = 0;
+            }
+
+            if (!MTY_JSONObjGetBool(json, "kickInputFlood", &preferences.kickInputFlood)) {
+                preferences.kickInputFlood = false;
+            }
+
+            if (!MTY_JSONObjGetUInt(json, "idleReclaimSeconds", &preferences.idleReclaimSeconds)) {
+                preferences.idleReclaimSeconds = 0;
+            }
+
+            if (!MTY_JSONObjGetUInt(json, "idleExemptTier", &preferences.idleExemptTier)) {
+                preferences.idleExemptTier = 1;
+            }
             
             preferences.isValid = true;
 
@@ -198,6 +233,11 @@ bool MetadataCache::savePreferences(MetadataCache::Preferences preferences)
         MTY_JSONObjSetInt(json, "windowY", preferences.windowY);
         MTY_JSONObjSetUInt(json, "windowW", preferences.windowW);
         MTY_JSONObjSetUInt(json, "windowH", preferences.windowH);
+        MTY_JSONObjSetUInt(json, "xboxCount", preferences.xboxCount);
+        MTY_JSONObjSetUInt(json, "ds4Count", preferences.ds4Count);
+        MTY_JSONObjSetBool(json, "kickInputFlood", preferences.kickInputFlood);
+        MTY_JSONObjSetUInt(json, "idleReclaimSeconds", preferences.idleReclaimSeconds);
+        MTY_JSONObjSetUInt(json, "idleExemptTier", preferences.idleExemptTier);
 
         MTY_JSONWriteFile(filepath.c_str(), json);
         MTY_JSONDestroy(&json);
@@ -273,10 +313,10 @@ bool MetadataCache::saveBannedUsers(vector<GuestData> guests)
             MTY_JSONArrayAppendItem(json, guest);
         }
 
-        MTY_JSONWriteFile(filepath.c_str(), json);
+        bool success = writeJsonAtomic(filepath, json);
         MTY_JSONDestroy(&json);
 
-        return true;
+        return success;
     }
 
     return false;
@@ -300,7 +340,6 @@ vector<GuestTier> MetadataCache::loadGuestTiers()
             {
                 const MTY_JSON* guest = MTY_JSONArrayGetItem(json, i);
 
-                char name[128] = "";
                 uint32_t userID, tier = 0;
                 bool tierSuccess = MTY_JSONObjGetUInt(guest, "tier", &tier);
                 bool userIDSuccess = MTY_JSONObjGetUInt(guest, "userID", &userID);
@@ -342,10 +381,10 @@ bool MetadataCache::saveGuestTiers(vector<GuestTier> guestTiers)
             MTY_JSONArrayAppendItem(json, guest);
         }
 
-        MTY_JSONWriteFile(filepath.c_str(), json);
+        bool success = writeJsonAtomic(filepath, json);
         MTY_JSONDestroy(&json);
 
-        return true;
+        return success;
     }
 
     return false;
@@ -354,12 +393,10 @@ bool MetadataCache::saveGuestTiers(vector<GuestTier> guestTiers)
 
 string MetadataCache::getUserDir()
 {
-    TCHAR tAppdata[1024];
-    if (SUCCEEDED(SHGetFolderPath(nullptr, CSIDL_APPDATA, NULL, 0, tAppdata)))
+    string appdata = getAppDataDir();
+    if (!appdata.empty())
     {
-        wstring wAppdata(tAppdata);
-        string appdata(wAppdata.begin(), wAppdata.end());
-        string dirPath = appdata + "\\ParsecSoda\\";
+        string dirPath = appdata + USER_DIR_NAME;
         
         bool isDirOk = false;
 
@@ -382,4 +419,69 @@ string MetadataCache::getUserDir()
     }
 
     return string();
-}
\ No newline at end of file
+}
+
+string MetadataCache::getSessionLogDir()
+{
+    string userDir = getUserDir();
+    if (userDir.empty())
+    {
+        return "";
+    }
+
+    string dirPath = userDir + SESSION_LOG_DIRNAME PATH_SEPARATOR;
+    if (!MTY_FileExists(dirPath.c_str()) && !MTY_Mkdir(dirPath.c_str()))
+    {
+        return "";
+    }
+
+    return dirPath;
+}
+
+bool MetadataCache::writeJsonAtomic(string path, const MTY_JSON* json)
+{
+    // Readers only ever see the old file or the new one, never half of it.
+    const string tempPath = path + METADATA_TEMP_SUFFIX;
+    if (!MTY_JSONWriteFile(tempPath.c_str(), json))
+    {
+        return false;
+    }
+
+#if defined(_WIN32)
+    if (!MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+#else
+    if (rename(tempPath.c_str(), path.c_str()) != 0)
+#endif
+    {
+        MTY_DeleteFile(tempPath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+string MetadataCache::getAppDataDir()
+{
+#if defined(_WIN32)
+    TCHAR tAppdata[1024];
+    if (SUCCEEDED(SHGetFolderPath(nullptr, CSIDL_APPDATA, NULL, 0, tAppdata)))
+    {
+        wstring wAppdata(tAppdata);
+        return string(wAppdata.begin(), wAppdata.end());
+    }
+#else
+    const char* config = getenv("XDG_CONFIG_HOME");
+    if (config != nullptr && config[0] != '\0')
+    {
+        return string(config);
+    }
+
+    const char* home = getenv("HOME");
+    if (home != nullptr && home[0] != '\0')
+    {
+        return string(home) + "/.config";
+    }
+#endif
+
+    return string();
+}
@@ -3,11 +3,10 @@
 #include <string>
 #include <vector>
 #include <algorithm>
-#include <Windows.h>
-#include <ShlObj.h>
 #include "matoya.h"
 #include "GuestData.h"
 #include "GuestTier.h"
+#include "SessionLogFormat.h"
 
 using namespace std;
 
@@ -41,6 +40,11 @@ public:
 		int windowY = 0;
 		unsigned int windowW = 1280;
 		unsigned int windowH = 720;
+		unsigned int xboxCount = 4;
+		unsigned int ds4Count = 0;
+		bool kickInputFlood = false;
+		unsigned int idleReclaimSeconds = 0;
+		unsigned int idleExemptTier = 1;
 	};
 
 	static SessionCache loadSessionCache();
@@ -56,11 +60,19 @@ public:
 	static vector<GuestTier> loadGuestTiers();
 	static bool saveGuestTiers(vector<GuestTier> guestTiers);
 
+	static string getUserDir();
+	/** Where SessionLog keeps its files, created on first use; empty if it can't be. */
+	static string getSessionLogDir();
+
+	/** Writes to a temp file next to path, then swaps it in. */
+	static bool writeJsonAtomic(string path, const MTY_JSON* json);
+
 	static Preferences preferences;
 
-private:
-	static string getUserDir();
-	
+private:	
+	/** Per-user config root: %APPDATA% on Windows, $XDG_CONFIG_HOME or ~/.config elsewhere. */
+	static string getAppDataDir();
+
 	// This is not ideal, especially in an open source environment.
 	// I'm using these values just as placeholders until I find an
 	// actual solution. You should change them in your build.
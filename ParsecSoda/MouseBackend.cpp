@@ -0,0 +1,106 @@
+#include "MouseBackend.h"
+#include <Windows.h>
+
+// =============================================================
+//
+//  SendInputMouseBackend
+//
+// =============================================================
+
+void SendInputMouseBackend::move(int32_t dx, int32_t dy)
+{
+	send(dx, dy, 0, MOUSEEVENTF_MOVE);
+}
+
+void SendInputMouseBackend::moveTo(int32_t x, int32_t y)
+{
+	// Absolute coordinates are normalized to [0, 65535] over the whole virtual desktop.
+	const int left = GetSystemMetrics(SM_XVIRTUALSCREEN);
+	const int top = GetSystemMetrics(SM_YVIRTUALSCREEN);
+	const int width = GetSystemMetrics(SM_CXVIRTUALSCREEN);
+	const int height = GetSystemMetrics(SM_CYVIRTUALSCREEN);
+	if (width <= 1 || height <= 1)
+	{
+		return;
+	}
+
+	const LONG nx = (LONG)(((int64_t)(x - left) * 65535) / (width - 1));
+	const LONG ny = (LONG)(((int64_t)(y - top) * 65535) / (height - 1));
+	send(nx, ny, 0, MOUSEEVENTF_MOVE | MOUSEEVENTF_ABSOLUTE | MOUSEEVENTF_VIRTUALDESK);
+}
+
+void SendInputMouseBackend::button(ParsecMouseButton button, bool pressed)
+{
+	switch (button)
+	{
+	case MOUSE_L:		send(0, 0, 0, pressed ? MOUSEEVENTF_LEFTDOWN : MOUSEEVENTF_LEFTUP);			break;
+	case MOUSE_MIDDLE:	send(0, 0, 0, pressed ? MOUSEEVENTF_MIDDLEDOWN : MOUSEEVENTF_MIDDLEUP);		break;
+	case MOUSE_R:		send(0, 0, 0, pressed ? MOUSEEVENTF_RIGHTDOWN : MOUSEEVENTF_RIGHTUP);		break;
+	case MOUSE_X1:		send(0, 0, XBUTTON1, pressed ? MOUSEEVENTF_XDOWN : MOUSEEVENTF_XUP);		break;
+	case MOUSE_X2:		send(0, 0, XBUTTON2, pressed ? MOUSEEVENTF_XDOWN : MOUSEEVENTF_XUP);		break;
+	default:																						break;
+	}
+}
+
+void SendInputMouseBackend::wheel(int32_t x, int32_t y)
+{
+	// Parsec: negative y scrolls up. Windows: positive wheel data scrolls up.
+	if (y != 0) send(0, 0, (uint32_t)(-y), MOUSEEVENTF_WHEEL);
+	if (x != 0) send(0, 0, (uint32_t)x, MOUSEEVENTF_HWHEEL);
+}
+
+void SendInputMouseBackend::send(int32_t dx, int32_t dy, uint32_t mouseData, uint32_t flags)
+{
+	INPUT input = {};
+	input.type = INPUT_MOUSE;
+	input.mi.dx = dx;
+	input.mi.dy = dy;
+	input.mi.mouseData = mouseData;
+	input.mi.dwFlags = flags;
+	SendInput(1, &input, sizeof(INPUT));
+}
+
+
+// =============================================================
+//
+//  RecordingMouseBackend
+//
+// =============================================================
+
+void RecordingMouseBackend::move(int32_t dx, int32_t dy)
+{
+	push(Action::MOVE, dx, dy);
+}
+
+void RecordingMouseBackend::moveTo(int32_t x, int32_t y)
+{
+	push(Action::MOVE_TO, x, y);
+}
+
+void RecordingMouseBackend::button(ParsecMouseButton button, bool pressed)
+{
+	push(Action::BUTTON, (int32_t)button, 0, pressed);
+}
+
+void RecordingMouseBackend::wheel(int32_t x, int32_t y)
+{
+	push(Action::WHEEL, x, y);
+}
+
+const vector<RecordingMouseBackend::Event> RecordingMouseBackend::getEvents()
+{
+	lock_guard<mutex> lock(_mutex);
+	return _events;
+}
+
+void RecordingMouseBackend::clear()
+{
+	lock_guard<mutex> lock(_mutex);
+	_events.clear();
+}
+
+void RecordingMouseBackend::push(Action action, int32_t x, int32_t y, bool pressed)
+{
+	lock_guard<mutex> lock(_mutex);
+	_events.push_back(Event{ action, x, y, pressed });
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <mutex>
+#include "parsec-dso.h"
+
+using namespace std;
+
+/**
+ * Where routed guest mouse input ends up.
+ * SendInputMouseBackend drives the host cursor; RecordingMouseBackend is a
+ * stand-in that only remembers what it was asked to do.
+ */
+class MouseBackend
+{
+public:
+	virtual ~MouseBackend() {}
+	virtual void move(int32_t dx, int32_t dy) = 0;
+	virtual void moveTo(int32_t x, int32_t y) = 0;
+	virtual void button(ParsecMouseButton button, bool pressed) = 0;
+	virtual void wheel(int32_t x, int32_t y) = 0;
+};
+
+class SendInputMouseBackend : public MouseBackend
+{
+public:
+	void move(int32_t dx, int32_t dy) override;
+	void moveTo(int32_t x, int32_t y) override;
+	void button(ParsecMouseButton button, bool pressed) override;
+	void wheel(int32_t x, int32_t y) override;
+
+private:
+	void send(int32_t dx, int32_t dy, uint32_t mouseData, uint32_t flags);
+};
+
+class RecordingMouseBackend : public MouseBackend
+{
+public:
+	enum class Action
+	{
+		MOVE,
+		MOVE_TO,
+		BUTTON,
+		WHEEL
+	};
+
+	class Event
+	{
+	public:
+		Action action;
+		int32_t x;
+		int32_t y;
+		bool pressed;
+	};
+
+	void move(int32_t dx, int32_t dy) override;
+	void moveTo(int32_t x, int32_t y) override;
+	void button(ParsecMouseButton button, bool pressed) override;
+	void wheel(int32_t x, int32_t y) override;
+
+	const vector<Event> getEvents();
+	void clear();
+
+private:
+	void push(Action action, int32_t x, int32_t y, bool pressed = false);
+
+	vector<Event> _events;
+	mutex _mutex;
+};
@@ -0,0 +1,160 @@
+#include "MouseRouter.h"
+
+MouseRouter::MouseRouter()
+	: _backend(&_defaultBackend)
+{
+}
+
+void MouseRouter::setBackend(MouseBackend* backend)
+{
+	_backend = (backend != nullptr) ? backend : &_defaultBackend;
+}
+
+bool MouseRouter::route(uint32_t userID, const ParsecMessage& message)
+{
+	if (message.type != MESSAGE_MOUSE_BUTTON && message.type != MESSAGE_MOUSE_WHEEL && message.type != MESSAGE_MOUSE_MOTION)
+	{
+		return false;
+	}
+
+	_received++;
+
+	if (userID == MOUSE_HOLDER_NONE || userID != _holder)
+	{
+		return true;
+	}
+
+	// Motion summed for the previous holder must not land after the handoff.
+	if (_pendingFrom != userID)
+	{
+		discardPending();
+		_pendingFrom = userID;
+	}
+
+	switch (message.type)
+	{
+	case MESSAGE_MOUSE_MOTION:
+		if (message.mouseMotion.relative)
+		{
+			_dx += message.mouseMotion.x;
+			_dy += message.mouseMotion.y;
+		}
+		else
+		{
+			flush();
+			_backend->moveTo(message.mouseMotion.x, message.mouseMotion.y);
+			_injected++;
+		}
+		break;
+
+	case MESSAGE_MOUSE_WHEEL:
+		_wheelX += message.mouseWheel.x;
+		_wheelY += message.mouseWheel.y;
+		break;
+
+	case MESSAGE_MOUSE_BUTTON:
+		flush();
+		_backend->button(message.mouseButton.button, message.mouseButton.pressed);
+		_injected++;
+		break;
+
+	default:
+		break;
+	}
+
+	return true;
+}
+
+void MouseRouter::flush()
+{
+	if (_pendingFrom != _holder)
+	{
+		discardPending();
+		return;
+	}
+
+	if (_dx != 0 || _dy != 0)
+	{
+		_backend->move(_dx, _dy);
+		_injected++;
+		_dx = _dy = 0;
+	}
+
+	if (_wheelX != 0 || _wheelY != 0)
+	{
+		_backend->wheel(_wheelX, _wheelY);
+		_injected++;
+		_wheelX = _wheelY = 0;
+	}
+}
+
+bool MouseRouter::togglePermission(uint32_t userID)
+{
+	lock_guard<mutex> lock(_permittedMutex);
+
+	if (_permitted.erase(userID) > 0)
+	{
+		uint32_t holder = userID;
+		_holder.compare_exchange_strong(holder, MOUSE_HOLDER_NONE);
+		return false;
+	}
+
+	_permitted.insert(userID);
+	uint32_t none = MOUSE_HOLDER_NONE;
+	_holder.compare_exchange_strong(none, userID);
+	return true;
+}
+
+bool MouseRouter::isPermitted(uint32_t userID)
+{
+	lock_guard<mutex> lock(_permittedMutex);
+	return _permitted.find(userID) != _permitted.end();
+}
+
+bool MouseRouter::grab(uint32_t userID)
+{
+	if (!isPermitted(userID))
+	{
+		return false;
+	}
+
+	_holder = userID;
+	return true;
+}
+
+void MouseRouter::release()
+{
+	_holder = MOUSE_HOLDER_NONE;
+}
+
+void MouseRouter::onGuestLeft(uint32_t userID)
+{
+	uint32_t holder = userID;
+	_holder.compare_exchange_strong(holder, MOUSE_HOLDER_NONE);
+}
+
+uint32_t MouseRouter::getHolder() const
+{
+	return _holder;
+}
+
+const MouseRouter::Stats MouseRouter::getStats() const
+{
+	Stats stats;
+	stats.received = _received;
+	stats.injected = _injected;
+	return stats;
+}
+
+
+// =============================================================
+//
+//  Private
+//
+// =============================================================
+
+void MouseRouter::discardPending()
+{
+	_dx = _dy = 0;
+	_wheelX = _wheelY = 0;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
+#include "parsec-dso.h"
+#include "MouseBackend.h"
+
+#define MOUSE_HOLDER_NONE 0
+
+using namespace std;
+
+/**
+ * Routes guest mouse messages to a MouseBackend.
+ * Only guests with permission can hold the mouse, and only the current holder
+ * drives it. Relative motion and wheel deltas are summed between flush() calls
+ * and injected once per tick; buttons and absolute moves flush first so the
+ * order of events is kept.
+ */
+class MouseRouter
+{
+public:
+	class Stats
+	{
+	public:
+		uint64_t received = 0;
+		uint64_t injected = 0;
+	};
+
+	MouseRouter();
+	void setBackend(MouseBackend* backend);
+
+	/** @returns true if the message was a mouse message (routed or not). */
+	bool route(uint32_t userID, const ParsecMessage& message);
+	void flush();
+
+	bool togglePermission(uint32_t userID);
+	bool isPermitted(uint32_t userID);
+	bool grab(uint32_t userID);
+	void release();
+	void onGuestLeft(uint32_t userID);
+	uint32_t getHolder() const;
+	const Stats getStats() const;
+
+private:
+	void discardPending();
+
+	SendInputMouseBackend _defaultBackend;
+	MouseBackend* _backend;
+
+	atomic<uint32_t> _holder { MOUSE_HOLDER_NONE };
+	unordered_set<uint32_t> _permitted;
+	mutex _permittedMutex;
+
+	int32_t _dx = 0;
+	int32_t _dy = 0;
+	int32_t _wheelX = 0;
+	int32_t _wheelY = 0;
+	uint32_t _pendingFrom = MOUSE_HOLDER_NONE;
+
+	atomic<uint64_t> _received { 0 };
+	atomic<uint64_t> _injected { 0 };
+};
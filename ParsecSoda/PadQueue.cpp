@@ -0,0 +1,328 @@
+#include "PadQueue.h"
+#include "MetadataCache.h"
+
+size_t PadQueue::join(const Guest& guest, uint32_t deviceID, bool isKeyboard)
+{
+	lock_guard<mutex> lock(_mutex);
+
+	unordered_map<uint32_t, list<Entry>::iterator>::iterator it = _index.find(guest.userID);
+	if (it != _index.end())
+	{
+		return 0;
+	}
+
+	Entry entry;
+	entry.userID = guest.userID;
+	entry.name = guest.name;
+	entry.deviceID = deviceID;
+	entry.isKeyboard = isKeyboard;
+	_entries.push_back(entry);
+	_index[guest.userID] = prev(_entries.end());
+
+	return _entries.size();
+}
+
+bool PadQueue::leave(uint32_t userID)
+{
+	lock_guard<mutex> lock(_mutex);
+
+	unordered_map<uint32_t, list<Entry>::iterator>::iterator it = _index.find(userID);
+	if (it == _index.end())
+	{
+		return false;
+	}
+
+	_entries.erase((*it).second);
+	_index.erase(it);
+	return true;
+}
+
+bool PadQueue::pop(Entry& entry)
+{
+	lock_guard<mutex> lock(_mutex);
+
+	if (_entries.empty())
+	{
+		return false;
+	}
+
+	entry = _entries.front();
+	_index.erase(entry.userID);
+	_entries.pop_front();
+	return true;
+}
+
+bool PadQueue::popFirst(function<bool(const Entry&)> isEligible, Entry& entry)
+{
+	lock_guard<mutex> lock(_mutex);
+
+	list<Entry>::iterator ei = _entries.begin();
+	for (; ei != _entries.end(); ++ei)
+	{
+		if (isEligible(*ei))
+		{
+			entry = *ei;
+			_index.erase(entry.userID);
+			_entries.erase(ei);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+size_t PadQueue::prune(function<bool(const Entry&)> isEligible)
+{
+	lock_guard<mutex> lock(_mutex);
+
+	size_t pruned = 0;
+	list<Entry>::iterator ei = _entries.begin();
+	while (ei != _entries.end())
+	{
+		if (isEligible(*ei))
+		{
+			++ei;
+		}
+		else
+		{
+			_index.erase((*ei).userID);
+			ei = _entries.erase(ei);
+			pruned++;
+		}
+	}
+
+	return pruned;
+}
+
+bool PadQueue::isEmpty()
+{
+	lock_guard<mutex> lock(_mutex);
+	return _entries.empty();
+}
+
+bool PadQueue::isFront(uint32_t userID)
+{
+	lock_guard<mutex> lock(_mutex);
+	return !_entries.empty() && _entries.front().userID == userID;
+}
+
+size_t PadQueue::position(uint32_t userID)
+{
+	lock_guard<mutex> lock(_mutex);
+
+	if (_index.find(userID) == _index.end())
+	{
+		return 0;
+	}
+
+	size_t position = 1;
+	list<Entry>::iterator ei = _entries.begin();
+	for (; ei != _entries.end() && (*ei).userID != userID; ++ei)
+	{
+		position++;
+	}
+	return position;
+}
+
+size_t PadQueue::size()
+{
+	lock_guard<mutex> lock(_mutex);
+	return _entries.size();
+}
+
+const vector<PadQueue::Entry> PadQueue::getEntries()
+{
+	lock_guard<mutex> lock(_mutex);
+	return vector<Entry>(_entries.begin(), _entries.end());
+}
+
+void PadQueue::clear()
+{
+	lock_guard<mutex> lock(_mutex);
+	_entries.clear();
+	_index.clear();
+}
+
+void PadQueue::setRotation(size_t padIndex, uint32_t seconds)
+{
+	lock_guard<mutex> lock(_mutex);
+
+	if (padIndex >= _rotationSeconds.size())
+	{
+		_rotationSeconds.resize(padIndex + 1, 0);
+	}
+	_rotationSeconds[padIndex] = seconds;
+}
+
+uint32_t PadQueue::getRotation(size_t padIndex)
+{
+	lock_guard<mutex> lock(_mutex);
+	return padIndex < _rotationSeconds.size() ? _rotationSeconds[padIndex] : 0;
+}
+
+bool PadQueue::hasRotation()
+{
+	lock_guard<mutex> lock(_mutex);
+
+	vector<uint32_t>::iterator ri = _rotationSeconds.begin();
+	for (; ri != _rotationSeconds.end(); ++ri)
+	{
+		if (*ri > 0) return true;
+	}
+	return false;
+}
+
+void PadQueue::notify(string notice)
+{
+	lock_guard<mutex> lock(_mutex);
+	_notices.push_back(notice);
+}
+
+bool PadQueue::popNotice(string& notice)
+{
+	lock_guard<mutex> lock(_mutex);
+
+	if (_notices.empty())
+	{
+		return false;
+	}
+
+	notice = _notices.front();
+	_notices.erase(_notices.begin());
+	return true;
+}
+
+bool PadQueue::save(string path)
+{
+	vector<Entry> entries;
+	vector<uint32_t> rotationSeconds;
+	{
+		lock_guard<mutex> lock(_mutex);
+		entries.assign(_entries.begin(), _entries.end());
+		rotationSeconds = _rotationSeconds;
+	}
+
+	if (_persistence == nullptr)
+	{
+		return write(path, entries, rotationSeconds);
+	}
+
+	_persistence->submit(PersistenceWorker::Target::PAD_QUEUE, [path, entries, rotationSeconds]() {
+		return write(path, entries, rotationSeconds);
+	});
+	return true;
+}
+
+size_t PadQueue::load(string path)
+{
+	if (!MTY_FileExists(path.c_str()))
+	{
+		return 0;
+	}
+
+	MTY_JSON* json = MTY_JSONReadFile(path.c_str());
+	if (json == nullptr)
+	{
+		return 0;
+	}
+
+	lock_guard<mutex> lock(_mutex);
+	_entries.clear();
+	_index.clear();
+	_rotationSeconds.clear();
+
+	const MTY_JSON* queue = MTY_JSONObjGetItem(json, "queue");
+	uint32_t size = (queue != nullptr) ? MTY_JSONGetLength(queue) : 0;
+	for (uint32_t i = 0; i < size; i++)
+	{
+		const MTY_JSON* item = MTY_JSONArrayGetItem(queue, i);
+
+		char name[128] = "";
+		Entry entry;
+		if (
+			MTY_JSONObjGetUInt(item, "userID", &entry.userID) &&
+			_index.find(entry.userID) == _index.end()
+		)
+		{
+			MTY_JSONObjGetString(item, "name", name, 128);
+			MTY_JSONObjGetUInt(item, "deviceID", &entry.deviceID);
+			MTY_JSONObjGetBool(item, "isKeyboard", &entry.isKeyboard);
+			entry.name = name;
+
+			_entries.push_back(entry);
+			_index[entry.userID] = prev(_entries.end());
+		}
+	}
+
+	const MTY_JSON* rotation = MTY_JSONObjGetItem(json, "rotation");
+	size = (rotation != nullptr) ? MTY_JSONGetLength(rotation) : 0;
+	for (uint32_t i = 0; i < size; i++)
+	{
+		const MTY_JSON* item = MTY_JSONArrayGetItem(rotation, i);
+
+		uint32_t pad = 0, seconds = 0;
+		if (
+			MTY_JSONObjGetUInt(item, "pad", &pad) && MTY_JSONObjGetUInt(item, "seconds", &seconds) &&
+			pad < GAMEPAD_QUEUE_MAX_PADS
+		)
+		{
+			if (pad >= _rotationSeconds.size())
+			{
+				_rotationSeconds.resize(pad + 1, 0);
+			}
+			_rotationSeconds[pad] = seconds;
+		}
+	}
+
+	MTY_JSONDestroy(&json);
+	return _entries.size();
+}
+
+void PadQueue::setPersistence(PersistenceWorker* persistence)
+{
+	_persistence = persistence;
+}
+
+
+// =============================================================
+//
+//  Private
+//
+// =============================================================
+
+bool PadQueue::write(string path, const vector<Entry> entries, const vector<uint32_t> rotationSeconds)
+{
+	MTY_JSON* json = MTY_JSONObjCreate();
+	MTY_JSON* queue = MTY_JSONArrayCreate();
+	MTY_JSON* rotation = MTY_JSONArrayCreate();
+
+	vector<Entry>::const_iterator ei = entries.begin();
+	for (; ei != entries.end(); ++ei)
+	{
+		MTY_JSON* entry = MTY_JSONObjCreate();
+		MTY_JSONObjSetUInt(entry, "userID", (*ei).userID);
+		MTY_JSONObjSetString(entry, "name", (*ei).name.c_str());
+		MTY_JSONObjSetUInt(entry, "deviceID", (*ei).deviceID);
+		MTY_JSONObjSetBool(entry, "isKeyboard", (*ei).isKeyboard);
+		MTY_JSONArrayAppendItem(queue, entry);
+	}
+
+	for (uint32_t i = 0; i < rotationSeconds.size(); i++)
+	{
+		if (rotationSeconds[i] > 0)
+		{
+			MTY_JSON* pad = MTY_JSONObjCreate();
+			MTY_JSONObjSetUInt(pad, "pad", i);
+			MTY_JSONObjSetUInt(pad, "seconds", rotationSeconds[i]);
+			MTY_JSONArrayAppendItem(rotation, pad);
+		}
+	}
+
+	MTY_JSONObjSetItem(json, "queue", queue);
+	MTY_JSONObjSetItem(json, "rotation", rotation);
+
+	bool success = MetadataCache::writeJsonAtomic(path, json);
+	MTY_JSONDestroy(&json);
+
+	return success;
+}
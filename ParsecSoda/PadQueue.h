@@ -0,0 +1,74 @@
+#pragma once
+
+#include <string>
+#include <list>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <functional>
+#include "matoya.h"
+#include "Guest.h"
+#include "PersistenceWorker.h"
+
+#define PAD_QUEUE_FILENAME "padqueue.json"
+#define GAMEPAD_QUEUE_MAX_PADS 64
+
+using namespace std;
+
+/**
+ * First come, first served line for gamepads in a full room.
+ * Guests join with !queue or by pressing a face button while every pad is
+ * taken; GamepadClient hands the next free pad to the front in O(1). Guests
+ * restored from disk who haven't reconnected yet are skipped, not dropped.
+ * Pads can also rotate: after their rotation time the holder goes to the back
+ * of the line and the front takes over. Joins and handoffs leave a notice for
+ * the event thread to announce, since the input thread must not talk to the chat.
+ * Thread safe: joined from the input thread, served from the event thread.
+ */
+class PadQueue
+{
+public:
+	class Entry
+	{
+	public:
+		uint32_t userID = 0;
+		string name;
+		uint32_t deviceID = 0;
+		bool isKeyboard = false;
+	};
+
+	size_t join(const Guest& guest, uint32_t deviceID = 0, bool isKeyboard = false);
+	bool leave(uint32_t userID);
+	bool pop(Entry& entry);
+	bool popFirst(function<bool(const Entry&)> isEligible, Entry& entry);
+	size_t prune(function<bool(const Entry&)> isEligible);
+	bool isEmpty();
+	bool isFront(uint32_t userID);
+	size_t position(uint32_t userID);
+	size_t size();
+	const vector<Entry> getEntries();
+	void clear();
+
+	void setRotation(size_t padIndex, uint32_t seconds);
+	uint32_t getRotation(size_t padIndex);
+	bool hasRotation();
+
+	void notify(string notice);
+	bool popNotice(string& notice);
+
+	bool save(string path);
+	size_t load(string path);
+
+	/** Saves go through the worker once set; until then they are written right away. */
+	void setPersistence(PersistenceWorker* persistence);
+
+private:
+	static bool write(string path, const vector<Entry> entries, const vector<uint32_t> rotationSeconds);
+
+	list<Entry> _entries;
+	unordered_map<uint32_t, list<Entry>::iterator> _index;
+	vector<string> _notices;
+	vector<uint32_t> _rotationSeconds;
+	PersistenceWorker* _persistence = nullptr;
+	mutex _mutex;
+};
@@ -0,0 +1,240 @@
+#include "PersistenceWorker.h"
+
+PersistenceWorker::~PersistenceWorker()
+{
+	stop();
+}
+
+void PersistenceWorker::start()
+{
+	lock_guard<mutex> lock(_mutex);
+	if (_isRunning)
+	{
+		return;
+	}
+
+	_isRunning = true;
+	_thread = thread([this]() { run(); });
+}
+
+void PersistenceWorker::stop()
+{
+	{
+		lock_guard<mutex> lock(_mutex);
+		if (!_isRunning)
+		{
+			return;
+		}
+		_isRunning = false;
+	}
+
+	_wake.notify_all();
+	if (_thread.joinable())
+	{
+		_thread.join();
+	}
+}
+
+void PersistenceWorker::submit(Target target, Write write)
+{
+	const size_t index = (size_t)target;
+	unique_lock<mutex> lock(_mutex);
+	_stats[index].submitted++;
+
+	if (!_isRunning)
+	{
+		// Nobody to hand it to: write now, as the lists always used to.
+		lock.unlock();
+		const uint64_t start = nowUs();
+		const bool success = write();
+		const uint64_t elapsed = nowUs() - start;
+		lock.lock();
+
+		record(index, success, elapsed);
+		return;
+	}
+
+	const uint64_t now = nowUs();
+	if (!hasPending())
+	{
+		_firstPendingUs = now;
+	}
+	_lastPendingUs = now;
+	_pending[index] = write;
+
+	_wake.notify_all();
+}
+
+void PersistenceWorker::flush()
+{
+	unique_lock<mutex> lock(_mutex);
+	if (!_isRunning)
+	{
+		return;
+	}
+
+	_isFlushRequested = true;
+	_wake.notify_all();
+	_idle.wait(lock, [this]() { return !_isRunning || (!hasPending() && !_isWriting); });
+}
+
+bool PersistenceWorker::isRunning()
+{
+	lock_guard<mutex> lock(_mutex);
+	return _isRunning;
+}
+
+const PersistenceWorker::Stats PersistenceWorker::getStats(Target target)
+{
+	lock_guard<mutex> lock(_mutex);
+	return _stats[(size_t)target];
+}
+
+const string PersistenceWorker::report()
+{
+	lock_guard<mutex> lock(_mutex);
+
+	std::ostringstream reply;
+	reply << "[Persistence] | " << (_isRunning ? "Writing in the background" : "Writing inline");
+
+	for (size_t i = 0; i < (size_t)Target::COUNT; i++)
+	{
+		const Stats& stats = _stats[i];
+		reply << "\n  " << targetName((Target)i) << ":\t"
+			<< stats.writes << " writes for " << stats.submitted << " changes";
+
+		if (stats.failures > 0)
+		{
+			reply << ", " << stats.failures << " failed";
+		}
+
+		if (stats.writes > 0)
+		{
+			reply << ", last " << (stats.lastUs / 1000.0) << " ms"
+				<< ", avg " << ((double)stats.totalUs / stats.writes / 1000.0) << " ms"
+				<< ", max " << (stats.maxUs / 1000.0) << " ms";
+		}
+	}
+
+	return reply.str();
+}
+
+const char* PersistenceWorker::targetName(Target target)
+{
+	switch (target)
+	{
+	case Target::BANS:			return "Bans";
+	case Target::TIERS:			return "Tiers";
+	case Target::PREFERENCES:	return "Preferences";
+	case Target::PAD_QUEUE:		return "Pad queue";
+	default:					return "?";
+	}
+}
+
+
+// =============================================================
+//
+//  Private
+//
+// =============================================================
+
+void PersistenceWorker::run()
+{
+	unique_lock<mutex> lock(_mutex);
+
+	while (true)
+	{
+		_wake.wait(lock, [this]() { return !_isRunning || hasPending(); });
+
+		// Let a burst settle, but don't let a steady trickle hold writes back forever.
+		while (_isRunning && !_isFlushRequested && hasPending())
+		{
+			const uint64_t now = nowUs();
+			const uint64_t quietAt = _lastPendingUs + PERSISTENCE_COALESCE_MS * 1000ULL;
+			const uint64_t deadline = _firstPendingUs + PERSISTENCE_MAX_DELAY_MS * 1000ULL;
+			const uint64_t dueAt = (quietAt < deadline) ? quietAt : deadline;
+			if (now >= dueAt)
+			{
+				break;
+			}
+			_wake.wait_for(lock, chrono::microseconds(dueAt - now));
+		}
+
+		if (!hasPending())
+		{
+			_isFlushRequested = false;
+			_idle.notify_all();
+			if (!_isRunning)
+			{
+				break;
+			}
+			continue;
+		}
+
+		Write writes[(size_t)Target::COUNT];
+		for (size_t i = 0; i < (size_t)Target::COUNT; i++)
+		{
+			writes[i].swap(_pending[i]);
+		}
+		_isWriting = true;
+		lock.unlock();
+
+		uint64_t elapsed[(size_t)Target::COUNT] = {};
+		bool success[(size_t)Target::COUNT] = {};
+		for (size_t i = 0; i < (size_t)Target::COUNT; i++)
+		{
+			if (writes[i])
+			{
+				const uint64_t start = nowUs();
+				success[i] = writes[i]();
+				elapsed[i] = nowUs() - start;
+			}
+		}
+
+		lock.lock();
+		for (size_t i = 0; i < (size_t)Target::COUNT; i++)
+		{
+			if (writes[i])
+			{
+				record(i, success[i], elapsed[i]);
+			}
+		}
+		_isWriting = false;
+
+		if (!hasPending())
+		{
+			_isFlushRequested = false;
+			_idle.notify_all();
+		}
+	}
+}
+
+void PersistenceWorker::record(size_t index, bool success, uint64_t elapsedUs)
+{
+	Stats& stats = _stats[index];
+	stats.writes++;
+	stats.failures += success ? 0 : 1;
+	stats.lastUs = elapsedUs;
+	stats.maxUs = (elapsedUs > stats.maxUs) ? elapsedUs : stats.maxUs;
+	stats.totalUs += elapsedUs;
+}
+
+bool PersistenceWorker::hasPending() const
+{
+	for (size_t i = 0; i < (size_t)Target::COUNT; i++)
+	{
+		if (_pending[i])
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+uint64_t PersistenceWorker::nowUs()
+{
+	return (uint64_t)chrono::duration_cast<chrono::microseconds>(
+		chrono::steady_clock::now().time_since_epoch()
+	).count();
+}
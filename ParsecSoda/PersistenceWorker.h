@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <sstream>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#define PERSISTENCE_COALESCE_MS 250
+#define PERSISTENCE_MAX_DELAY_MS 1000
+
+using namespace std;
+
+/**
+ * Writes metadata files on its own thread, so a !ban, a tier change or a
+ * !transform never waits on the disk. Callers hand over a write that owns a
+ * snapshot of the data; a newer write for the same target replaces the
+ * pending one, so a burst of bans costs a single file rewrite. Pending writes go out once
+ * things have been quiet for PERSISTENCE_COALESCE_MS, and never later than
+ * PERSISTENCE_MAX_DELAY_MS after the first one came in.
+ *
+ * Before start() and after stop(), submit() writes right away on the caller's thread.
+ */
+class PersistenceWorker
+{
+public:
+	enum class Target
+	{
+		BANS = 0,
+		TIERS,
+		PREFERENCES,
+		PAD_QUEUE,
+		COUNT
+	};
+
+	class Stats
+	{
+	public:
+		uint32_t submitted = 0;
+		uint32_t writes = 0;
+		uint32_t failures = 0;
+		uint64_t lastUs = 0;
+		uint64_t maxUs = 0;
+		uint64_t totalUs = 0;
+	};
+
+	typedef function<bool()> Write;
+
+	~PersistenceWorker();
+
+	void start();
+	/** Writes whatever is still pending, then joins the thread. */
+	void stop();
+	void submit(Target target, Write write);
+	/** Blocks until every write submitted so far is on disk. */
+	void flush();
+	bool isRunning();
+
+	const Stats getStats(Target target);
+	const string report();
+
+	static const char* targetName(Target target);
+
+private:
+	void run();
+	void record(size_t index, bool success, uint64_t elapsedUs);
+	bool hasPending() const;
+	static uint64_t nowUs();
+
+	Write _pending[(size_t)Target::COUNT];
+	Stats _stats[(size_t)Target::COUNT];
+	uint64_t _firstPendingUs = 0;
+	uint64_t _lastPendingUs = 0;
+	bool _isRunning = false;
+	bool _isWriting = false;
+	bool _isFlushRequested = false;
+
+	thread _thread;
+	mutex _mutex;
+	condition_variable _wake;
+	condition_variable _idle;
+};
@@ -0,0 +1,160 @@
+#include "RumbleForwarder.h"
+
+RumbleForwarder::~RumbleForwarder()
+{
+	stop();
+}
+
+void RumbleForwarder::setParsec(ParsecDSO* parsec)
+{
+	_parsec = parsec;
+}
+
+void RumbleForwarder::start()
+{
+	if (_isRunning.exchange(true))
+	{
+		return;
+	}
+
+	_workerThread = thread([this]() { forwardLoop(); });
+}
+
+void RumbleForwarder::stop()
+{
+	if (!_isRunning.exchange(false))
+	{
+		return;
+	}
+
+	_signal.notify_one();
+	if (_workerThread.joinable())
+	{
+		_workerThread.join();
+	}
+
+	lock_guard<mutex> lock(_mutex);
+	_pending.clear();
+	_hasDirty = false;
+}
+
+void RumbleForwarder::submit(uint32_t guestID, uint32_t deviceID, uint8_t largeMotor, uint8_t smallMotor)
+{
+	_received++;
+
+	if (!_isRunning)
+	{
+		send(guestID, deviceID, largeMotor, smallMotor);
+		return;
+	}
+
+	const uint64_t key = ((uint64_t)guestID << 32) | deviceID;
+	const bool isStop = (largeMotor == 0 && smallMotor == 0);
+
+	{
+		lock_guard<mutex> lock(_mutex);
+		Pending& pending = _pending[key];
+		pending.guestID = guestID;
+		pending.deviceID = deviceID;
+		pending.sequence = ++_sequence;
+
+		if (isStop)
+		{
+			// Anything the worker already picked up for this device is now stale.
+			pending.stopSequence = pending.sequence;
+			pending.isDirty = false;
+		}
+		else
+		{
+			pending.largeMotor = largeMotor;
+			pending.smallMotor = smallMotor;
+			pending.isDirty = true;
+			_hasDirty = true;
+		}
+	}
+
+	if (isStop)
+	{
+		_stops++;
+		send(guestID, deviceID, 0, 0);
+	}
+	else
+	{
+		_signal.notify_one();
+	}
+}
+
+const RumbleForwarder::Stats RumbleForwarder::getStats() const
+{
+	Stats stats;
+	stats.received = _received;
+	stats.forwarded = _forwarded;
+	stats.stops = _stops;
+	return stats;
+}
+
+
+// =============================================================
+//
+//  Private
+//
+// =============================================================
+
+void RumbleForwarder::forwardLoop()
+{
+	while (_isRunning)
+	{
+		{
+			unique_lock<mutex> lock(_mutex);
+			_signal.wait(lock, [this]() { return _hasDirty || !_isRunning; });
+
+			_batch.clear();
+			unordered_map<uint64_t, Pending>::iterator it = _pending.begin();
+			for (; it != _pending.end(); ++it)
+			{
+				if ((*it).second.isDirty)
+				{
+					_batch.push_back((*it).second);
+					(*it).second.isDirty = false;
+				}
+			}
+			_hasDirty = false;
+		}
+
+		{
+			lock_guard<mutex> sendLock(_sendMutex);
+			vector<Pending>::iterator bi = _batch.begin();
+			for (; bi != _batch.end(); ++bi)
+			{
+				bool isStale = false;
+				{
+					lock_guard<mutex> lock(_mutex);
+					const uint64_t key = ((uint64_t)(*bi).guestID << 32) | (*bi).deviceID;
+					unordered_map<uint64_t, Pending>::iterator it = _pending.find(key);
+					isStale = (it != _pending.end()) && (*it).second.stopSequence > (*bi).sequence;
+				}
+
+				if (!isStale && _parsec != nullptr)
+				{
+					ParsecHostSubmitRumble(_parsec, (*bi).guestID, (*bi).deviceID, (*bi).largeMotor, (*bi).smallMotor);
+					_forwarded++;
+				}
+			}
+		}
+
+		this_thread::sleep_for(chrono::milliseconds(RUMBLE_FORWARD_INTERVAL_MS));
+	}
+}
+
+void RumbleForwarder::send(uint32_t guestID, uint32_t deviceID, uint8_t largeMotor, uint8_t smallMotor)
+{
+	if (_parsec == nullptr)
+	{
+		return;
+	}
+
+	// Serialized with the worker batch, so a stop can never be overtaken by an older value.
+	lock_guard<mutex> sendLock(_sendMutex);
+	ParsecHostSubmitRumble(_parsec, guestID, deviceID, largeMotor, smallMotor);
+	_forwarded++;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include "parsec-dso.h"
+
+#define RUMBLE_FORWARD_INTERVAL_MS 20
+
+using namespace std;
+
+/**
+ * Sits between the ViGEm notification callbacks and ParsecHostSubmitRumble.
+ * Motor updates are collapsed per (guest, device) to the latest value and sent
+ * by a worker at most once every RUMBLE_FORWARD_INTERVAL_MS. Stop commands (0, 0)
+ * skip the queue so a guest's pad never keeps buzzing after the game let go.
+ */
+class RumbleForwarder
+{
+public:
+	class Stats
+	{
+	public:
+		uint64_t received = 0;
+		uint64_t forwarded = 0;
+		uint64_t stops = 0;
+	};
+
+	~RumbleForwarder();
+	void setParsec(ParsecDSO* parsec);
+	void start();
+	void stop();
+	void submit(uint32_t guestID, uint32_t deviceID, uint8_t largeMotor, uint8_t smallMotor);
+	const Stats getStats() const;
+
+private:
+	class Pending
+	{
+	public:
+		uint32_t guestID = 0;
+		uint32_t deviceID = 0;
+		uint8_t largeMotor = 0;
+		uint8_t smallMotor = 0;
+		uint64_t sequence = 0;
+		uint64_t stopSequence = 0;
+		bool isDirty = false;
+	};
+
+	void forwardLoop();
+	void send(uint32_t guestID, uint32_t deviceID, uint8_t largeMotor, uint8_t smallMotor);
+
+	ParsecDSO* _parsec = nullptr;
+	thread _workerThread;
+	mutex _mutex;
+	mutex _sendMutex;
+	condition_variable _signal;
+	unordered_map<uint64_t, Pending> _pending;
+	vector<Pending> _batch;
+	uint64_t _sequence = 0;
+	bool _hasDirty = false;
+	atomic<bool> _isRunning { false };
+
+	atomic<uint64_t> _received { 0 };
+	atomic<uint64_t> _forwarded { 0 };
+	atomic<uint64_t> _stops { 0 };
+};
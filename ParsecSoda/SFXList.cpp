@@ -72,8 +72,6 @@ int64_t SFXList::getRemainingCooldown()
 
 SFXList::SFXPlayResult SFXList::play(const string tag)
 {
-	static wstring_convert<codecvt_utf8_utf16<wchar_t>> converter;
-
 	vector<SFX>::iterator it = _sfxList.begin();
 	for (; it != _sfxList.end(); ++it)
 	{
@@ -84,9 +82,7 @@ SFXList::SFXPlayResult SFXList::play(const string tag)
 				return SFXPlayResult::COOLDOWN;
 			}
 
-			string path = string("./sfx/custom/") + string((*it).path);
-			wstring wide = converter.from_bytes(path);
-			PlaySound(wide.c_str(), NULL, SND_FILENAME | SND_NODEFAULT | SND_ASYNC);
+			SoundPlayer::play((string("./sfx/custom/") + string((*it).path)).c_str());
 			_lastCooldown = (*it).cooldown;
 			_lastUseTimestamp = steady_clock::now();
 			return SFXPlayResult::OK;
@@ -96,7 +92,7 @@ SFXList::SFXPlayResult SFXList::play(const string tag)
     return SFXPlayResult::NOT_FOUND;
 }
 
-const string SFXList::loadedTags()
+const string& SFXList::loadedTags() const
 {
 	return _loadedTags;
 }
@@ -6,11 +6,9 @@
 #include <vector>
 #include <algorithm>
 #include <iostream>
-#include <Windows.h>
-#include <mmeapi.h>
-#include <codecvt>
 #include "Stringer.h"
 #include "matoya.h"
+#include "SoundPlayer.h"
 
 using namespace std;
 using namespace chrono;
@@ -37,7 +35,7 @@ public:
 	void init(const char* jsonPath);
 	int64_t getRemainingCooldown();
 	SFXPlayResult play(const string tag);
-	const string loadedTags();
+	const string& loadedTags() const;
 
 private:
 	steady_clock::time_point _lastUseTimestamp;
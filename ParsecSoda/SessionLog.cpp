@@ -0,0 +1,236 @@
+#include "SessionLog.h"
+#include "SessionLogReader.h"
+
+#define SESSION_LOG_BUFFER_RESERVE (64 * 1024)
+
+SessionLog::~SessionLog()
+{
+	stop();
+}
+
+bool SessionLog::start(string directory)
+{
+	return start(directory, Limits());
+}
+
+bool SessionLog::start(string directory, const Limits& limits)
+{
+	stop();
+
+	_directory = directory;
+	_limits = limits;
+	if (_directory.empty() || !openFile(now()))
+	{
+		return false;
+	}
+	pruneFiles();
+
+	_pending.clear();
+	_pending.reserve(SESSION_LOG_BUFFER_RESERVE);
+	_isRunning = true;
+
+	_writerThread = thread([this]() { writeLoop(); });
+	return true;
+}
+
+void SessionLog::stop()
+{
+	if (!_isRunning.exchange(false))
+	{
+		return;
+	}
+
+	_signal.notify_one();
+	if (_writerThread.joinable())
+	{
+		_writerThread.join();
+	}
+	_file.close();
+}
+
+const bool SessionLog::isRunning() const
+{
+	return _isRunning;
+}
+
+void SessionLog::record(SessionLogFormat::Kind kind, uint32_t userID, const char* name, const char* text)
+{
+	SessionLogFormat::RecordHeader header;
+	header.timeMs = now();
+	header.userID = userID;
+	header.kind = (uint8_t)kind;
+	header.nameLength = (uint8_t)(name != nullptr ? strnlen(name, UINT8_MAX) : 0);
+	header.textLength = (uint16_t)(text != nullptr ? strnlen(text, SESSION_LOG_MAX_TEXT) : 0);
+	header.size = (uint32_t)(sizeof(header) + header.nameLength + header.textLength);
+	header.checksum = 0;
+
+	lock_guard<mutex> lock(_mutex);
+
+	// Checked under the lock: once the writer has seen stop(), nothing more lands in _pending.
+	if (!_isRunning)
+	{
+		return;
+	}
+
+	// Falling this far behind means the disk is stuck: lose records, not the event thread.
+	if (_pending.size() + header.size > SESSION_LOG_PENDING_MAX_BYTES)
+	{
+		_stats.dropped++;
+		return;
+	}
+
+	const size_t at = _pending.size();
+	_pending.resize(at + header.size);
+	uint8_t* frame = &_pending[at];
+	memcpy(frame, &header, sizeof(header));
+	if (header.nameLength > 0)	memcpy(frame + sizeof(header), name, header.nameLength);
+	if (header.textLength > 0)	memcpy(frame + sizeof(header) + header.nameLength, text, header.textLength);
+
+	const uint32_t checksum = SessionLogFormat::checksum(frame, header.size);
+	memcpy(frame + offsetof(SessionLogFormat::RecordHeader, checksum), &checksum, sizeof(checksum));
+
+	_stats.records++;
+}
+
+const SessionLog::Stats SessionLog::getStats()
+{
+	lock_guard<mutex> lock(_mutex);
+	return _stats;
+}
+
+const string SessionLog::report()
+{
+	const Stats stats = getStats();
+
+	std::ostringstream reply;
+	reply << "[SessionLog] | " << (_isRunning ? "Recording" : "Stopped") << ", "
+		<< stats.records << " records, " << stats.bytes << " bytes in " << stats.files << " files";
+
+	if (stats.dropped > 0)
+	{
+		reply << ", " << stats.dropped << " dropped";
+	}
+
+	reply << "\n  Last write:\t" << (stats.lastWriteUs / 1000.0) << " ms, max " << (stats.maxWriteUs / 1000.0) << " ms";
+	return reply.str();
+}
+
+uint64_t SessionLog::now()
+{
+	return (uint64_t)chrono::duration_cast<chrono::milliseconds>(
+		chrono::system_clock::now().time_since_epoch()
+	).count();
+}
+
+
+// =============================================================
+//
+//  Private
+//
+// =============================================================
+
+void SessionLog::writeLoop()
+{
+	vector<uint8_t> writing;
+	writing.reserve(SESSION_LOG_BUFFER_RESERVE);
+	bool isRunning = true;
+
+	while (isRunning)
+	{
+		{
+			unique_lock<mutex> lock(_mutex);
+			_signal.wait_for(lock, chrono::milliseconds(SESSION_LOG_FLUSH_MS));
+			writing.swap(_pending);
+			isRunning = _isRunning;
+		}
+
+		writeBatch(writing);
+	}
+
+	// One last pass for anything recorded between that swap and stop().
+	{
+		lock_guard<mutex> lock(_mutex);
+		writing.swap(_pending);
+	}
+	writeBatch(writing);
+}
+
+void SessionLog::writeBatch(vector<uint8_t>& writing)
+{
+	if (writing.empty())
+	{
+		return;
+	}
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	// Rotate between batches, so a record never straddles two files.
+	const uint64_t nowMs = now();
+	if (_fileBytes >= _limits.maxFileBytes || nowMs - _fileStartMs >= _limits.maxFileAgeMs)
+	{
+		_file.close();
+		openFile(nowMs);
+		pruneFiles();
+	}
+
+	_file.write(reinterpret_cast<const char*>(writing.data()), writing.size());
+	_file.flush();
+	_fileBytes += writing.size();
+
+	const uint64_t elapsedUs = (uint64_t)chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+	lock_guard<mutex> lock(_mutex);
+	_stats.bytes += writing.size();
+	_stats.lastWriteUs = elapsedUs;
+	_stats.maxWriteUs = (elapsedUs > _stats.maxWriteUs) ? elapsedUs : _stats.maxWriteUs;
+	writing.clear();
+}
+
+bool SessionLog::openFile(uint64_t startMs)
+{
+	// Names are start times; two files in the same millisecond would share one.
+	if (startMs <= _fileStartMs)
+	{
+		startMs = _fileStartMs + 1;
+	}
+
+	char name[64];
+	snprintf(name, sizeof(name), SESSION_LOG_FILE_PREFIX "%016llu" SESSION_LOG_EXTENSION, (unsigned long long)startMs);
+	_path = _directory + name;
+
+	_file.open(_path, ios::binary | ios::app);
+	if (!_file.is_open())
+	{
+		return false;
+	}
+
+	SessionLogFormat::FileHeader header;
+	header.magic = SESSION_LOG_MAGIC;
+	header.version = SESSION_LOG_VERSION;
+	header.reserved = 0;
+	header.startMs = startMs;
+	_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	_file.flush();
+
+	_fileStartMs = startMs;
+	_fileBytes = sizeof(header);
+
+	lock_guard<mutex> lock(_mutex);
+	_stats.files++;
+	return true;
+}
+
+void SessionLog::pruneFiles()
+{
+	const vector<string> names = SessionLogReader::listFiles(_directory);
+	if (names.size() <= _limits.keepFiles)
+	{
+		return;
+	}
+
+	const size_t excess = names.size() - _limits.keepFiles;
+	for (size_t i = 0; i < excess; i++)
+	{
+		MTY_DeleteFile((_directory + names[i]).c_str());
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include "matoya.h"
+#include "SessionLogFormat.h"
+
+#define SESSION_LOG_FLUSH_MS 250
+#define SESSION_LOG_PENDING_MAX_BYTES (4 * 1024 * 1024)
+#define SESSION_LOG_MAX_FILE_BYTES (16 * 1024 * 1024)
+#define SESSION_LOG_MAX_FILE_AGE_MS (6ULL * 60 * 60 * 1000)
+#define SESSION_LOG_KEEP_FILES 200
+#define SESSION_LOG_MAX_TEXT 4096
+
+using namespace std;
+
+/**
+ * Append-only record of what happened in the room: chat, commands, joins,
+ * leaves and moderation. record() only appends a frame to a memory buffer;
+ * a background thread writes it out, starts a new file when the current one
+ * passes the size or age in Limits, and keeps the newest Limits::keepFiles. Should the disk fall behind by
+ * more than SESSION_LOG_PENDING_MAX_BYTES, records are counted and dropped
+ * rather than held, so the caller never waits. See SessionLogFormat.
+ */
+class SessionLog
+{
+public:
+	class Stats
+	{
+	public:
+		uint64_t records = 0;
+		uint64_t dropped = 0;
+		uint64_t bytes = 0;
+		uint32_t files = 0;
+		uint64_t lastWriteUs = 0;
+		uint64_t maxWriteUs = 0;
+	};
+
+	/** When a file is rotated and how many are kept; defaults to the SESSION_LOG_* values. */
+	class Limits
+	{
+	public:
+		uint64_t maxFileBytes = SESSION_LOG_MAX_FILE_BYTES;
+		uint64_t maxFileAgeMs = SESSION_LOG_MAX_FILE_AGE_MS;
+		size_t keepFiles = SESSION_LOG_KEEP_FILES;
+	};
+
+	~SessionLog();
+	bool start(string directory);
+	bool start(string directory, const Limits& limits);
+	void stop();
+	const bool isRunning() const;
+	void record(SessionLogFormat::Kind kind, uint32_t userID, const char* name, const char* text);
+
+	const Stats getStats();
+	const string report();
+
+	static uint64_t now();
+
+private:
+	void writeLoop();
+	void writeBatch(vector<uint8_t>& writing);
+	bool openFile(uint64_t startMs);
+	void pruneFiles();
+
+	string _directory;
+	Limits _limits;
+	string _path;
+	ofstream _file;
+	uint64_t _fileStartMs = 0;
+	uint64_t _fileBytes = 0;
+
+	thread _writerThread;
+	mutex _mutex;
+	condition_variable _signal;
+	vector<uint8_t> _pending;
+	Stats _stats;
+	atomic<bool> _isRunning { false };
+};
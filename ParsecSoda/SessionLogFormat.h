@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#define SESSION_LOG_MAGIC 0x4C535350
+#define SESSION_LOG_VERSION 1
+#define SESSION_LOG_DIRNAME "sessions"
+#define SESSION_LOG_EXTENSION ".pslog"
+#define SESSION_LOG_FILE_PREFIX "session-"
+
+/**
+ * Binary layout shared by SessionLog and SessionLogReader.
+ *
+ * A session file is a FileHeader followed by records. Every record is a
+ * RecordHeader, then nameLength bytes of name and textLength bytes of text
+ * (UTF-8, no terminators). size is the whole record, header included, and
+ * checksum covers everything after it, so a reader can walk a file by size
+ * and stops cleanly at a record that was only half written. Times are Unix
+ * milliseconds. Files are named after their start time, so sorting names
+ * sorts sessions.
+ */
+namespace SessionLogFormat
+{
+	enum class Kind : uint8_t
+	{
+		CHAT = 1,
+		COMMAND = 2,
+		JOIN = 3,
+		LEAVE = 4,
+		MODERATION = 5
+	};
+
+#pragma pack(push, 1)
+	typedef struct FileHeader
+	{
+		uint32_t magic;
+		uint16_t version;
+		uint16_t reserved;
+		uint64_t startMs;
+	} FileHeader;
+
+	typedef struct RecordHeader
+	{
+		uint32_t size;
+		uint32_t checksum;
+		uint64_t timeMs;
+		uint32_t userID;
+		uint8_t kind;
+		uint8_t nameLength;
+		uint16_t textLength;
+	} RecordHeader;
+#pragma pack(pop)
+
+	/** FNV-1a over a record, from the byte after checksum to its end. */
+	inline uint32_t checksum(const uint8_t* record, size_t size)
+	{
+		const size_t skip = offsetof(RecordHeader, timeMs);
+		uint32_t result = 2166136261u;
+		for (size_t i = skip; i < size; i++)
+		{
+			result ^= record[i];
+			result *= 16777619u;
+		}
+		return result;
+	}
+
+	inline const char* kindName(Kind kind)
+	{
+		switch (kind)
+		{
+		case Kind::CHAT:		return "chat";
+		case Kind::COMMAND:		return "command";
+		case Kind::JOIN:		return "join";
+		case Kind::LEAVE:		return "leave";
+		case Kind::MODERATION:	return "moderation";
+		default:				return "?";
+		}
+	}
+}
@@ -0,0 +1,329 @@
+#include "SessionLogReader.h"
+
+#if defined(_WIN32)
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+vector<SessionLogReader::Entry> SessionLogReader::search(string directory, const Query& query, size_t maxResults)
+{
+	deque<Entry> found;
+	const vector<string> files = listFiles(directory);
+
+	// Records in a file are older than the start of the next one.
+	uint64_t newerStartMs = UINT64_MAX;
+	for (size_t i = files.size(); i-- > 0 && found.size() < maxResults; )
+	{
+		MappedFile file;
+		if (!file.open(directory + files[i]))
+		{
+			continue;
+		}
+
+		const uint64_t startMs = startOf(file);
+		if (newerStartMs < query.fromMs)
+		{
+			break;
+		}
+		newerStartMs = startMs;
+		if (startMs > query.toMs)
+		{
+			continue;
+		}
+
+		// Remember where matches are; only the ones we keep get copied.
+		vector<const uint8_t*> matches;
+		forEach(file, [&](const SessionLogFormat::RecordHeader& header, const char* name, const char* text) {
+			if (SessionLogReader::matches(header, name, text, query))
+			{
+				matches.push_back(reinterpret_cast<const uint8_t*>(name) - sizeof(header));
+			}
+		});
+
+		const size_t room = maxResults - found.size();
+		const size_t first = (matches.size() > room) ? matches.size() - room : 0;
+		for (size_t m = matches.size(); m-- > first; )
+		{
+			SessionLogFormat::RecordHeader header;
+			memcpy(&header, matches[m], sizeof(header));
+			const char* name = reinterpret_cast<const char*>(matches[m] + sizeof(header));
+
+			Entry entry;
+			entry.timeMs = header.timeMs;
+			entry.userID = header.userID;
+			entry.kind = (SessionLogFormat::Kind)header.kind;
+			entry.name.assign(name, header.nameLength);
+			entry.text.assign(name + header.nameLength, header.textLength);
+			found.push_front(entry);
+		}
+	}
+
+	return vector<Entry>(found.begin(), found.end());
+}
+
+vector<SessionLogReader::Entry> SessionLogReader::tail(string directory, size_t count)
+{
+	return search(directory, Query(), count);
+}
+
+vector<string> SessionLogReader::listFiles(string directory)
+{
+	vector<string> names;
+
+	MTY_FileList* list = MTY_GetFileList(directory.c_str(), SESSION_LOG_EXTENSION);
+	if (list == nullptr)
+	{
+		return names;
+	}
+
+	for (uint32_t i = 0; i < list->len; i++)
+	{
+		const MTY_FileDesc& file = list->files[i];
+		if (!file.dir && strncmp(file.name, SESSION_LOG_FILE_PREFIX, strlen(SESSION_LOG_FILE_PREFIX)) == 0)
+		{
+			names.push_back(file.name);
+		}
+	}
+	MTY_FreeFileList(&list);
+
+	sort(names.begin(), names.end());
+	return names;
+}
+
+SessionLogReader::Query SessionLogReader::parseQuery(string line)
+{
+	Query query;
+	string text;
+	const uint64_t nowMs = (uint64_t)time(nullptr) * 1000ULL;
+
+	vector<string> tokens;
+	std::istringstream words(line);
+	for (string word; words >> word; )
+	{
+		tokens.push_back(word);
+	}
+
+	for (size_t i = 0; i < tokens.size(); i++)
+	{
+		const string& token = tokens[i];
+		if (token.size() > 1 && token[0] == '#' && all_of(token.begin() + 1, token.end(), ::isdigit))
+		{
+			query.userID = (uint32_t)strtoul(token.c_str() + 1, nullptr, 10);
+		}
+		else if (token == "to" && i + 1 < tokens.size() && parseAgo(tokens[i + 1], nowMs, query.toMs))
+		{
+			i++;
+		}
+		else if (!parseAgo(token, nowMs, query.fromMs))
+		{
+			text += (text.empty() ? "" : " ") + token;
+		}
+	}
+
+	query.text = text;
+	return query;
+}
+
+const string SessionLogReader::Entry::toString() const
+{
+	const time_t seconds = (time_t)(timeMs / 1000);
+	struct tm local;
+#if defined(_WIN32)
+	localtime_s(&local, &seconds);
+#else
+	localtime_r(&seconds, &local);
+#endif
+
+	char stamp[32];
+	strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &local);
+
+	std::ostringstream line;
+	line << "[" << stamp << "] " << SessionLogFormat::kindName(kind) << "\t";
+	if (userID != 0)
+	{
+		line << name << " (#" << userID << ")";
+	}
+	if (!text.empty())
+	{
+		line << (userID != 0 ? ": " : "") << text;
+	}
+
+	return line.str();
+}
+
+
+// =============================================================
+//
+//  Private
+//
+// =============================================================
+
+uint64_t SessionLogReader::startOf(const MappedFile& file)
+{
+	if (file.size < sizeof(SessionLogFormat::FileHeader))
+	{
+		return 0;
+	}
+
+	SessionLogFormat::FileHeader header;
+	memcpy(&header, file.data, sizeof(header));
+	return (header.magic == SESSION_LOG_MAGIC) ? header.startMs : 0;
+}
+
+void SessionLogReader::forEach(const MappedFile& file, Visitor visit)
+{
+	if (file.size < sizeof(SessionLogFormat::FileHeader) || startOf(file) == 0)
+	{
+		return;
+	}
+
+	size_t at = sizeof(SessionLogFormat::FileHeader);
+	while (at + sizeof(SessionLogFormat::RecordHeader) <= file.size)
+	{
+		SessionLogFormat::RecordHeader header;
+		memcpy(&header, file.data + at, sizeof(header));
+
+		// A short or corrupt frame can only be the tail the writer hasn't finished.
+		if (header.size != sizeof(header) + header.nameLength + header.textLength
+			|| at + header.size > file.size
+			|| SessionLogFormat::checksum(file.data + at, header.size) != header.checksum)
+		{
+			break;
+		}
+
+		const char* name = reinterpret_cast<const char*>(file.data + at + sizeof(header));
+		visit(header, name, name + header.nameLength);
+		at += header.size;
+	}
+}
+
+bool SessionLogReader::matches(const SessionLogFormat::RecordHeader& header, const char* name, const char* text, const Query& query)
+{
+	if (query.userID != 0 && header.userID != query.userID)		return false;
+	if (header.timeMs < query.fromMs || header.timeMs > query.toMs)	return false;
+	if (query.text.empty())											return true;
+
+	return containsFolded(name, header.nameLength, query.text) || containsFolded(text, header.textLength, query.text);
+}
+
+bool SessionLogReader::parseAgo(const string& token, uint64_t nowMs, uint64_t& timeMs)
+{
+	const bool isNumber = token.size() > 1 && all_of(token.begin(), token.end() - 1, ::isdigit);
+	if (!isNumber || (token.back() != 'm' && token.back() != 'h'))
+	{
+		return false;
+	}
+
+	const uint64_t unitMs = (token.back() == 'h') ? 3600000ULL : 60000ULL;
+	const uint64_t spanMs = strtoull(token.c_str(), nullptr, 10) * unitMs;
+	timeMs = (nowMs > spanMs) ? nowMs - spanMs : 0;
+	return true;
+}
+
+bool SessionLogReader::containsFolded(const char* haystack, size_t length, const string& needle)
+{
+	if (needle.size() > length)
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i + needle.size() <= length; i++)
+	{
+		size_t j = 0;
+		while (j < needle.size() && tolower((unsigned char)haystack[i + j]) == tolower((unsigned char)needle[j]))
+		{
+			j++;
+		}
+		if (j == needle.size())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+SessionLogReader::MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool SessionLogReader::MappedFile::open(string path)
+{
+	close();
+
+#if defined(_WIN32)
+	// The writer may still be appending: share everything, map what's there now.
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	_file = file;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+	{
+		close();
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL)
+	{
+		close();
+		return false;
+	}
+	_mapping = mapping;
+
+	data = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	size = (size_t)fileSize.QuadPart;
+#else
+	_descriptor = ::open(path.c_str(), O_RDONLY);
+	if (_descriptor < 0)
+	{
+		return false;
+	}
+
+	struct stat info;
+	if (fstat(_descriptor, &info) != 0 || info.st_size == 0)
+	{
+		close();
+		return false;
+	}
+
+	void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, _descriptor, 0);
+	data = (view == MAP_FAILED) ? nullptr : (const uint8_t*)view;
+	size = (size_t)info.st_size;
+#endif
+
+	if (data == nullptr)
+	{
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+void SessionLogReader::MappedFile::close()
+{
+#if defined(_WIN32)
+	if (data != nullptr)		UnmapViewOfFile(data);
+	if (_mapping != nullptr)	CloseHandle((HANDLE)_mapping);
+	if (_file != nullptr)		CloseHandle((HANDLE)_file);
+#else
+	if (data != nullptr)		munmap((void*)data, size);
+	if (_descriptor >= 0)		::close(_descriptor);
+#endif
+
+	data = nullptr;
+	size = 0;
+	_file = nullptr;
+	_mapping = nullptr;
+	_descriptor = -1;
+}
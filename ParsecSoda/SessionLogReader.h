@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <functional>
+#include <ctime>
+#include <cctype>
+#include "matoya.h"
+#include "SessionLogFormat.h"
+
+#define SESSION_LOG_READER_DEFAULT_RESULTS 50
+
+using namespace std;
+
+/**
+ * Reads the files SessionLog writes, including the one still being written.
+ * Each file is memory-mapped and walked frame by frame in place; only the
+ * records that match are copied out. Files are visited newest first and
+ * skipped whole when their time span can't overlap the query, so a tail or
+ * a search for something recent doesn't touch older sessions at all.
+ */
+class SessionLogReader
+{
+public:
+	class Entry
+	{
+	public:
+		uint64_t timeMs = 0;
+		uint32_t userID = 0;
+		SessionLogFormat::Kind kind = SessionLogFormat::Kind::CHAT;
+		string name;
+		string text;
+
+		const string toString() const;
+	};
+
+	class Query
+	{
+	public:
+		/** 0 matches everyone. */
+		uint32_t userID = 0;
+		uint64_t fromMs = 0;
+		uint64_t toMs = UINT64_MAX;
+		/** Case-insensitive substring of the name or the text; empty matches all. */
+		string text;
+	};
+
+	/** The newest maxResults records that match, oldest first. */
+	static vector<Entry> search(string directory, const Query& query, size_t maxResults = SESSION_LOG_READER_DEFAULT_RESULTS);
+	static vector<Entry> tail(string directory, size_t count = SESSION_LOG_READER_DEFAULT_RESULTS);
+
+	/** Session file names in directory, oldest first. */
+	static vector<string> listFiles(string directory);
+
+	/**
+	 * Parses "[#userID] [<N>m|<N>h] [to <N>m|<N>h] [text]" as typed in the
+	 * headless console: records from N ago, up to N ago.
+	 */
+	static Query parseQuery(string line);
+
+private:
+	class MappedFile
+	{
+	public:
+		~MappedFile();
+		bool open(string path);
+		void close();
+
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+
+	private:
+		void* _file = nullptr;
+		void* _mapping = nullptr;
+		int _descriptor = -1;
+	};
+
+	typedef function<void(const SessionLogFormat::RecordHeader& header, const char* name, const char* text)> Visitor;
+
+	static uint64_t startOf(const MappedFile& file);
+	static void forEach(const MappedFile& file, Visitor visit);
+	static bool matches(const SessionLogFormat::RecordHeader& header, const char* name, const char* text, const Query& query);
+	static bool parseAgo(const string& token, uint64_t nowMs, uint64_t& timeMs);
+	static bool containsFolded(const char* haystack, size_t length, const string& needle);
+};
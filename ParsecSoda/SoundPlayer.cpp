@@ -0,0 +1,23 @@
+#include "SoundPlayer.h"
+
+#if defined(_WIN32)
+	#include <Windows.h>
+	#include <mmsystem.h>
+	#include <codecvt>
+	#include <locale>
+	#include <stdexcept>
+#endif
+
+void SoundPlayer::play(const char* path)
+{
+#if defined(_WIN32)
+	static wstring_convert<codecvt_utf8_utf16<wchar_t>> converter;
+
+	try
+	{
+		const wstring wide = converter.from_bytes(path);
+		PlaySound(wide.c_str(), NULL, SND_FILENAME | SND_NODEFAULT | SND_ASYNC);
+	}
+	catch (const std::exception&) {}
+#endif
+}
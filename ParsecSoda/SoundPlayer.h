@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+
+using namespace std;
+
+/**
+ * Fire-and-forget sound effects. This is the only code that asks the OS to
+ * play a file (PlaySound on Windows); elsewhere play() does nothing, so the
+ * commands and SFXList that use it stay portable.
+ */
+class SoundPlayer
+{
+public:
+	/** path is UTF-8; a missing or unreadable file plays nothing. */
+	static void play(const char* path);
+};
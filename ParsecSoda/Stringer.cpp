@@ -60,3 +60,13 @@ void Stringer::replacePattern(string& source, string oldPattern, string newPatte
 		index++;
 	}
 }
+
+const string Stringer::trim(const string source)
+{
+	const char* whitespace = " \t\r\n";
+	size_t first = source.find_first_not_of(whitespace);
+	if (first == std::string::npos) return "";
+
+	size_t last = source.find_last_not_of(whitespace);
+	return source.substr(first, last - first + 1);
+}
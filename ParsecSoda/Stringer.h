@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <cstdint>
 #include <cmath>
 
 #define STRINGER_MAX_WEIGHT (uint64_t)63
@@ -54,4 +55,10 @@ public:
 	static const bool isCloseEnough(const string str1, const string str2, uint8_t matches = STRINGER_DEFAULT_MATCH);
 
 	static void replacePattern(string& source, string oldPattern, string newPattern);
+
+	/**
+	* Returns a copy without leading and trailing whitespace.
+	* @param source String to trim.
+	*/
+	static const string trim(const string source);
 };
\ No newline at end of file
@@ -16,7 +16,7 @@ void TierList::setTier(uint32_t userID, Tier tier)
                 _guestTiers.erase(it);
             }
 
-            saveTiers();
+            scheduleSave();
 
             return;
         }
@@ -25,7 +25,7 @@ void TierList::setTier(uint32_t userID, Tier tier)
     if (tier != Tier::PLEB)
     {
         _guestTiers.push_back(GuestTier(userID, tier));
-        saveTiers();
+        scheduleSave();
     }
 }
 
@@ -52,3 +52,22 @@ bool TierList::saveTiers()
 {
     return MetadataCache::saveGuestTiers(_guestTiers);
 }
+
+void TierList::setPersistence(PersistenceWorker* persistence)
+{
+    _persistence = persistence;
+}
+
+void TierList::scheduleSave()
+{
+    if (_persistence == nullptr)
+    {
+        saveTiers();
+        return;
+    }
+
+    const vector<GuestTier> snapshot = _guestTiers;
+    _persistence->submit(PersistenceWorker::Target::TIERS, [snapshot]() {
+        return MetadataCache::saveGuestTiers(snapshot);
+    });
+}
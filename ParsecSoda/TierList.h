@@ -3,6 +3,7 @@
 #include <vector>
 #include "MetadataCache.h"
 #include "GuestTier.h"
+#include "PersistenceWorker.h"
 
 class TierList
 {
@@ -12,7 +13,13 @@ public:
 	
 	bool saveTiers();
 	void loadTiers();
+
+	/** setTier() saves through the worker once set; until then it writes right away. */
+	void setPersistence(PersistenceWorker* persistence);
 	
 private:
+	void scheduleSave();
+
 	vector<GuestTier> _guestTiers;
+	PersistenceWorker* _persistence = nullptr;
 };
\ No newline at end of file
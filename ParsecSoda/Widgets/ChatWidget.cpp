@@ -1,7 +1,7 @@
 #include "ChatWidget.h"
 
 ChatWidget::ChatWidget(Hosting& hosting)
-    : _hosting(hosting), _chatLog(hosting.getMessageLog()), _messageCount(0)
+    : _hosting(hosting), _chatLines(hosting.getMessageLog())
 {
     setSendBuffer("\0");
 }
@@ -16,21 +16,8 @@ bool ChatWidget::render()
     static ImVec2 size;
     size = ImGui::GetContentRegionAvail();
 
-    static vector<string>::iterator it;
-    it = _chatLog.begin();
     ImGui::BeginChild("Chat Log", ImVec2(size.x, size.y - 160));
-    for (; it != _chatLog.end(); ++it)
-    {
-        ImGui::TextWrapped((*it).c_str());
-    }
-    if (_messageCount != _chatLog.size())
-    {
-        if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY() - 10)
-        {
-            ImGui::SetScrollHereY(1.0f);
-        }
-        _messageCount = _chatLog.size();
-    }
+    _chatLines.render();
     ImGui::EndChild();
 
     ImGui::Separator();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ToggleIconButtonWidget.h"
+#include "LogLinesWidget.h"
 #include "../imgui/imgui.h"
 #include "../globals/AppIcons.h"
 #include "../globals/AppStyle.h"
@@ -28,7 +29,6 @@ private:
 	// Attributes
 	string _logBuffer;
 	char _sendBuffer[SEND_BUFFER_LEN];
-	vector<string>& _chatLog;
-	size_t _messageCount;
+	LogLinesWidget _chatLines;
 };
 
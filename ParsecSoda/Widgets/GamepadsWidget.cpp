@@ -1,7 +1,7 @@
 #include "GamepadsWidget.h"
 
 GamepadsWidget::GamepadsWidget(Hosting& hosting)
-    : _hosting(hosting), _gamepads(hosting.getGamepads())
+    : _hosting(hosting)
 {
 }
 
@@ -21,12 +21,17 @@ bool GamepadsWidget::render()
 
     static float indentDistance;
 
-    static vector<Gamepad>::iterator gi;
-    gi = _gamepads.begin();
+    // One snapshot per frame; edits go back through GamepadClient and show up next frame.
+    static shared_ptr<const GamepadTable> table;
+    table = _hosting.getGamepads();
+    GamepadClient& gamepadClient = _hosting.getGamepadClient();
+
+    static GamepadTable::Slots::const_iterator gi;
+    gi = table->slots.begin();
     static int index;
     index = 0;
 
-    for (; gi != _gamepads.end(); ++gi)
+    for (; gi != table->slots.end(); ++gi)
     {
         static uint32_t userID;
         userID = (*gi).owner.guest.userID;
@@ -40,9 +45,9 @@ bool GamepadsWidget::render()
         cursor = ImGui::GetCursorPos();
         
         static int padIndex = 0;
-        padIndex = (int)(*gi).getIndex() + 1;
+        padIndex = (int)(*gi).pad->getIndex() + 1;
         static bool isIndexFailure = false;
-        isIndexFailure = padIndex <= 0 && (*gi).isConnected();
+        isIndexFailure = padIndex <= 0 && (*gi).pad->isConnected() && (*gi).pad->getType() == Gamepad::Type::XBOX;
 
         ImGui::BeginGroup();
         ImGui::Dummy(ImVec2(0.0f, 12.0f));
@@ -58,14 +63,24 @@ bool GamepadsWidget::render()
         AppColors::pop();
         AppFonts::pop();
         ImGui::EndGroup();
-        (*gi).setIndex((ULONG)(padIndex - 1));
-        if (isIndexFailure)
+        (*gi).pad->setIndex((ULONG)(padIndex - 1));
+        if ((*gi).pad->getType() == Gamepad::Type::DS4)
+        {
+            TitleTooltipWidget::render(
+                "DualShock 4",
+                (
+                    string("DS4 pads are not listed by XInput.\n") +
+                    string("Bus serial: ") + to_string((*gi).pad->getBusIndex())
+                ).c_str()
+            );
+        }
+        else if (isIndexFailure)
         {
             TitleTooltipWidget::render(
                 "XInput index",
                 (
                     string("Windows failed to inform the correct index.\n") +
-                    string("You have to find it manually by trial and error.")
+                    string("XInput only numbers the first four XBox pads.")
                 ).c_str()
             );
         }
@@ -85,7 +100,7 @@ bool GamepadsWidget::render()
 
         if (IconButton::render(AppIcons::back, AppColors::primary))
         {
-            (*gi).clearOwner();
+            gamepadClient.clearOwner(index);
         }
         TitleTooltipWidget::render("Strip gamepad", "Unlink current user from this gamepad.");
 
@@ -93,14 +108,14 @@ bool GamepadsWidget::render()
 
         static ImVec4 colorOn;
         colorOn = padIndex > 0 ? AppColors::positive : AppColors::warning;
-        if (ToggleIconButtonWidget::render(AppIcons::padOn, AppIcons::padOff, (*gi).isConnected(), colorOn))
+        if (ToggleIconButtonWidget::render(AppIcons::padOn, AppIcons::padOff, (*gi).pad->isConnected(), colorOn))
         {
-            if ((*gi).isConnected())
-                (*gi).disconnect();
+            if ((*gi).pad->isConnected())
+                gamepadClient.disconnect(index);
             else
-                (*gi).connect();
+                gamepadClient.connect(index);
         }
-        if ((*gi).isConnected()) TitleTooltipWidget::render("Connected gamepad", "Press to \"physically\" disconnect\nthis gamepad (at O.S. level).");
+        if ((*gi).pad->isConnected()) TitleTooltipWidget::render("Connected gamepad", "Press to \"physically\" disconnect\nthis gamepad (at O.S. level).");
         else                     TitleTooltipWidget::render("Disconnected gamepad", "Press to \"physically\" connect\nthis gamepad (at O.S. level).");
 
         ImGui::SameLine();
@@ -157,12 +172,19 @@ bool GamepadsWidget::render()
         {
             if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("Guest"))
             {
-                if (payload->DataSize == sizeof(int))
+                if (payload->DataSize == sizeof(uint32_t))
                 {
-                    int guestIndex = *(const int*)payload->Data;
-                    if (guestIndex >= 0 && guestIndex < _hosting.getGuestList().size())
+                    // Dropped by user id: the guest may have left since the drag started.
+                    const uint32_t userID = *(const uint32_t*)payload->Data;
+                    const vector<Guest> guests = _hosting.getGuestList();
+                    vector<Guest>::const_iterator gli = guests.begin();
+                    for (; gli != guests.end(); ++gli)
                     {
-                        (*gi).owner.guest.copy(_hosting.getGuestList()[guestIndex]);
+                        if ((*gli).userID == userID)
+                        {
+                            gamepadClient.setOwner(index, *gli, (*gi).owner.deviceID, (*gi).owner.isKeyboard);
+                            break;
+                        }
                     }
                 }
             }
@@ -171,41 +193,47 @@ bool GamepadsWidget::render()
                 if (payload->DataSize == sizeof(int))
                 {
                     int sourceIndex = *(const int*)payload->Data;
-                    if (sourceIndex >= 0 && sourceIndex < _gamepads.size())
-                    {
-                        static GuestDevice backupOwner;
-                        backupOwner.copy(_gamepads[index].owner);
-                        
-                        _gamepads[index].copyOwner(_gamepads[sourceIndex]);
-                        _gamepads[sourceIndex].owner.copy(backupOwner);
-                        _gamepads[index].clearState();
-                        _gamepads[sourceIndex].clearState();
-                    }
+                    gamepadClient.swapOwners(index, sourceIndex);
                 }
             }
 
             ImGui::EndDragDropTarget();
         }
 
+        if ((*gi).isOwned() && _hosting.isMeasuringInputLatency())
+        {
+            static InputLatency::Summary latency;
+            latency = _hosting.getInputLatency((*gi).owner.guest.userID);
+            TitleTooltipWidget::render(
+                "Input latency",
+                (
+                    string("Received -> applied to the driver, in microseconds.\n") +
+                    string("p50: ") + to_string(latency.p50Us) + string("\tp99: ") + to_string(latency.p99Us) +
+                    string("\tmax: ") + to_string(latency.maxUs) +
+                    string("\nQueued p99: ") + to_string(latency.queueP99Us) + string("\t(") + to_string(latency.count) + string(" msgs)")
+                ).c_str()
+            );
+        }
+
         ImGui::SetCursorPos(backupCursor);
 
         ImGui::EndChild();
         
         ImGui::SameLine();
         
-        static int deviceIndices[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+        static int deviceIndex;
         ImGui::BeginGroup();
         ImGui::Dummy(ImVec2(0.0f, 12.0f));
         ImGui::SetNextItemWidth(40);
-        deviceIndices[index] = (*gi).owner.deviceID;
+        deviceIndex = (*gi).owner.deviceID;
 
         AppFonts::pushTitle();
         if (ImGui::DragInt(
             (string("##DeviceIndex") + to_string(index)).c_str(),
-            &deviceIndices[index], 0.1f, -1, 65536
+            &deviceIndex, 0.1f, -1, 65536
         ))
         {
-            (*gi).owner.deviceID = deviceIndices[index];
+            gamepadClient.setDeviceID(index, deviceIndex);
         }
         if (ImGui::IsItemHovered()) ImGui::SetMouseCursor(ImGuiMouseCursor_Hand);
         AppFonts::pop();
@@ -241,15 +269,82 @@ bool GamepadsWidget::render()
     ImGui::BeginGroup();
     if (IconButton::render(AppIcons::refresh, AppColors::primary, ImVec2(30.0f, 30.0f)))
     {
-        _hosting.getGamepadClient().resetAll();
+        gamepadClient.resetAll();
+    }
+    if (ImGui::IsItemHovered())
+    {
+        // Only fetched while the tooltip is up.
+        const GamepadClient::BringUpReport bringUpReport = gamepadClient.getBringUpReport();
+        const RumbleForwarder::Stats rumbleStats = gamepadClient.getRumbleStats();
+        string padTimes;
+        for (size_t i = 0; i < bringUpReport.padMs.size(); ++i)
+        {
+            padTimes += string("\n  Pad ") + to_string(i + 1) + string(": ") + to_string((int)bringUpReport.padMs[i]) + string(" ms");
+        }
+        TitleTooltipWidget::render(
+            "Reset gamepad engine",
+            (
+                string("If all else fails, try this button.\nPress in dire situations.\n\n") +
+                string("Last bring-up: ") + to_string((int)bringUpReport.totalMs) + string(" ms") +
+                (bringUpReport.failedCount > 0 ? string(" (") + to_string(bringUpReport.failedCount) + string(" failed)") : string()) +
+                padTimes +
+                string("\nRumble: ") + to_string(rumbleStats.received) + string(" received, ") +
+                to_string(rumbleStats.forwarded) + string(" forwarded")
+            ).c_str()
+        );
     }
-    TitleTooltipWidget::render("Reset gamepad engine", "If all else fails, try this button.\nPress in dire situations.");
     ImGui::SameLine();
     if (IconButton::render(AppIcons::sort, AppColors::primary, ImVec2(30.0f, 30.0f)))
     {
-        _hosting.getGamepadClient().sortGamepads();
+        gamepadClient.sortGamepads();
     }
     TitleTooltipWidget::render("Sort gamepads", "Re-sort all gamepads by index.");
+    ImGui::SameLine();
+    if (ToggleIconButtonWidget::render(
+        AppIcons::stop, AppIcons::play, _hosting.isRecordingInputs(),
+        AppColors::negative, AppColors::primary, ImVec2(30.0f, 30.0f)
+    ))
+    {
+        _hosting.toggleInputRecording();
+    }
+    if (_hosting.isRecordingInputs())   TitleTooltipWidget::render("Stop recording inputs", "Close the current input trace.");
+    else                                TitleTooltipWidget::render("Record inputs", "Write every guest input message to a trace file.");
+    ImGui::SameLine();
+    if (IconButton::render(AppIcons::send, _hosting.isReplayingInputs() ? AppColors::negative : AppColors::primary, ImVec2(30.0f, 30.0f)))
+    {
+        _hosting.replayInputs(ImGui::GetIO().KeyShift);
+    }
+    TitleTooltipWidget::render("Replay inputs", "Feed the last trace into the gamepads as fast as possible.\nHold Shift to replay at the original speed.\nGuest inputs are locked meanwhile.");
+    ImGui::SameLine();
+    if (ToggleIconButtonWidget::render(
+        AppIcons::log, AppIcons::logoff, _hosting.isMeasuringInputLatency(),
+        AppColors::positive, AppColors::primary, ImVec2(30.0f, 30.0f)
+    ))
+    {
+        _hosting.toggleInputLatency();
+    }
+    if (_hosting.isMeasuringInputLatency())  TitleTooltipWidget::render("Stop measuring latency", "Hover a gamepad to see its owner's input latency.\nStopping writes " INPUT_LATENCY_FILENAME ".");
+    else                                     TitleTooltipWidget::render("Measure input latency", "Time every guest input from arrival to the driver update.\nCosts nothing while off.");
+
+    static int xboxCount, ds4Count;
+    xboxCount = MetadataCache::preferences.xboxCount;
+    ds4Count = MetadataCache::preferences.ds4Count;
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(40.0f);
+    if (ImGui::DragInt("##XBoxCount", &xboxCount, 0.1f, 0, GAMEPAD_MAX_COUNT))
+    {
+        MetadataCache::preferences.xboxCount = xboxCount;
+        MetadataCache::savePreferences();
+    }
+    TitleTooltipWidget::render("XBox pads", "Amount of XBox 360 pads.\nApplied on gamepad engine reset.");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(40.0f);
+    if (ImGui::DragInt("##DS4Count", &ds4Count, 0.1f, 0, GAMEPAD_MAX_COUNT))
+    {
+        MetadataCache::preferences.ds4Count = ds4Count;
+        MetadataCache::savePreferences();
+    }
+    TitleTooltipWidget::render("DualShock 4 pads", "Amount of DS4 pads.\nApplied on gamepad engine reset.");
     ImGui::EndGroup();
     ImGui::SetCursorPos(cursor);
 
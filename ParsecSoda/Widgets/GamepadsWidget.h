@@ -19,5 +19,4 @@ private:
 	
 	// Attributes
 	string _logBuffer;
-	vector<Gamepad>& _gamepads;
 };
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include "GuestListWidget.h"
 
 GuestListWidget::GuestListWidget(Hosting& hosting)
-    : _hosting(hosting), _guests(hosting.getGuestList()),
+    : _hosting(hosting),
     _banList(_hosting.getBanList()), _guestHistory(_hosting.getGuestHistory())
 {
 }
@@ -15,6 +15,9 @@ bool GuestListWidget::render()
 
     ImVec2 size = ImGui::GetContentRegionAvail();
 
+    // One snapshot per frame: the event thread keeps changing the roster meanwhile.
+    _guests = _hosting.getGuestList();
+
     static vector<Guest>::iterator it;
     it = _guests.begin();
     ImGui::BeginChild("Guest List", ImVec2(size.x, size.y));
@@ -114,7 +117,7 @@ void GuestListWidget::renderOnlineGuests()
 
         if (ImGui::BeginDragDropSource())
         {
-            ImGui::SetDragDropPayload("Guest", &i, sizeof(int));
+            ImGui::SetDragDropPayload("Guest", &userID, sizeof(uint32_t));
 
             AppFonts::pushInput();
             AppColors::pushPrimary();
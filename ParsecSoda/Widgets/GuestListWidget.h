@@ -25,6 +25,6 @@ private:
 	
 	// Attributes
 	string _logBuffer;
-	vector<Guest>& _guests;
+	vector<Guest> _guests;
 	vector<GuestData>& _guestHistory;
 };
\ No newline at end of file
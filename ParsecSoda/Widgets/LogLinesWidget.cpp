@@ -0,0 +1,125 @@
+#include "LogLinesWidget.h"
+
+LogLinesWidget::LogLinesWidget(LogRing& log)
+    : _log(log)
+{
+}
+
+void LogLinesWidget::render(LineRenderer renderLine)
+{
+    const float width = ImGui::GetContentRegionAvail().x;
+    const float spacing = ImGui::GetStyle().ItemSpacing.y;
+
+    if (width != _width || spacing != _spacing)
+    {
+        _spacing = spacing;
+        measure(width);
+    }
+    pull(width);
+
+    if (!_lines.empty())
+    {
+        // Scroll is in window coordinates; the list starts where the cursor is now.
+        const float top = ImGui::GetScrollY() - ImGui::GetCursorPosY();
+        const size_t first = findLine(top);
+        const size_t last = findLine(top + ImGui::GetWindowHeight());
+
+        // Dummy adds the item spacing after itself, so each one stops a spacing short.
+        if (first > 0)
+        {
+            ImGui::Dummy(ImVec2(0.0f, _tops[first] - _spacing));
+        }
+
+        for (size_t i = first; i <= last; i++)
+        {
+            renderLine(_lines[i]);
+        }
+
+        const float below = _totalHeight - (_tops[last] + _heights[last] + _spacing);
+        if (below > 0.0f)
+        {
+            ImGui::Dummy(ImVec2(0.0f, below - _spacing));
+        }
+    }
+
+    if (_shownLine != _nextLine)
+    {
+        if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY() - 10)
+        {
+            ImGui::SetScrollHereY(1.0f);
+        }
+        _shownLine = _nextLine;
+    }
+}
+
+void LogLinesWidget::drawLine(const string& line)
+{
+    // Unformatted: a '%' in chat is text, and nothing is copied into a format buffer.
+    ImGui::PushTextWrapPos(0.0f);
+    ImGui::TextUnformatted(line.c_str(), line.c_str() + line.size());
+    ImGui::PopTextWrapPos();
+}
+
+
+// =============================================================
+//
+//  Private
+//
+// =============================================================
+
+void LogLinesWidget::pull(float width)
+{
+    _fresh.clear();
+    _nextLine = _log.readFrom(_nextLine, _fresh);
+    if (_fresh.empty())
+    {
+        return;
+    }
+
+    for (deque<string>::iterator it = _fresh.begin(); it != _fresh.end(); ++it)
+    {
+        const char* text = (*it).c_str();
+        _heights.push_back(ImGui::CalcTextSize(text, text + (*it).size(), false, width).y);
+        _lines.push_back(std::move(*it));
+
+        if (_lines.size() > _log.capacity())
+        {
+            _lines.pop_front();
+            _heights.pop_front();
+        }
+    }
+
+    layout();
+}
+
+void LogLinesWidget::measure(float width)
+{
+    _width = width;
+    for (size_t i = 0; i < _lines.size(); i++)
+    {
+        const char* text = _lines[i].c_str();
+        _heights[i] = ImGui::CalcTextSize(text, text + _lines[i].size(), false, width).y;
+    }
+
+    layout();
+}
+
+void LogLinesWidget::layout()
+{
+    _tops.resize(_heights.size());
+
+    float top = 0.0f;
+    for (size_t i = 0; i < _heights.size(); i++)
+    {
+        _tops[i] = top;
+        top += _heights[i] + _spacing;
+    }
+    _totalHeight = top;
+}
+
+size_t LogLinesWidget::findLine(float y) const
+{
+    // Last line whose top is at or above y.
+    vector<float>::const_iterator it = upper_bound(_tops.begin(), _tops.end(), y);
+    return (it == _tops.begin()) ? 0 : (size_t)(it - _tops.begin()) - 1;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+#include <string>
+#include "../imgui/imgui.h"
+#include "../LogRing.h"
+
+using namespace std;
+
+/**
+ * Scrolling, wrapped view of a LogRing, shared by the chat and log windows.
+ * New lines are pulled once and measured once at the current wrap width; a
+ * frame then draws only the lines inside the scroll window and stands in for
+ * the rest with two Dummy items. Lines are remeasured only when the width
+ * changes. ImGuiListClipper needs equal item heights, which wrapped text
+ * doesn't have, hence the cached heights.
+ */
+class LogLinesWidget
+{
+public:
+	/** Draws one line at the cursor; it must wrap at the content region like drawLine does. */
+	typedef void (*LineRenderer)(const string& line);
+
+	LogLinesWidget(LogRing& log);
+
+	/** Call inside the scrolling child window. Sticks to the bottom while the user is at the bottom. */
+	void render(LineRenderer renderLine = drawLine);
+
+	static void drawLine(const string& line);
+
+private:
+	void pull(float width);
+	void measure(float width);
+	void layout();
+	size_t findLine(float y) const;
+
+	LogRing& _log;
+	deque<string> _lines;
+	deque<string> _fresh;
+
+	/** Wrapped height of each line at _width, and each line's top inside the list. */
+	deque<float> _heights;
+	vector<float> _tops;
+	float _width = -1.0f;
+	float _spacing = 0.0f;
+	float _totalHeight = 0.0f;
+
+	uint64_t _nextLine = 0;
+	uint64_t _shownLine = 0;
+};
@@ -1,7 +1,7 @@
 #include "LogWidget.h"
 
 LogWidget::LogWidget(Hosting& hosting)
-    : _commandLog(hosting.getCommandLog()), _messageCount(0)
+    : _commandLines(hosting.getCommandLog())
 {
 }
 
@@ -14,36 +14,8 @@ bool LogWidget::render()
 
     ImVec2 size = ImGui::GetContentRegionAvail();
 
-    static vector<string>::iterator it;
-    it = _commandLog.begin();
     ImGui::BeginChild("Log text", ImVec2(size.x, size.y));
-    for (; it != _commandLog.end(); ++it)
-    {
-        if ((*it)[0] == '@')
-        {
-            AppStyle::pushPositive();
-            ImGui::TextWrapped((*it).c_str());
-            AppStyle::pop();
-        }
-        else if ((*it)[0] == '!')
-        {
-            AppStyle::pushNegative();
-            ImGui::TextWrapped((*it).c_str());
-            AppStyle::pop();
-        }
-        else
-        {
-            ImGui::TextWrapped((*it).c_str());
-        }
-    }
-    if (_messageCount != _commandLog.size())
-    {
-        if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY() - 10)
-        {
-            ImGui::SetScrollHereY(1.0f);
-        }
-        _messageCount = _commandLog.size();
-    }
+    _commandLines.render(renderLine);
     ImGui::EndChild();
 
     AppStyle::pop();
@@ -51,4 +23,24 @@ bool LogWidget::render()
     AppStyle::pop();
 
     return true;
+}
+
+void LogWidget::renderLine(const string& line)
+{
+    if (line[0] == '@')
+    {
+        AppStyle::pushPositive();
+        LogLinesWidget::drawLine(line);
+        AppStyle::pop();
+    }
+    else if (line[0] == '!')
+    {
+        AppStyle::pushNegative();
+        LogLinesWidget::drawLine(line);
+        AppStyle::pop();
+    }
+    else
+    {
+        LogLinesWidget::drawLine(line);
+    }
 }
\ No newline at end of file
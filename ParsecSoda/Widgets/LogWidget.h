@@ -4,6 +4,7 @@
 #include "../Hosting.h"
 #include "../globals/AppIcons.h"
 #include "../globals/AppStyle.h"
+#include "LogLinesWidget.h"
 
 class LogWidget
 {
@@ -12,8 +13,9 @@ public:
 	bool render();
 
 private:
+	static void renderLine(const string& line);
+
 	string _logBuffer;
-	vector<string>& _commandLog;
-	size_t _messageCount;
+	LogLinesWidget _commandLines;
 };
 
@@ -0,0 +1,221 @@
+#include "Test.h"
+#include "ParsecStub.h"
+#include "ChatBotFixture.h"
+#include "ViGEmStub.h"
+#include <cstdlib>
+#include <new>
+
+#define ALLOCATION_ROUNDS 200
+
+/**
+ * Counts heap allocations made by this thread while a Counter is alive.
+ * Replacing the global operator new is the only way to see allocations
+ * made inside the standard library, so it lives here, once for the whole
+ * test binary.
+ */
+namespace
+{
+	thread_local bool isCounting = false;
+	thread_local size_t allocations = 0;
+
+	class Counter
+	{
+	public:
+		Counter() { allocations = 0; isCounting = true; }
+		~Counter() { isCounting = false; }
+		size_t count() const { return allocations; }
+	};
+}
+
+void* operator new(size_t size)
+{
+	if (isCounting) allocations++;
+
+	void* memory = malloc(size == 0 ? 1 : size);
+	if (memory == nullptr) throw std::bad_alloc();
+	return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	free(memory);
+}
+
+TEST(CommandArenaReusesItsSlot)
+{
+	Guest sender("Guest", 2002, 2);
+	const char* line = "gg, one more?";
+
+	// The first command warms this thread's slot and reply buffer.
+	ACommand* command = CommandArena::make<CommandDefaultMessage>(line, sender, 0, Tier::PLEB);
+	command->run();
+	CommandArena::release(command);
+
+	size_t replied = 0;
+	Counter counter;
+	for (int i = 0; i < ALLOCATION_ROUNDS; i++)
+	{
+		command = CommandArena::make<CommandDefaultMessage>(line, sender, (uint32_t)(i % 2), Tier::PLEB);
+		command->run();
+		replied += command->replyMessage().size();
+		CommandArena::release(command);
+	}
+	CHECK_EQUAL((size_t)0, counter.count());
+	CHECK(replied > 0);
+}
+
+TEST(CommandArenaFallsBackToTheHeapWhenBusy)
+{
+	Guest sender("Guest", 2002, 2);
+
+	ACommand* first = CommandArena::make<CommandDefaultMessage>("a", sender, 0, Tier::PLEB);
+	Counter counter;
+	ACommand* second = CommandArena::make<CommandDefaultMessage>("b", sender, 0, Tier::PLEB);
+	CHECK_EQUAL((size_t)1, counter.count());
+
+	CommandArena::release(second);
+	CommandArena::release(first);
+}
+
+TEST(ChatCommandsDoNotAllocateOnceWarm)
+{
+	ChatBotFixture fixture;
+	// Commands that change pad ownership or preferences publish a new copy-on-write
+	// snapshot by design; their replies are covered by the next test.
+	const char* lines[] = {
+		"lol 3 more rounds then 1 v 1 at 10?",
+		"!help",
+		"!pads",
+		"!queue",
+		"!sfx",
+		"!sfx nope",
+		"!bonk",
+		"!bonk melon",
+		"!bonk 1",
+		"!idle",
+		"!idle soon",
+		"!guests 4"
+	};
+
+	// One pass to size every buffer and build the help tables.
+	for (const char* line : lines)
+	{
+		fixture.handle(line, fixture.guest);
+		fixture.handle(line, fixture.host, true);
+	}
+
+	for (const char* line : lines)
+	{
+		size_t replied = 0;
+		Counter counter;
+		for (int i = 0; i < ALLOCATION_ROUNDS; i++)
+		{
+			replied += fixture.handle(line, (i % 2 == 0) ? fixture.guest : fixture.host, i % 2 != 0);
+		}
+		CHECK_EQUAL((size_t)0, counter.count());
+		CHECK(replied > 0);
+	}
+}
+
+TEST(OwnershipRepliesAddNoAllocationsToTheirEdits)
+{
+	ViGEmStub::reset();
+	ChatBotFixture fixture;
+	fixture.gamepadClient.setParsec(fixture.parsec);
+	REQUIRE(fixture.gamepadClient.init());
+	fixture.gamepadClient.createGamepad(0);
+	fixture.gamepadClient.connectAllGamepads();
+
+	// The same state changes with and without the command around them: the difference is the reply.
+	const auto dropByHand = [&]() {
+		fixture.gamepadClient.setOwner(0, fixture.guest, 0);
+		fixture.gamepadClient.onQuit(fixture.guest);
+	};
+	const auto dropByCommand = [&]() {
+		fixture.gamepadClient.setOwner(0, fixture.guest, 0);
+		fixture.handle("!ff", fixture.guest);
+	};
+	const auto mirrorByHand = [&]() { fixture.gamepadClient.toggleMirror(fixture.guest.userID); };
+	const auto mirrorByCommand = [&]() { fixture.handle("!mirror", fixture.guest); };
+
+	dropByHand();
+	dropByCommand();
+	mirrorByHand();
+	mirrorByCommand();
+
+	size_t byHand = 0, byCommand = 0;
+	{
+		Counter counter;
+		for (int i = 0; i < ALLOCATION_ROUNDS; i++) dropByHand();
+		byHand = counter.count();
+	}
+	{
+		Counter counter;
+		for (int i = 0; i < ALLOCATION_ROUNDS; i++) dropByCommand();
+		byCommand = counter.count();
+	}
+	CHECK(byHand > 0);
+	CHECK_EQUAL(byHand, byCommand);
+
+	{
+		Counter counter;
+		for (int i = 0; i < ALLOCATION_ROUNDS; i++) mirrorByHand();
+		byHand = counter.count();
+	}
+	{
+		Counter counter;
+		for (int i = 0; i < ALLOCATION_ROUNDS; i++) mirrorByCommand();
+		byCommand = counter.count();
+	}
+	CHECK(byHand > 0);
+	CHECK_EQUAL(byHand, byCommand);
+
+	fixture.gamepadClient.release();
+}
+
+TEST(CommandReplyFormatsIntoItsThreadBuffer)
+{
+	const std::string name = "Guest";
+	CHECK_EQUAL(std::string("[ChatBot] | Guest has -3 pads, 1.5 x"), CommandReply::format("[ChatBot] | ", name, " has ", -3, " pads, ", 1.5, ' ', "x"));
+
+	Counter counter;
+	size_t length = 0;
+	for (int i = 0; i < ALLOCATION_ROUNDS; i++)
+	{
+		length += CommandReply::format("[ChatBot] | ", name, " \t(#", (uint32_t)i, ") has ", i - 100, " gamepads, ", 0.25 * i, '!').size();
+	}
+	CHECK_EQUAL((size_t)0, counter.count());
+	CHECK(length > 0);
+}
+
+TEST(CommandReplyBuffersDoNotOverlap)
+{
+	std::string& reply = CommandReply::buffer();
+	std::string& chat = CommandReply::buffer<CommandDefaultMessage>();
+	CHECK(&reply != &chat);
+
+	chat.assign("chat line");
+	CommandReply::format("reply ", 1);
+	CHECK_EQUAL(std::string("chat line"), chat);
+}
+
+TEST(GuestNoticesDoNotAllocateOnceWarm)
+{
+	ChatBotFixture fixture;
+	size_t length = fixture.chatBot.formatGuestConnection(fixture.guest, GUEST_CONNECTED).size();
+	length += fixture.chatBot.formatBannedGuestMessage(fixture.guest).size();
+
+	Counter counter;
+	for (int i = 0; i < ALLOCATION_ROUNDS; i++)
+	{
+		length += fixture.chatBot.formatGuestConnection(fixture.guest, (i % 2 == 0) ? GUEST_CONNECTED : GUEST_DISCONNECTED).size();
+		length += fixture.chatBot.formatBannedGuestMessage(fixture.guest).size();
+	}
+	CHECK_EQUAL((size_t)0, counter.count());
+	CHECK(length > 0);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+/**
+ * A minimal benchmark registry, the counterpart of Test.h. BENCH(Name) gets an
+ * iteration count (small when run as "parsecsoda_bench quick" from ctest);
+ * measure() times a loop and reports nanoseconds per call. Benchmarks also
+ * check the fast path against the code it replaced and fail() on a mismatch.
+ */
+namespace Bench
+{
+	class Case
+	{
+	public:
+		const char* name;
+		void (*run)(uint64_t iterations);
+	};
+
+	vector<Case>& cases();
+	void fail(const char* what);
+
+	class Registrar
+	{
+	public:
+		Registrar(const char* name, void (*run)(uint64_t)) { cases().push_back(Case{ name, run }); }
+	};
+
+	/** Folds a result into a global the optimizer can't see through. */
+	template <typename T>
+	inline void keep(const T& value)
+	{
+		static volatile uint64_t sink;
+		sink = sink + (uint64_t)value;
+	}
+
+	template <typename Func>
+	double measure(const char* label, uint64_t iterations, Func func)
+	{
+		using clock = chrono::steady_clock;
+
+		const clock::time_point before = clock::now();
+		for (uint64_t i = 0; i < iterations; i++)
+		{
+			func(i);
+		}
+		const double ns = (double)chrono::duration_cast<chrono::nanoseconds>(clock::now() - before).count() / iterations;
+
+		cout << "  " << label << ": " << ns << " ns/op" << endl;
+		return ns;
+	}
+}
+
+#define BENCH(name) \
+	static void bench_##name(uint64_t iterations); \
+	static Bench::Registrar registrar_##name(#name, bench_##name); \
+	static void bench_##name(uint64_t iterations)
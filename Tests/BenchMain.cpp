@@ -0,0 +1,40 @@
+#include "Bench.h"
+
+#include <cstring>
+
+#define BENCH_ITERATIONS (1 << 24)
+#define BENCH_ITERATIONS_QUICK (1 << 12)
+
+namespace
+{
+	int _failures = 0;
+}
+
+vector<Bench::Case>& Bench::cases()
+{
+	static vector<Case> all;
+	return all;
+}
+
+void Bench::fail(const char* what)
+{
+	_failures++;
+	cout << "  FAILED: " << what << endl;
+}
+
+/** "quick" runs every benchmark briefly, as a check; any other argument filters by name. */
+int main(int argc, char** argv)
+{
+	const bool isQuick = (argc > 1 && strcmp(argv[1], "quick") == 0);
+	const char* filter = (argc > 1 && !isQuick) ? argv[1] : nullptr;
+
+	for (const Bench::Case& bench : Bench::cases())
+	{
+		if (filter != nullptr && strstr(bench.name, filter) == nullptr) continue;
+
+		cout << bench.name << endl;
+		bench.run(isQuick ? BENCH_ITERATIONS_QUICK : BENCH_ITERATIONS);
+	}
+
+	return (_failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "ParsecStub.h"
+#include "ChatBot.h"
+
+/** Everything ChatBot holds a reference to, default-constructed like Hosting's members. */
+class ChatBotFixture
+{
+public:
+	ChatBotFixture()
+		: parsec(ParsecStub::create()), hostConfig(), isRunning(true),
+		host("Host", 1, 0), guest("Guest", 2002, 2),
+		chatBot(audioIn, audioOut, ban, dice, dx11, gamepadClient, guests, guestHistory,
+			parsec, hostConfig, session, sfxList, tierList, isRunning, host, mouseRouter)
+	{
+	}
+
+	~ChatBotFixture()
+	{
+		ParsecDestroy(parsec);
+	}
+
+	/** What Hosting::handleMessage does with a line, minus the broadcast. */
+	size_t handle(const char* message, Guest& sender, bool isHost = false)
+	{
+		ACommand* command = chatBot.identifyUserDataMessage(message, sender, isHost);
+		command->run();
+		const size_t length = command->replyMessage().size();
+		CommandArena::release(command);
+		chatBot.setLastUserId(sender.userID);
+		return length;
+	}
+
+	/** Which command a line becomes, without running it. */
+	COMMAND_TYPE identify(const char* message, Guest& sender, bool isHost = false)
+	{
+		ACommand* command = chatBot.identifyUserDataMessage(message, sender, isHost);
+		const COMMAND_TYPE type = command->type();
+		CommandArena::release(command);
+		return type;
+	}
+
+	ParsecDSO* parsec;
+	AudioIn audioIn;
+	AudioOut audioOut;
+	BanList ban;
+	Dice dice;
+	DX11 dx11;
+	GamepadClient gamepadClient;
+	GuestList guests;
+	GuestDataList guestHistory;
+	ParsecHostConfig hostConfig;
+	ParsecSession session;
+	SFXList sfxList;
+	TierList tierList;
+	MouseRouter mouseRouter;
+	bool isRunning;
+	Guest host;
+	Guest guest;
+	ChatBot chatBot;
+};
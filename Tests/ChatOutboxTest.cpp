@@ -0,0 +1,214 @@
+#include "ParsecStub.h"
+#include "Test.h"
+#include "ChatOutbox.h"
+
+#define OUTBOX_TEST_MSG_ID 11
+#define OUTBOX_TEST_GATE_GUEST 99
+
+namespace
+{
+	const uint32_t ALICE = 7;
+	const uint32_t BOB = 8;
+
+	/**
+	 * Holds the stub's sends and parks the outbox thread inside one, so
+	 * everything enqueued afterwards waits in the lanes until the hold is lifted.
+	 */
+	bool holdSender(ParsecDSO* parsec, ChatOutbox& outbox)
+	{
+		ParsecStub::holdSends(parsec, true);
+
+		const uint32_t gate = OUTBOX_TEST_GATE_GUEST;
+		outbox.enqueue(&gate, 1, "gate", false);
+		for (int i = 0; i < 200 && ParsecStub::heldSends(parsec) == 0; i++)
+		{
+			this_thread::sleep_for(chrono::milliseconds(10));
+		}
+		return ParsecStub::heldSends(parsec) == 1;
+	}
+
+	vector<string> sentTo(ParsecDSO* parsec, uint32_t guestID)
+	{
+		vector<string> texts;
+		for (const ParsecStub::Message& message : ParsecStub::sent(parsec))
+		{
+			if (message.guestID == guestID) texts.push_back(message.text);
+		}
+		return texts;
+	}
+}
+
+TEST(ChatOutboxTakesOneLinePerGuestPerPass)
+{
+	ParsecDSO* parsec = ParsecStub::create();
+	{
+		ChatOutbox outbox;
+		outbox.start(parsec, OUTBOX_TEST_MSG_ID);
+		REQUIRE(holdSender(parsec, outbox));
+
+		// Alice's backlog was queued first, but Bob's line doesn't wait behind it.
+		for (int i = 0; i < 10; i++)
+		{
+			outbox.enqueue(&ALICE, 1, "alice " + to_string(i), false);
+		}
+		outbox.enqueue(&BOB, 1, "bob", false);
+
+		ParsecStub::holdSends(parsec, false);
+		outbox.stop();
+
+		const vector<ParsecStub::Message>& sent = ParsecStub::sent(parsec);
+		REQUIRE(sent.size() == 12);
+
+		size_t bobAt = sent.size();
+		for (size_t i = 0; i < sent.size(); i++)
+		{
+			CHECK_EQUAL((uint32_t)OUTBOX_TEST_MSG_ID, sent[i].id);
+			if (sent[i].guestID == BOB) bobAt = i;
+		}
+		CHECK(bobAt <= 2);
+
+		const vector<string> alice = sentTo(parsec, ALICE);
+		REQUIRE(alice.size() == 10);
+		for (int i = 0; i < 10; i++)
+		{
+			CHECK(alice[i] == "alice " + to_string(i));
+		}
+	}
+	ParsecDestroy(parsec);
+}
+
+TEST(ChatOutboxSendsPendingSystemLinesOnce)
+{
+	ParsecDSO* parsec = ParsecStub::create();
+	{
+		ChatOutbox outbox;
+		outbox.start(parsec, OUTBOX_TEST_MSG_ID);
+		REQUIRE(holdSender(parsec, outbox));
+
+		const uint32_t both[] = { ALICE, BOB };
+		outbox.enqueue(both, 2, "[ChatBot] | Welcome!");
+		outbox.enqueue(both, 2, "[ChatBot] | Welcome!");
+		outbox.enqueue(&BOB, 1, "[ChatBot] | Welcome!");
+
+		// Guest chat is never folded, even when it repeats.
+		outbox.enqueue(&ALICE, 1, "gg", false);
+		outbox.enqueue(&ALICE, 1, "gg", false);
+
+		ParsecStub::holdSends(parsec, false);
+		outbox.stop();
+
+		CHECK_EQUAL((uint64_t)3, outbox.getStats().deduped);
+		CHECK((sentTo(parsec, ALICE) == vector<string>{ "[ChatBot] | Welcome!", "gg", "gg" }));
+		CHECK((sentTo(parsec, BOB) == vector<string>{ "[ChatBot] | Welcome!" }));
+
+		// Once the first one is out, the same line goes out again.
+		outbox.start(parsec, OUTBOX_TEST_MSG_ID);
+		outbox.enqueue(&BOB, 1, "[ChatBot] | Welcome!");
+		outbox.stop();
+		CHECK_EQUAL((size_t)2, sentTo(parsec, BOB).size());
+	}
+	ParsecDestroy(parsec);
+}
+
+TEST(ChatOutboxFullLaneDropsItsOldestLine)
+{
+	ParsecDSO* parsec = ParsecStub::create();
+	{
+		ChatOutbox outbox;
+		outbox.start(parsec, OUTBOX_TEST_MSG_ID);
+		REQUIRE(holdSender(parsec, outbox));
+
+		// More lines than there are payloads: only works if every dropped line gives its payload back.
+		const int total = CHAT_OUTBOX_PAYLOADS + CHAT_OUTBOX_GUEST_DEPTH;
+		for (int i = 0; i < total; i++)
+		{
+			outbox.enqueue(&ALICE, 1, "line " + to_string(i), false);
+		}
+		CHECK_EQUAL((uint64_t)(total - CHAT_OUTBOX_GUEST_DEPTH), outbox.getStats().dropped);
+		CHECK_EQUAL((size_t)CHAT_OUTBOX_GUEST_DEPTH, outbox.getStats().depth);
+
+		ParsecStub::holdSends(parsec, false);
+		outbox.stop();
+
+		const vector<string> alice = sentTo(parsec, ALICE);
+		REQUIRE(alice.size() == CHAT_OUTBOX_GUEST_DEPTH);
+		CHECK(alice.front() == "line " + to_string(total - CHAT_OUTBOX_GUEST_DEPTH));
+		CHECK(alice.back() == "line " + to_string(total - 1));
+	}
+	ParsecDestroy(parsec);
+}
+
+TEST(ChatOutboxReturnsPayloadsOnceSent)
+{
+	ParsecDSO* parsec = ParsecStub::create();
+	{
+		ChatOutbox outbox;
+		const uint32_t room[] = { ALICE, BOB, 9, 10 };
+
+		// Each round fills most of the pool; the next round only fits if it all came back.
+		const int perRound = CHAT_OUTBOX_GUEST_DEPTH - 1;
+		for (int round = 0; round < 4; round++)
+		{
+			outbox.start(parsec, OUTBOX_TEST_MSG_ID);
+			REQUIRE(holdSender(parsec, outbox));
+			for (int i = 0; i < perRound; i++)
+			{
+				for (uint32_t guest : room)
+				{
+					outbox.enqueue(&guest, 1, to_string(round) + "/" + to_string(guest) + "/" + to_string(i), false);
+				}
+			}
+			ParsecStub::holdSends(parsec, false);
+			outbox.stop();
+		}
+
+		// Shared by the whole room, then cleared from one guest: still freed once the rest are sent.
+		for (int round = 0; round < 5; round++)
+		{
+			outbox.start(parsec, OUTBOX_TEST_MSG_ID);
+			REQUIRE(holdSender(parsec, outbox));
+			for (int i = 0; i < perRound; i++)
+			{
+				outbox.enqueue(room, 4, "shared " + to_string(round) + "/" + to_string(i));
+			}
+			outbox.clear(ALICE);
+			ParsecStub::holdSends(parsec, false);
+			outbox.stop();
+		}
+
+		const ChatOutbox::Stats stats = outbox.getStats();
+		CHECK_EQUAL((uint64_t)0, stats.dropped);
+		CHECK_EQUAL((size_t)0, stats.depth);
+		CHECK_EQUAL((size_t)(9 * perRound), sentTo(parsec, BOB).size());
+		CHECK_EQUAL((size_t)(4 * perRound), sentTo(parsec, ALICE).size());
+	}
+	ParsecDestroy(parsec);
+}
+
+TEST(ChatOutboxStopSendsWhatIsQueued)
+{
+	ParsecDSO* parsec = ParsecStub::create();
+	{
+		ChatOutbox outbox;
+		outbox.start(parsec, OUTBOX_TEST_MSG_ID);
+		REQUIRE(holdSender(parsec, outbox));
+
+		const uint32_t both[] = { ALICE, BOB };
+		for (int i = 0; i < 5; i++)
+		{
+			outbox.enqueue(both, 2, "bye " + to_string(i), false);
+		}
+
+		ParsecStub::holdSends(parsec, false);
+		outbox.stop();
+		CHECK_EQUAL((size_t)5, sentTo(parsec, ALICE).size());
+		CHECK_EQUAL((size_t)5, sentTo(parsec, BOB).size());
+		CHECK_EQUAL((size_t)0, outbox.getStats().depth);
+
+		// Stopped: lines go out right away on the caller's thread.
+		outbox.enqueue(&ALICE, 1, "late", false);
+		REQUIRE(sentTo(parsec, ALICE).size() == 6);
+		CHECK(sentTo(parsec, ALICE).back() == "late");
+	}
+	ParsecDestroy(parsec);
+}
@@ -0,0 +1,121 @@
+#include "Test.h"
+#include "ChatRateLimiter.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#define CHAT_FLOOD_ROUNDS 200
+#define CHAT_FLOOD_SPAM 50
+#define CHAT_FLOOD_GUESTS 20
+#define CHAT_FLOOD_ROUND_US 5000000ULL
+#define CHAT_FLOOD_WAIT_BOUND_US 5000
+
+namespace
+{
+	const uint32_t SPAMMER = 0xFFFF0000;
+	const uint32_t FIRST_GUEST = 0xFFFF0001;
+	const char* SPAM = "FREE SKINS at parsec-soda-skins dot net";
+}
+
+/**
+ * One pleb sends CHAT_FLOOD_SPAM copies of a line every round while the
+ * others chat once each, the way the event thread would see it. A kick is
+ * acted on like Hosting does: the spammer leaves and is forgotten. Each other
+ * guest's wait is timed from the start of the round, so it includes the time
+ * spent on the spam burst in front of them.
+ */
+TEST(ChatFloodLetsOtherGuestsThrough)
+{
+	ChatRateLimiter limiter;
+	std::vector<ChatRateLimiter::Action> escalation;
+	size_t spamPassed = 0, guestPassed = 0;
+	bool isSpammerHere = true;
+	uint64_t clockUs = 1;
+	std::vector<double> waitsUs;
+	waitsUs.reserve(CHAT_FLOOD_ROUNDS * CHAT_FLOOD_GUESTS);
+
+	char line[64];
+	for (uint32_t round = 0; round < CHAT_FLOOD_ROUNDS; round++)
+	{
+		const std::chrono::steady_clock::time_point roundStart = std::chrono::steady_clock::now();
+
+		for (uint32_t i = 0; i < CHAT_FLOOD_SPAM && isSpammerHere; i++)
+		{
+			const ChatRateLimiter::Action action = limiter.check(SPAMMER, Tier::PLEB, SPAM, clockUs);
+			if (action == ChatRateLimiter::Action::PASS)
+			{
+				spamPassed++;
+			}
+			else if (action != ChatRateLimiter::Action::DROP)
+			{
+				escalation.push_back(action);
+			}
+
+			if (action == ChatRateLimiter::Action::KICK)
+			{
+				limiter.forget(SPAMMER);
+				isSpammerHere = false;
+			}
+		}
+
+		for (uint32_t g = 0; g < CHAT_FLOOD_GUESTS; g++)
+		{
+			snprintf(line, sizeof(line), "round %u went well, gg", round);
+			guestPassed += (limiter.check(FIRST_GUEST + g, Tier::PLEB, line, clockUs) == ChatRateLimiter::Action::PASS) ? 1 : 0;
+			waitsUs.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - roundStart).count());
+		}
+
+		clockUs += CHAT_FLOOD_ROUND_US;
+	}
+
+	CHECK_EQUAL((size_t)CHAT_FLOOD_ROUNDS * CHAT_FLOOD_GUESTS, guestPassed);
+	CHECK(!isSpammerHere);
+	CHECK(spamPassed < CHAT_FLOOD_SPAM / 5);
+
+	REQUIRE(escalation.size() == 3);
+	CHECK(escalation[0] == ChatRateLimiter::Action::WARN);
+	CHECK(escalation[1] == ChatRateLimiter::Action::MUTE);
+	CHECK(escalation[2] == ChatRateLimiter::Action::KICK);
+
+	std::sort(waitsUs.begin(), waitsUs.end());
+	const double p99Us = waitsUs[waitsUs.size() * 99 / 100];
+	std::cout << "  other guests waited p50 " << waitsUs[waitsUs.size() / 2] << " us, p99 " << p99Us
+		<< " us, max " << waitsUs.back() << " us" << std::endl;
+	CHECK(p99Us < CHAT_FLOOD_WAIT_BOUND_US);
+
+	const ChatRateLimiter::Stats stats = limiter.getStats();
+	CHECK_EQUAL((uint64_t)1, stats.kicked);
+	CHECK_EQUAL((uint64_t)(spamPassed + guestPassed), stats.passed);
+}
+
+TEST(ChatFloodFromAGodIsNeverLimited)
+{
+	ChatRateLimiter limiter;
+	uint64_t clockUs = 1;
+
+	for (uint32_t i = 0; i < CHAT_FLOOD_SPAM * 10; i++)
+	{
+		CHECK(limiter.check(SPAMMER, Tier::GOD, SPAM, clockUs) == ChatRateLimiter::Action::PASS);
+		clockUs += 1000;
+	}
+}
+
+TEST(ChatRepeatsIgnoreCaseAndSpacing)
+{
+	ChatRateLimiter limiter;
+	const ChatRateLimiter::Policy& policy = limiter.getPolicy(Tier::PLEB);
+	const char* lines[] = { "gg gg", "GG  gg", "g G g g", "gGgG" };
+
+	uint64_t clockUs = 1;
+	uint32_t passed = 0;
+	for (const char* line : lines)
+	{
+		passed += (limiter.check(SPAMMER, Tier::PLEB, line, clockUs) == ChatRateLimiter::Action::PASS) ? 1 : 0;
+		clockUs += 1000;
+	}
+
+	CHECK_EQUAL(policy.repeats, passed);
+	CHECK_EQUAL((uint64_t)(4 - policy.repeats), limiter.getStats().duplicates);
+}
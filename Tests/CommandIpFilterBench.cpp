@@ -0,0 +1,35 @@
+#include "Bench.h"
+#include "CommandIpFilterCorpus.h"
+
+#define IP_FILTER_BENCH_CORPUS_SIZE 4096
+
+BENCH(IpFilterScan)
+{
+	uint32_t seed = 43;
+	vector<string> corpus;
+	size_t bytes = 0;
+	for (size_t i = 0; i < IP_FILTER_BENCH_CORPUS_SIZE; i++)
+	{
+		corpus.push_back(IpFilterCorpus::randomMessage(seed));
+		bytes += corpus.back().size();
+	}
+
+	for (const string& message : corpus)
+	{
+		if (IpFilterCorpus::regexContainsIp(message) != CommandIpFilter::containsIp(message.c_str()))
+		{
+			Bench::fail("containsIp disagrees with the old regex");
+			return;
+		}
+	}
+
+	// The regex is far slower; a slice of the iterations is plenty.
+	Bench::measure("regex", iterations / 64 + 1, [&](uint64_t i) {
+		Bench::keep(IpFilterCorpus::regexContainsIp(corpus[i & (IP_FILTER_BENCH_CORPUS_SIZE - 1)]));
+	});
+
+	const double ns = Bench::measure("containsIp", iterations, [&](uint64_t i) {
+		Bench::keep(CommandIpFilter::containsIp(corpus[i & (IP_FILTER_BENCH_CORPUS_SIZE - 1)].c_str()));
+	});
+	cout << "  containsIp: " << (ns > 0 ? bytes / (double)IP_FILTER_BENCH_CORPUS_SIZE / ns * 1000.0 : 0.0) << " MB/s" << endl;
+}
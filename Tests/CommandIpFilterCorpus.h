@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ParsecStub.h"
+#include "Commands/CommandIpFilter.h"
+#include <regex>
+#include <string>
+
+/**
+ * The reference containsIp is checked against, and a seeded corpus of chat
+ * lines for it; shared by CommandIpFilterTest and CommandIpFilterBench.
+ */
+namespace IpFilterCorpus
+{
+	/** The pattern containsIp replaced, searched the way the old code did. */
+	inline bool regexContainsIp(const std::string& message)
+	{
+		static const std::regex ipRegex("((\\d{3}|\\d{2})[\\s\\D]+){2}((\\d{3}|\\d{2}|\\d{1})[\\s\\D]+){1}");
+		std::smatch match;
+		return std::regex_search(message, match, ipRegex);
+	}
+
+	inline uint32_t nextRandom(uint32_t& seed)
+	{
+		seed = seed * 1103515245u + 12345u;
+		return seed >> 16;
+	}
+
+	/**
+	 * Digit groups of every length the rule cares about, alternating with separators.
+	 * An empty separator glues two groups into a longer run, so plenty of messages
+	 * land right on the match boundary.
+	 */
+	inline std::string randomMessage(uint32_t& seed)
+	{
+		static const char* groups[] = { "0", "7", "12", "42", "255", "192", "1000", "65535", "a", "xyz" };
+		static const char* separators[] = {
+			"", ".", ".", ":", " ", "  ", "\t", "-", "/", "!ip ",
+			"\xc3\xa9", "\xe2\x80\xa2", "\xf0\x9f\x98\x80"
+		};
+		static const uint32_t groupCount = sizeof(groups) / sizeof(groups[0]);
+		static const uint32_t separatorCount = sizeof(separators) / sizeof(separators[0]);
+
+		const uint32_t length = nextRandom(seed) % 9;
+
+		std::string message;
+		if (nextRandom(seed) % 2 == 0)
+		{
+			message += separators[nextRandom(seed) % separatorCount];
+		}
+		for (uint32_t i = 0; i < length; i++)
+		{
+			message += groups[nextRandom(seed) % groupCount];
+			message += separators[nextRandom(seed) % separatorCount];
+		}
+		return message;
+	}
+}
@@ -0,0 +1,39 @@
+#include "Test.h"
+#include "CommandIpFilterCorpus.h"
+
+#define IP_FILTER_CORPUS_SIZE 100000
+
+TEST(IpFilterMatchesOldRegexOnFixedCases)
+{
+	static const char* cases[] = {
+		"", "1.2.3.4", "10.0.0.12 ", "join me at 10.0.0.12 later", "192.168.1.1",
+		"12.34.5", "12.34.5 ", "1234.56.789 ", "12.3456.7 ", "12.34.5678 ",
+		"3 more rounds then 1 v 1 at 10?", "99 99 99 ", "99\xc3\xa9" "99\xc3\xa9" "9\xc3\xa9",
+		"!sfx bonk", "ip: 255.255.255.255!", "1.22.33.4 "
+	};
+
+	for (const char* message : cases)
+	{
+		CHECK_EQUAL(IpFilterCorpus::regexContainsIp(message), CommandIpFilter::containsIp(message));
+	}
+}
+
+TEST(IpFilterMatchesOldRegexOnRandomCorpus)
+{
+	uint32_t seed = 43;
+	size_t flagged = 0, mismatches = 0;
+
+	for (size_t i = 0; i < IP_FILTER_CORPUS_SIZE; i++)
+	{
+		const std::string message = IpFilterCorpus::randomMessage(seed);
+		const bool expected = IpFilterCorpus::regexContainsIp(message);
+		flagged += expected ? 1 : 0;
+		mismatches += expected != CommandIpFilter::containsIp(message.c_str()) ? 1 : 0;
+	}
+
+	CHECK_EQUAL((size_t)0, mismatches);
+
+	// Both outcomes need to be well represented for the comparison to mean anything.
+	CHECK(flagged > IP_FILTER_CORPUS_SIZE / 10);
+	CHECK(flagged < IP_FILTER_CORPUS_SIZE * 9 / 10);
+}
@@ -0,0 +1,33 @@
+#include "Bench.h"
+#include "ChatBotFixture.h"
+
+namespace
+{
+	/** Plain chat, then a line for each kind of pattern, each tier and the IP rule. */
+	const char* DISPATCH_SAMPLES[] = {
+		"gg everyone, that last round was close",
+		"!help",
+		"!sfx bonk",
+		"!unqueue",
+		"!kick 12",
+		"!setconfig",
+		"join me at 192.168.1.12 later"
+	};
+}
+
+BENCH(CommandRegistryDispatch)
+{
+	ChatBotFixture fixture;
+
+	for (const char* line : DISPATCH_SAMPLES)
+	{
+		const char* volatile source = line;	// Reloaded every lap, so the lookup can't be hoisted.
+
+		cout << "  \"" << line << "\"" << endl;
+		Bench::measure("    find", iterations, [&](uint64_t i) {
+			ACommand* command = fixture.chatBot.identifyUserDataMessage(source, fixture.host, true);
+			Bench::keep((int)command->type());
+			CommandArena::release(command);
+		});
+	}
+}
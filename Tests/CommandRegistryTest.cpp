@@ -0,0 +1,209 @@
+#include "Test.h"
+#include "ChatBotFixture.h"
+#include "Stringer.h"
+#include <cctype>
+
+namespace
+{
+	const CommandRegistry::Factory NO_FACTORY = [](const char*, Guest&, bool) -> ACommand* { return nullptr; };
+
+	bool isEqual(const char* msg, const vector<const char*>& patterns)
+	{
+		for (const char* pattern : patterns) if (strcmp(msg, pattern) == 0) return true;
+		return false;
+	}
+
+	bool startsWith(const char* msg, const vector<const char*>& patterns)
+	{
+		for (const char* pattern : patterns) if (Stringer::startsWithPattern(msg, pattern)) return true;
+		return false;
+	}
+
+	/**
+	 * ChatBot::identifyUserDataMessage as it was before CommandRegistry: one if per
+	 * command, in order, with the commands added since slotted in where ChatBot
+	 * registers them.
+	 */
+	COMMAND_TYPE identifyByChain(const char* msg, Tier tier, bool isHost)
+	{
+		if (isEqual(msg, CommandAFK::prefixes()))			return COMMAND_TYPE::AFK;
+		if (startsWith(msg, CommandBonk::prefixes()))		return COMMAND_TYPE::BONK;
+		if (isEqual(msg, CommandFF::prefixes()))			return COMMAND_TYPE::FF;
+		if (isEqual(msg, CommandGrabMouse::prefixes()))		return COMMAND_TYPE::GRABMOUSE;
+		if (isEqual(msg, CommandHelp::prefixes()))			return COMMAND_TYPE::HELP;
+		if (CommandIpFilter::containsIp(msg))				return COMMAND_TYPE::IP;
+		if (isEqual(msg, CommandJoin::prefixes()))			return COMMAND_TYPE::JOIN;
+		if (isEqual(msg, CommandMirror::prefixes()))		return COMMAND_TYPE::MIRROR;
+		if (isEqual(msg, CommandOne::prefixes()))			return COMMAND_TYPE::ONE;
+		if (isEqual(msg, CommandPads::prefixes()))			return COMMAND_TYPE::PADS;
+		if (isEqual(msg, CommandQueue::prefixes()))			return COMMAND_TYPE::QUEUE;
+		if (startsWith(msg, CommandSFX::prefixes()))		return COMMAND_TYPE::SFX;
+		if (startsWith(msg, CommandSwap::prefixes()))		return COMMAND_TYPE::SWAP;
+		if (startsWith(msg, CommandTransform::prefixes()))	return COMMAND_TYPE::TRANSFORM;
+		if (isEqual(msg, CommandUnqueue::prefixes()))		return COMMAND_TYPE::UNQUEUE;
+
+		if (tier >= Tier::ADMIN || isHost)
+		{
+			if (startsWith(msg, CommandBan::prefixes()))		return COMMAND_TYPE::BAN;
+			if (startsWith(msg, CommandDC::prefixes()))			return COMMAND_TYPE::DC;
+			if (startsWith(msg, CommandIdle::prefixes()))		return COMMAND_TYPE::IDLE;
+			if (startsWith(msg, CommandKick::prefixes()))		return COMMAND_TYPE::KICK;
+			if (startsWith(msg, CommandLimit::prefixes()))		return COMMAND_TYPE::LIMIT;
+			if (startsWith(msg, CommandMouse::prefixes()))		return COMMAND_TYPE::MOUSE;
+			if (startsWith(msg, CommandRotate::prefixes()))		return COMMAND_TYPE::ROTATE;
+			if (startsWith(msg, CommandStrip::prefixes()))		return COMMAND_TYPE::TAKE;
+			if (startsWith(msg, CommandUnban::prefixes()))		return COMMAND_TYPE::UNBAN;
+		}
+
+		if (tier >= Tier::GOD || isHost)
+		{
+			if (startsWith(msg, CommandGameId::prefixes()))		return COMMAND_TYPE::GAMEID;
+			if (startsWith(msg, CommandGuests::prefixes()))		return COMMAND_TYPE::GUESTS;
+			if (isEqual(msg, CommandKeymaps::prefixes()))		return COMMAND_TYPE::KEYMAPS;
+			if (startsWith(msg, CommandMic::prefixes()))		return COMMAND_TYPE::MIC;
+			if (startsWith(msg, CommandName::prefixes()))		return COMMAND_TYPE::NAME;
+			if (isEqual(msg, CommandPrivate::prefixes()))		return COMMAND_TYPE::PRIVATE;
+			if (isEqual(msg, CommandPublic::prefixes()))		return COMMAND_TYPE::PUBLIC;
+			if (isEqual(msg, CommandSetConfig::prefixes()))		return COMMAND_TYPE::SETCONFIG;
+			if (startsWith(msg, CommandSpeakers::prefixes()))	return COMMAND_TYPE::SPEAKERS;
+			if (isEqual(msg, CommandQuit::prefixes()))			return COMMAND_TYPE::QUIT;
+		}
+
+		return COMMAND_TYPE::DEFAULT_MESSAGE;
+	}
+
+	/** Every pattern as typed, shouted, with an argument, run on, and carrying an address. */
+	vector<string> makeCorpus()
+	{
+		const vector<vector<const char*>> lists = {
+			CommandAFK::prefixes(), CommandBonk::prefixes(), CommandFF::prefixes(), CommandGrabMouse::prefixes(),
+			CommandHelp::prefixes(), CommandJoin::prefixes(), CommandMirror::prefixes(), CommandOne::prefixes(),
+			CommandPads::prefixes(), CommandQueue::prefixes(), CommandSFX::prefixes(), CommandSwap::prefixes(),
+			CommandTransform::prefixes(), CommandUnqueue::prefixes(), CommandBan::prefixes(), CommandDC::prefixes(),
+			CommandIdle::prefixes(), CommandKick::prefixes(), CommandLimit::prefixes(), CommandMouse::prefixes(),
+			CommandRotate::prefixes(), CommandStrip::prefixes(), CommandUnban::prefixes(), CommandGameId::prefixes(),
+			CommandGuests::prefixes(), CommandKeymaps::prefixes(), CommandMic::prefixes(), CommandName::prefixes(),
+			CommandPrivate::prefixes(), CommandPublic::prefixes(), CommandSetConfig::prefixes(),
+			CommandSpeakers::prefixes(), CommandQuit::prefixes()
+		};
+
+		vector<string> corpus = { "", "!", "gg", "gg everyone, that last round was close", "join me at 192.168.1.12 later" };
+		for (const vector<const char*>& patterns : lists)
+		{
+			for (const char* pattern : patterns)
+			{
+				string upper = pattern;
+				for (char& c : upper) c = (char)toupper((unsigned char)c);
+
+				corpus.push_back(pattern);
+				corpus.push_back(string(pattern) + " 1");
+				corpus.push_back(string(pattern) + "x");
+				corpus.push_back(string(pattern) + " 192.168.1.12 ");
+				corpus.push_back(upper);
+				corpus.push_back(upper + " 2");
+			}
+		}
+		return corpus;
+	}
+}
+
+TEST(RegistryEarlierRegistrationWins)
+{
+	CommandRegistry registry;
+	registry.add({ "!sfx" }, false, Tier::PLEB, NO_FACTORY);
+	registry.add({ "!sfxall" }, true, Tier::PLEB, NO_FACTORY);
+
+	const CommandRegistry::Entry* entry = registry.find("!sfxall", Tier::PLEB, false);
+	REQUIRE(entry != nullptr);
+	CHECK(strcmp(entry->pattern, "!sfx") == 0);
+
+	CommandRegistry reversed;
+	reversed.add({ "!sfxall" }, true, Tier::PLEB, NO_FACTORY);
+	reversed.add({ "!sfx" }, false, Tier::PLEB, NO_FACTORY);
+	entry = reversed.find("!sfxall", Tier::PLEB, false);
+	REQUIRE(entry != nullptr);
+	CHECK(strcmp(entry->pattern, "!sfxall") == 0);
+	CHECK_EQUAL(2u, reversed.size());
+}
+
+TEST(RegistryReservedRankSitsBetweenItsNeighbours)
+{
+	CommandRegistry registry;
+	registry.add({ "!help", "!commands" }, true, Tier::PLEB, NO_FACTORY);
+	const size_t reserved = registry.reserveRank();
+	registry.add({ "!join" }, true, Tier::PLEB, NO_FACTORY);
+
+	CHECK(registry.find("!commands", Tier::PLEB, false)->rank < reserved);
+	CHECK(registry.find("!join", Tier::PLEB, false)->rank > reserved);
+}
+
+TEST(RegistryFoldsCaseForPrefixesOnly)
+{
+	CommandRegistry registry;
+	registry.add({ "!Bonk" }, false, Tier::PLEB, NO_FACTORY);
+	registry.add({ "!ff" }, true, Tier::PLEB, NO_FACTORY);
+
+	CHECK(registry.find("!bonk", Tier::PLEB, false) != nullptr);
+	CHECK(registry.find("!BONK melon", Tier::PLEB, false) != nullptr);
+	CHECK(registry.find("!ff", Tier::PLEB, false) != nullptr);
+	CHECK(registry.find("!FF", Tier::PLEB, false) == nullptr);
+}
+
+TEST(RegistryExactNeedsTheWholeMessage)
+{
+	CommandRegistry registry;
+	registry.add({ "!help" }, true, Tier::PLEB, NO_FACTORY);
+	registry.add({ "!sfx" }, false, Tier::PLEB, NO_FACTORY);
+
+	CHECK(registry.find("!help", Tier::PLEB, false) != nullptr);
+	CHECK(registry.find("!help me", Tier::PLEB, false) == nullptr);
+	CHECK(registry.find("!hel", Tier::PLEB, false) == nullptr);
+	CHECK(registry.find("!sfx", Tier::PLEB, false) != nullptr);
+	CHECK(registry.find("!sfxbonk", Tier::PLEB, false) != nullptr);
+	CHECK(registry.find("!sf", Tier::PLEB, false) == nullptr);
+	CHECK(registry.find("gg", Tier::PLEB, false) == nullptr);
+}
+
+TEST(RegistryGatesEntriesByTier)
+{
+	CommandRegistry registry;
+	registry.add({ "!kick" }, false, Tier::ADMIN, NO_FACTORY);
+	registry.add({ "!q" }, true, Tier::GOD, NO_FACTORY);
+
+	CHECK(registry.find("!kick 12", Tier::PLEB, false) == nullptr);
+	CHECK(registry.find("!kick 12", Tier::ADMIN, false) != nullptr);
+	CHECK(registry.find("!kick 12", Tier::GOD, false) != nullptr);
+	CHECK(registry.find("!q", Tier::ADMIN, false) == nullptr);
+	CHECK(registry.find("!q", Tier::GOD, false) != nullptr);
+
+	// The host passes every check.
+	CHECK(registry.find("!q", Tier::PLEB, true) != nullptr);
+}
+
+TEST(ChatBotDispatchMatchesTheOldChain)
+{
+	ChatBotFixture fixture;
+	const vector<string> corpus = makeCorpus();
+	size_t mismatches = 0;
+
+	for (const string& line : corpus)
+	{
+		const COMMAND_TYPE asGuest = fixture.identify(line.c_str(), fixture.guest);
+		const COMMAND_TYPE asHost = fixture.identify(line.c_str(), fixture.host, true);
+		if (asGuest != identifyByChain(line.c_str(), Tier::PLEB, false) || asHost != identifyByChain(line.c_str(), Tier::PLEB, true))
+		{
+			cout << "  dispatch differs for \"" << line << "\"" << endl;
+			mismatches++;
+		}
+	}
+
+	CHECK_EQUAL((size_t)0, mismatches);
+
+	// The IP filter runs after !help and before !join, as it did in the chain.
+	CHECK(fixture.identify("!bonk 192.168.1.12 ", fixture.guest) == COMMAND_TYPE::BONK);
+	CHECK(fixture.identify("!help", fixture.guest) == COMMAND_TYPE::HELP);
+	CHECK(fixture.identify("!sfx 192.168.1.12 ", fixture.guest) == COMMAND_TYPE::IP);
+	CHECK(fixture.identify("!kick 192.168.1.12 ", fixture.host, true) == COMMAND_TYPE::IP);
+	CHECK(fixture.identify("!kick 12", fixture.guest) == COMMAND_TYPE::DEFAULT_MESSAGE);
+	CHECK(fixture.identify("!kick 12", fixture.host, true) == COMMAND_TYPE::KICK);
+}
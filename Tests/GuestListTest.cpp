@@ -0,0 +1,92 @@
+#include "Test.h"
+#include "ParsecStub.h"
+#include "GuestList.h"
+#include <string>
+
+namespace
+{
+	ParsecGuest makeState(uint32_t id, uint32_t userID, ParsecGuestState state)
+	{
+		ParsecGuest guest = ParsecStub::makeGuest(id, userID, ("guest" + std::to_string(userID)).c_str());
+		guest.state = state;
+		return guest;
+	}
+
+	/** Every guest must be found by user id at its own slot, with its name buffer alongside. */
+	bool isConsistent(GuestList& list)
+	{
+		const vector<Guest> guests = list.getGuests();
+		for (size_t i = 0; i < guests.size(); i++)
+		{
+			Guest found;
+			if (!list.find(guests[i].userID, &found) || found.id != guests[i].id) return false;
+			if (guests[i].name != list.guestNames[i]) return false;
+		}
+		return list.guestNames[guests.size()][0] == '\0';
+	}
+}
+
+TEST(GuestListRemoveMovesLastGuestIntoTheSlot)
+{
+	GuestList list;
+	for (uint32_t i = 1; i <= 4; i++)
+	{
+		CHECK(list.onStateChange(makeState(i, 100 + i, GUEST_CONNECTED)));
+	}
+
+	CHECK(list.onStateChange(makeState(2, 102, GUEST_DISCONNECTED)));
+
+	const vector<Guest> guests = list.getGuests();
+	REQUIRE(guests.size() == 3);
+	CHECK_EQUAL(101u, guests[0].userID);
+	CHECK_EQUAL(104u, guests[1].userID);
+	CHECK_EQUAL(103u, guests[2].userID);
+	CHECK(isConsistent(list));
+
+	Guest found;
+	CHECK(!list.find(102u, &found));
+	CHECK(!list.onStateChange(makeState(2, 102, GUEST_DISCONNECTED)));
+}
+
+TEST(GuestListFindsByUserIdThroughChurn)
+{
+	GuestList list;
+	uint32_t seed = 7;
+	bool isIn[GUESTLIST_MAX_GUESTS * 2] = {};
+
+	for (int step = 0; step < 5000; step++)
+	{
+		seed = seed * 1103515245u + 12345u;
+		const uint32_t slot = (seed >> 16) % (GUESTLIST_MAX_GUESTS * 2);
+		const bool isJoin = ((seed >> 8) & 1) != 0;
+		const bool isFull = list.getGuests().size() >= GUESTLIST_MAX_GUESTS;
+		const bool expected = isJoin ? (!isIn[slot] && !isFull) : isIn[slot];
+
+		CHECK_EQUAL(expected, list.onStateChange(makeState(slot + 1, 1000 + slot, isJoin ? GUEST_CONNECTED : GUEST_DISCONNECTED)));
+		if (expected) isIn[slot] = isJoin;
+	}
+
+	REQUIRE(isConsistent(list));
+	for (uint32_t slot = 0; slot < GUESTLIST_MAX_GUESTS * 2; slot++)
+	{
+		Guest found;
+		CHECK_EQUAL(isIn[slot], list.find(1000 + slot, &found));
+	}
+}
+
+TEST(GuestListSnapshotOutlivesChanges)
+{
+	GuestList list;
+	CHECK(list.onStateChange(makeState(1, 101, GUEST_CONNECTED)));
+	CHECK(list.onStateChange(makeState(2, 102, GUEST_CONNECTED)));
+
+	const vector<Guest> snapshot = list.getGuests();
+	CHECK(list.onStateChange(makeState(1, 101, GUEST_DISCONNECTED)));
+	CHECK(list.onStateChange(makeState(3, 103, GUEST_CONNECTED)));
+
+	REQUIRE(snapshot.size() == 2);
+	CHECK_EQUAL(101u, snapshot[0].userID);
+	CHECK(snapshot[0].name == "guest101");
+	CHECK_EQUAL(102u, snapshot[1].userID);
+	CHECK_EQUAL(2u, list.getGuests().size());
+}
@@ -0,0 +1,145 @@
+#include "Test.h"
+#include "InputRateLimiter.h"
+#include "Gamepad.h"
+#include "ViGEmStub.h"
+#include <cstring>
+
+namespace
+{
+	ParsecGuest makeGuest()
+	{
+		ParsecGuest guest;
+		memset(&guest, 0, sizeof(guest));
+		guest.id = 3;
+		guest.userID = 3003;
+		return guest;
+	}
+
+	ParsecMessage makeState(uint32_t padId, uint16_t buttons, int16_t thumbLX)
+	{
+		ParsecMessage message;
+		memset(&message, 0, sizeof(message));
+		message.type = MESSAGE_GAMEPAD_STATE;
+		message.gamepadState.id = padId;
+		message.gamepadState.buttons = buttons;
+		message.gamepadState.thumbLX = thumbLX;
+		return message;
+	}
+
+	ParsecMessage makeButton(uint32_t padId, ParsecGamepadButton button, bool pressed)
+	{
+		ParsecMessage message;
+		memset(&message, 0, sizeof(message));
+		message.type = MESSAGE_GAMEPAD_BUTTON;
+		message.gamepadButton.id = padId;
+		message.gamepadButton.button = button;
+		message.gamepadButton.pressed = pressed;
+		return message;
+	}
+
+	/** One state message per second, no burst: easy to tell passes from coalesces. */
+	InputRateLimiter makeStrictLimiter()
+	{
+		InputRateLimiter limiter;
+		limiter.setBudget(InputRateLimiter::Channel::STATE, { 1, 1 });
+		return limiter;
+	}
+}
+
+TEST(RateLimiterPassClearsPendingStateOfSamePad)
+{
+	InputRateLimiter limiter = makeStrictLimiter();
+	const ParsecGuest guest = makeGuest();
+
+	CHECK(limiter.check(guest, makeState(0, GAMEPAD_STATE_A, 0), 1) == InputRateLimiter::Verdict::PASS);
+	CHECK(limiter.check(guest, makeState(0, GAMEPAD_STATE_A, 100), 2) == InputRateLimiter::Verdict::COALESCED);
+
+	// A second later the newer state goes through on its own; the older one must not follow it.
+	CHECK(limiter.check(guest, makeState(0, 0, 0), 1000002) == InputRateLimiter::Verdict::PASS);
+
+	int sent = 0;
+	limiter.flush(3000000, [&](ParsecGuest&, ParsecMessage&, uint64_t) { sent++; });
+	CHECK_EQUAL(0, sent);
+}
+
+TEST(RateLimiterReleasePatchesPendingState)
+{
+	InputRateLimiter limiter = makeStrictLimiter();
+	const ParsecGuest guest = makeGuest();
+
+	limiter.check(guest, makeState(0, 0, 0), 1);
+	CHECK(limiter.check(guest, makeState(0, GAMEPAD_STATE_A | GAMEPAD_STATE_B, 0), 2) == InputRateLimiter::Verdict::COALESCED);
+	CHECK(limiter.check(guest, makeButton(0, GAMEPAD_BUTTON_A, false), 3) == InputRateLimiter::Verdict::PASS);
+
+	uint16_t flushed = 0xFFFF;
+	limiter.flush(2000000, [&](ParsecGuest&, ParsecMessage& message, uint64_t) { flushed = message.gamepadState.buttons; });
+	CHECK_EQUAL(GAMEPAD_STATE_B, flushed);
+}
+
+TEST(RateLimiterKeepsOnePendingStatePerPad)
+{
+	InputRateLimiter limiter = makeStrictLimiter();
+	limiter.setBudget(InputRateLimiter::Channel::STATE, { 1, 2 });
+	const ParsecGuest guest = makeGuest();
+
+	limiter.check(guest, makeState(0, 0, 0), 1);
+	limiter.check(guest, makeState(1, 0, 0), 1);
+	CHECK(limiter.check(guest, makeState(0, GAMEPAD_STATE_X, 10), 2) == InputRateLimiter::Verdict::COALESCED);
+	CHECK(limiter.check(guest, makeState(1, GAMEPAD_STATE_Y, 20), 2) == InputRateLimiter::Verdict::COALESCED);
+	CHECK(limiter.check(guest, makeState(0, GAMEPAD_STATE_X, 30), 3) == InputRateLimiter::Verdict::COALESCED);
+
+	vector<ParsecGamepadStateMessage> flushed;
+	limiter.flush(5000000, [&](ParsecGuest&, ParsecMessage& message, uint64_t) { flushed.push_back(message.gamepadState); });
+	REQUIRE(flushed.size() == 2);
+	CHECK_EQUAL(0u, flushed[0].id);
+	CHECK_EQUAL(30, flushed[0].thumbLX);
+	CHECK_EQUAL(1u, flushed[1].id);
+	CHECK_EQUAL(GAMEPAD_STATE_Y, flushed[1].buttons);
+}
+
+TEST(RateLimiterFloodEndsOnLatestStatePerPad)
+{
+	ViGEmStub::reset();
+	PVIGEM_CLIENT client = vigem_alloc();
+	REQUIRE(VIGEM_SUCCESS(vigem_connect(client)));
+
+	{
+		Gamepad pads[2] = { { nullptr, client }, { nullptr, client } };
+		REQUIRE(pads[0].connect(false) && pads[1].connect(false));
+
+		InputRateLimiter limiter;
+		ParsecGuest guest = makeGuest();
+		auto send = [&](ParsecGuest&, ParsecMessage& message, uint64_t) { pads[message.gamepadState.id].setState(message.gamepadState); };
+
+		// Two pads mashing A at 20 kHz for half a second, flushed every millisecond; both let go at the end.
+		const int messageCount = 10000;
+		uint64_t nowUs = 1;
+		for (int i = 0; i < messageCount; i++, nowUs += 50)
+		{
+			const bool isLast = (i >= messageCount - 2);
+			ParsecMessage message = makeState(i & 1, (!isLast && (i & 2)) ? GAMEPAD_STATE_A : 0, isLast ? 1234 : (int16_t)i);
+			if (limiter.check(guest, message, nowUs) == InputRateLimiter::Verdict::PASS)
+			{
+				send(guest, message, nowUs);
+			}
+			if (i % 20 == 0) limiter.flush(nowUs, send);
+		}
+		limiter.flush(nowUs + 1000000, send);
+
+		CHECK(limiter.getStats().coalesced > 0);
+		for (Gamepad& pad : pads)
+		{
+			PVIGEM_TARGET target = ViGEmStub::findTarget(pad.getBusIndex());
+			REQUIRE(target != nullptr);
+
+			const vector<XUSB_REPORT>& reports = ViGEmStub::x360Reports(target);
+			REQUIRE(!reports.empty());
+			CHECK(reports.size() < (size_t)messageCount / 2);
+			CHECK_EQUAL(0, reports.back().wButtons);
+			CHECK_EQUAL(1234, reports.back().sThumbLX);
+		}
+	}
+
+	vigem_disconnect(client);
+	vigem_free(client);
+}
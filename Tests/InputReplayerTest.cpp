@@ -0,0 +1,116 @@
+#include "Test.h"
+#include "ParsecStub.h"
+#include "ViGEmStub.h"
+#include "InputRecorder.h"
+#include "InputReplayer.h"
+#include <cstdlib>
+
+namespace
+{
+	string makeTracePath()
+	{
+		char path[] = "/tmp/parsecsoda-trace-XXXXXX";
+		return (mkdtemp(path) != nullptr) ? string(path) + "/" + INPUT_TRACE_FILENAME : string(INPUT_TRACE_FILENAME);
+	}
+
+	ParsecMessage button(ParsecGamepadButton which, bool pressed)
+	{
+		ParsecMessage message = {};
+		message.type = MESSAGE_GAMEPAD_BUTTON;
+		message.gamepadButton.button = which;
+		message.gamepadButton.pressed = pressed;
+		return message;
+	}
+
+	ParsecMessage axis(ParsecGamepadAxis which, int16_t value)
+	{
+		ParsecMessage message = {};
+		message.type = MESSAGE_GAMEPAD_AXIS;
+		message.gamepadAxis.axis = which;
+		message.gamepadAxis.value = value;
+		return message;
+	}
+}
+
+TEST(ReplayedTraceLeavesPadsWhereTheGuestsLeftThem)
+{
+	const string path = makeTracePath();
+	const ParsecGuest alice = ParsecStub::makeGuest(7, 1001, "alice");
+	const ParsecGuest bob = ParsecStub::makeGuest(8, 1002, "bob");
+
+	InputRecorder recorder;
+	REQUIRE(recorder.start(path));
+	recorder.record(alice, button(GAMEPAD_BUTTON_A, true));
+	recorder.record(alice, axis(GAMEPAD_AXIS_LX, 12000));
+	recorder.record(bob, button(GAMEPAD_BUTTON_B, true));
+	recorder.record(alice, button(GAMEPAD_BUTTON_A, false));
+	recorder.record(bob, button(GAMEPAD_BUTTON_B, true));
+	recorder.record(bob, axis(GAMEPAD_AXIS_LY, 8000));
+	recorder.record(bob, axis(GAMEPAD_AXIS_TRIGGERR, 200));
+	recorder.stop();
+	CHECK_EQUAL(7u, recorder.recordedCount());
+
+	vector<InputReplayer::Entry> entries;
+	REQUIRE(InputReplayer::load(path, entries));
+	REQUIRE(entries.size() == 7);
+	CHECK_EQUAL(1001u, entries[0].guest.userID);
+	CHECK(entries[2].guest.name == "bob");
+
+	ViGEmStub::reset();
+	ParsecDSO* parsec = ParsecStub::create();
+	{
+		GamepadClient client;
+		client.setParsec(parsec);
+		REQUIRE(client.init());
+		client.createGamepad(0);
+		client.createGamepad(1);
+		client.connectAllGamepads();
+		REQUIRE(ViGEmStub::attachedCount() == 2);
+
+		// Stepped the way the input thread does it, a few entries at a time.
+		InputReplayer replayer;
+		REQUIRE(replayer.start(path));
+		CHECK(replayer.isActive());
+		CHECK(replayer.isTraceGuest(1002));
+		CHECK(!replayer.isTraceGuest(1003));
+		while (!replayer.step(client));
+		const InputReplayer::Report report = replayer.finish(client);
+		CHECK(!replayer.isActive());
+
+		REQUIRE(report.isValid);
+		CHECK_EQUAL(7u, report.messageCount);
+		REQUIRE(report.padStates.size() == 2);
+
+		// A guest's first request only claims a free pad; everything after lands on it.
+		CHECK_EQUAL(1001u, report.padStates[0].ownerUserID);
+		CHECK_EQUAL(0, report.padStates[0].state.Gamepad.wButtons);
+		CHECK_EQUAL(12000, report.padStates[0].state.Gamepad.sThumbLX);
+
+		CHECK_EQUAL(1002u, report.padStates[1].ownerUserID);
+		CHECK_EQUAL(XUSB_GAMEPAD_B, report.padStates[1].state.Gamepad.wButtons);
+		CHECK_EQUAL(-8000, report.padStates[1].state.Gamepad.sThumbLY);
+		CHECK_EQUAL(200, report.padStates[1].state.Gamepad.bRightTrigger);
+
+		// The bus saw the same thing the pads hold.
+		const shared_ptr<const GamepadTable> table = client.getTable();
+		const vector<XUSB_REPORT>& aliceReports = ViGEmStub::x360Reports(ViGEmStub::findTarget(table->slots[0].pad->getBusIndex()));
+		const vector<XUSB_REPORT>& bobReports = ViGEmStub::x360Reports(ViGEmStub::findTarget(table->slots[1].pad->getBusIndex()));
+		REQUIRE(!aliceReports.empty() && !bobReports.empty());
+		CHECK_EQUAL(0, aliceReports.back().wButtons);
+		CHECK_EQUAL(12000, aliceReports.back().sThumbLX);
+		CHECK_EQUAL(XUSB_GAMEPAD_B, bobReports.back().wButtons);
+		CHECK_EQUAL(200, bobReports.back().bRightTrigger);
+
+		client.release();
+	}
+	ParsecDestroy(parsec);
+}
+
+TEST(ReplayOfAMissingTraceIsInvalid)
+{
+	GamepadClient client;
+	InputReplayer replayer;
+	CHECK(!replayer.start(string("/nonexistent/") + INPUT_TRACE_FILENAME));
+	CHECK(!replayer.isActive());
+	CHECK(!InputReplayer::replay(string("/nonexistent/") + INPUT_TRACE_FILENAME, client).isValid);
+}
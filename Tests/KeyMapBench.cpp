@@ -0,0 +1,110 @@
+#include "Bench.h"
+#include "KeyMap.h"
+#include "Gamepad.h"
+#include "Bitwise.h"
+#include <random>
+
+namespace
+{
+	/** Keyboard translation as it was before KeyMap: one switch over both layouts. */
+	bool translateBySwitch(const ParsecKeyboardMessage& key, XINPUT_GAMEPAD& gamepad)
+	{
+		switch (key.code)
+		{
+		case (int)KEY_TO_GAMEPAD::LEFT:		case (int)KEY_TO_GAMEPAD2::LEFT:	gamepad.sThumbLX = (key.pressed ? GAMEPAD_STICK_MIN : 0); break;
+		case (int)KEY_TO_GAMEPAD::RIGHT:	case (int)KEY_TO_GAMEPAD2::RIGHT:	gamepad.sThumbLX = (key.pressed ? GAMEPAD_STICK_MAX : 0); break;
+		case (int)KEY_TO_GAMEPAD::UP:		case (int)KEY_TO_GAMEPAD2::UP:		gamepad.sThumbLY = (key.pressed ? GAMEPAD_STICK_MAX : 0); break;
+		case (int)KEY_TO_GAMEPAD::DOWN:		case (int)KEY_TO_GAMEPAD2::DOWN:	gamepad.sThumbLY = (key.pressed ? GAMEPAD_STICK_MIN : 0); break;
+		case (int)KEY_TO_GAMEPAD::A:		case (int)KEY_TO_GAMEPAD2::A:		Bitwise::setValue(&gamepad.wButtons, XUSB_GAMEPAD_A, key.pressed); break;
+		case (int)KEY_TO_GAMEPAD::B:		case (int)KEY_TO_GAMEPAD2::B:		Bitwise::setValue(&gamepad.wButtons, XUSB_GAMEPAD_B, key.pressed); break;
+		case (int)KEY_TO_GAMEPAD::X:		case (int)KEY_TO_GAMEPAD2::X:		Bitwise::setValue(&gamepad.wButtons, XUSB_GAMEPAD_X, key.pressed); break;
+		case (int)KEY_TO_GAMEPAD::Y:		case (int)KEY_TO_GAMEPAD2::Y:		Bitwise::setValue(&gamepad.wButtons, XUSB_GAMEPAD_Y, key.pressed); break;
+		case (int)KEY_TO_GAMEPAD::BACK:		case (int)KEY_TO_GAMEPAD2::BACK:	Bitwise::setValue(&gamepad.wButtons, XUSB_GAMEPAD_BACK, key.pressed); break;
+		case (int)KEY_TO_GAMEPAD::START:	case (int)KEY_TO_GAMEPAD2::START:	Bitwise::setValue(&gamepad.wButtons, XUSB_GAMEPAD_START, key.pressed); break;
+		case (int)KEY_TO_GAMEPAD::LB:		case (int)KEY_TO_GAMEPAD2::LB:		Bitwise::setValue(&gamepad.wButtons, XUSB_GAMEPAD_LEFT_SHOULDER, key.pressed); break;
+		case (int)KEY_TO_GAMEPAD::RB:		case (int)KEY_TO_GAMEPAD2::RB:		Bitwise::setValue(&gamepad.wButtons, XUSB_GAMEPAD_RIGHT_SHOULDER, key.pressed); break;
+		case (int)KEY_TO_GAMEPAD::LT:		case (int)KEY_TO_GAMEPAD2::LT:		gamepad.bLeftTrigger = (BYTE)(key.pressed ? GAMEPAD_STICK_MAX : GAMEPAD_STICK_MIN); break;
+		case (int)KEY_TO_GAMEPAD::RT:		case (int)KEY_TO_GAMEPAD2::RT:		gamepad.bRightTrigger = (BYTE)(key.pressed ? GAMEPAD_STICK_MAX : GAMEPAD_STICK_MIN); break;
+		case (int)KEY_TO_GAMEPAD::LTHUMB:	case (int)KEY_TO_GAMEPAD2::LTHUMB:	Bitwise::setValue(&gamepad.wButtons, XUSB_GAMEPAD_LEFT_THUMB, key.pressed); break;
+		case (int)KEY_TO_GAMEPAD::RTHUMB:	case (int)KEY_TO_GAMEPAD2::RTHUMB:	Bitwise::setValue(&gamepad.wButtons, XUSB_GAMEPAD_RIGHT_THUMB, key.pressed); break;
+		default: return false;
+		}
+		return true;
+	}
+
+	/** The same translation through the table, as Gamepad::setState(ParsecKeyboardMessage, KeyMap) does it. */
+	bool translateByTable(const ParsecKeyboardMessage& key, const KeyMap& keyMap, XINPUT_GAMEPAD& gamepad)
+	{
+		const KeyAction& action = keyMap.get(key.code);
+		if (action.isEmpty()) return false;
+
+		gamepad.wButtons = (gamepad.wButtons & ~action.button) | (key.pressed ? action.button : 0);
+
+		const int16_t value = (key.pressed ? action.value : 0);
+		switch (action.axis)
+		{
+		case KeyAction::Axis::LX: gamepad.sThumbLX = value; break;
+		case KeyAction::Axis::LY: gamepad.sThumbLY = value; break;
+		case KeyAction::Axis::LT: gamepad.bLeftTrigger = (BYTE)value; break;
+		case KeyAction::Axis::RT: gamepad.bRightTrigger = (BYTE)value; break;
+		default: break;
+		}
+		return true;
+	}
+
+	bool isSame(const XINPUT_GAMEPAD& a, const XINPUT_GAMEPAD& b)
+	{
+		return a.wButtons == b.wButtons && a.sThumbLX == b.sThumbLX && a.sThumbLY == b.sThumbLY
+			&& a.bLeftTrigger == b.bLeftTrigger && a.bRightTrigger == b.bRightTrigger;
+	}
+
+	/** Keystrokes as a guest sends them: mostly bound keys, some typing, the odd media key past the table. */
+	vector<ParsecKeyboardMessage> makeKeystrokes(size_t count)
+	{
+		mt19937 random(29);
+		uniform_int_distribution<uint32_t> anyKey(0, KEYMAP_SIZE + 64);
+
+		vector<ParsecKeyboardMessage> keys(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			keys[i].code = (ParsecKeycode)anyKey(random);
+			keys[i].mod = (ParsecKeymod)0;
+			keys[i].pressed = (random() & 1) != 0;
+		}
+		return keys;
+	}
+}
+
+BENCH(KeyMapLookup)
+{
+	const vector<ParsecKeyboardMessage> keys = makeKeystrokes(4096);
+
+	// Every keycode, pressed and released, must come out the same both ways.
+	for (uint32_t code = 0; code < KEYMAP_SIZE + 64; code++)
+	{
+		for (int pressed = 0; pressed < 2; pressed++)
+		{
+			ParsecKeyboardMessage key = { (ParsecKeycode)code, (ParsecKeymod)0, pressed != 0 };
+			XINPUT_GAMEPAD bySwitch = {}, byTable = {};
+			const bool switchBound = translateBySwitch(key, bySwitch);
+			const bool tableBound = translateByTable(key, KeyMap::DEFAULT, byTable);
+			if (switchBound != tableBound || !isSame(bySwitch, byTable))
+			{
+				Bench::fail("KeyMap::DEFAULT disagrees with the layout switch");
+				return;
+			}
+		}
+	}
+
+	XINPUT_GAMEPAD gamepad = {};
+	Bench::measure("switch", iterations, [&](uint64_t i) {
+		Bench::keep(translateBySwitch(keys[i & 4095], gamepad));
+	});
+	Bench::keep(gamepad.wButtons);
+
+	gamepad = {};
+	Bench::measure("table", iterations, [&](uint64_t i) {
+		Bench::keep(translateByTable(keys[i & 4095], KeyMap::DEFAULT, gamepad));
+	});
+	Bench::keep(gamepad.wButtons);
+}
@@ -0,0 +1,128 @@
+#include "Test.h"
+#include "MouseRouter.h"
+#include <cstring>
+
+namespace
+{
+	ParsecMessage makeMotion(int32_t x, int32_t y, bool relative = true)
+	{
+		ParsecMessage message;
+		memset(&message, 0, sizeof(message));
+		message.type = MESSAGE_MOUSE_MOTION;
+		message.mouseMotion.x = x;
+		message.mouseMotion.y = y;
+		message.mouseMotion.relative = relative;
+		return message;
+	}
+
+	ParsecMessage makeButton(ParsecMouseButton button, bool pressed)
+	{
+		ParsecMessage message;
+		memset(&message, 0, sizeof(message));
+		message.type = MESSAGE_MOUSE_BUTTON;
+		message.mouseButton.button = button;
+		message.mouseButton.pressed = pressed;
+		return message;
+	}
+
+	ParsecMessage makeWheel(int32_t x, int32_t y)
+	{
+		ParsecMessage message;
+		memset(&message, 0, sizeof(message));
+		message.type = MESSAGE_MOUSE_WHEEL;
+		message.mouseWheel.x = x;
+		message.mouseWheel.y = y;
+		return message;
+	}
+
+	const uint32_t ALICE = 101;
+	const uint32_t BOB = 202;
+}
+
+TEST(MouseRouterOnlyHolderDrivesTheMouse)
+{
+	RecordingMouseBackend backend;
+	MouseRouter router;
+	router.setBackend(&backend);
+
+	// Nobody holds it yet: messages are counted but go nowhere.
+	CHECK(router.route(ALICE, makeMotion(5, 5)));
+	router.flush();
+	CHECK(backend.getEvents().empty());
+
+	CHECK(router.togglePermission(ALICE));
+	CHECK_EQUAL(ALICE, router.getHolder());
+	router.togglePermission(BOB);
+	CHECK_EQUAL(ALICE, router.getHolder());
+
+	router.route(ALICE, makeMotion(3, -1));
+	router.route(BOB, makeMotion(100, 100));
+	router.route(ALICE, makeMotion(2, 4));
+	router.route(ALICE, makeWheel(0, 120));
+	router.flush();
+
+	const vector<RecordingMouseBackend::Event> events = backend.getEvents();
+	REQUIRE(events.size() == 2);
+	CHECK(events[0].action == RecordingMouseBackend::Action::MOVE);
+	CHECK_EQUAL(5, events[0].x);
+	CHECK_EQUAL(3, events[0].y);
+	CHECK(events[1].action == RecordingMouseBackend::Action::WHEEL);
+	CHECK_EQUAL(120, events[1].y);
+
+	CHECK(!router.route(ALICE, ParsecMessage()));
+	CHECK_EQUAL(5u, router.getStats().received);
+	CHECK_EQUAL(2u, router.getStats().injected);
+}
+
+TEST(MouseRouterButtonsFlushPendingMotionFirst)
+{
+	RecordingMouseBackend backend;
+	MouseRouter router;
+	router.setBackend(&backend);
+	router.togglePermission(ALICE);
+
+	router.route(ALICE, makeMotion(7, 0));
+	router.route(ALICE, makeButton(MOUSE_L, true));
+	router.route(ALICE, makeMotion(640, 360, false));
+
+	const vector<RecordingMouseBackend::Event> events = backend.getEvents();
+	REQUIRE(events.size() == 3);
+	CHECK(events[0].action == RecordingMouseBackend::Action::MOVE);
+	CHECK(events[1].action == RecordingMouseBackend::Action::BUTTON);
+	CHECK(events[1].pressed);
+	CHECK(events[2].action == RecordingMouseBackend::Action::MOVE_TO);
+	CHECK_EQUAL(640, events[2].x);
+}
+
+TEST(MouseRouterHandoffDropsPreviousHolderInput)
+{
+	RecordingMouseBackend backend;
+	MouseRouter router;
+	router.setBackend(&backend);
+	router.togglePermission(ALICE);
+	router.togglePermission(BOB);
+
+	// Alice's motion is still waiting for the tick when Bob takes over.
+	router.route(ALICE, makeMotion(50, 50));
+	CHECK(router.grab(BOB));
+	router.route(ALICE, makeMotion(1, 1));
+	router.route(BOB, makeMotion(-2, 0));
+	router.flush();
+
+	vector<RecordingMouseBackend::Event> events = backend.getEvents();
+	REQUIRE(events.size() == 1);
+	CHECK_EQUAL(-2, events[0].x);
+	CHECK_EQUAL(0, events[0].y);
+
+	// Losing permission or leaving hands the mouse to nobody.
+	backend.clear();
+	CHECK(!router.togglePermission(BOB));
+	CHECK_EQUAL(MOUSE_HOLDER_NONE, router.getHolder());
+	CHECK(!router.grab(BOB));
+	CHECK(router.grab(ALICE));
+	router.onGuestLeft(ALICE);
+	CHECK_EQUAL(MOUSE_HOLDER_NONE, router.getHolder());
+	router.route(ALICE, makeButton(MOUSE_L, true));
+	router.flush();
+	CHECK(backend.getEvents().empty());
+}
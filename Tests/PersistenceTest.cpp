@@ -0,0 +1,74 @@
+#include "Test.h"
+#include "PersistenceWorker.h"
+#include "GuestPreferences.h"
+#include "PadQueue.h"
+#include "matoya.h"
+#include <cstdlib>
+
+namespace
+{
+	/** A fresh directory under /tmp for each test; files are left for inspection on failure. */
+	string makeTempDir()
+	{
+		char path[] = "/tmp/parsecsoda-test-XXXXXX";
+		return (mkdtemp(path) != nullptr) ? string(path) + "/" : string("./");
+	}
+}
+
+TEST(PreferencesSaveOnTheWorker)
+{
+	const string path = makeTempDir() + GUEST_PREFERENCES_FILENAME;
+
+	PersistenceWorker persistence;
+	persistence.start();
+
+	GuestPreferencesStore store;
+	store.setPersistence(&persistence);
+	store.edit(42, [](GuestPreferences& prefs) { prefs.padLimit = 3; prefs.mirror = true; });
+	CHECK(store.isDirty());
+
+	// flush() only hands the snapshot over; the worker writes it.
+	CHECK(store.flush(path));
+	CHECK(!store.isDirty());
+	persistence.flush();
+	CHECK(MTY_FileExists(path.c_str()));
+	CHECK_EQUAL(1u, persistence.getStats(PersistenceWorker::Target::PREFERENCES).writes);
+
+	// Nothing changed since: nothing more to write.
+	CHECK(store.flush(path));
+	CHECK_EQUAL(1u, persistence.getStats(PersistenceWorker::Target::PREFERENCES).submitted);
+
+	GuestPreferencesStore loaded;
+	CHECK_EQUAL(1u, loaded.load(path));
+	CHECK_EQUAL(3, loaded.get(42).padLimit);
+	CHECK(loaded.get(42).mirror);
+
+	persistence.stop();
+}
+
+TEST(PadQueueSavesOnTheWorker)
+{
+	const string path = makeTempDir() + PAD_QUEUE_FILENAME;
+
+	PersistenceWorker persistence;
+	persistence.start();
+
+	PadQueue queue;
+	queue.setPersistence(&persistence);
+	queue.join(Guest("alice", 1001, 1), 2);
+	queue.join(Guest("bob", 1002, 2), 0, true);
+	queue.setRotation(1, 90);
+	CHECK(queue.save(path));
+
+	persistence.stop();
+	CHECK_EQUAL(1u, persistence.getStats(PersistenceWorker::Target::PAD_QUEUE).writes);
+
+	PadQueue loaded;
+	CHECK_EQUAL(2u, loaded.load(path));
+	const vector<PadQueue::Entry> entries = loaded.getEntries();
+	REQUIRE(entries.size() == 2);
+	CHECK(entries[0].name == "alice");
+	CHECK_EQUAL(2u, entries[0].deviceID);
+	CHECK(entries[1].isKeyboard);
+	CHECK_EQUAL(90u, loaded.getRotation(1));
+}
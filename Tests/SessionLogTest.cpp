@@ -0,0 +1,219 @@
+#include "Test.h"
+#include "SessionLog.h"
+#include "SessionLogReader.h"
+#include <cstdlib>
+
+namespace
+{
+	typedef SessionLogFormat::Kind Kind;
+
+	string makeTempDir()
+	{
+		char path[] = "/tmp/parsecsoda-sessions-XXXXXX";
+		return (mkdtemp(path) != nullptr) ? string(path) + "/" : string("./");
+	}
+
+	/** One record framed the way SessionLog frames it. */
+	vector<uint8_t> frame(uint64_t timeMs, uint32_t userID, const string& name, const string& text)
+	{
+		SessionLogFormat::RecordHeader header;
+		header.timeMs = timeMs;
+		header.userID = userID;
+		header.kind = (uint8_t)Kind::CHAT;
+		header.nameLength = (uint8_t)name.size();
+		header.textLength = (uint16_t)text.size();
+		header.size = (uint32_t)(sizeof(header) + name.size() + text.size());
+		header.checksum = 0;
+
+		vector<uint8_t> bytes(header.size);
+		memcpy(bytes.data(), &header, sizeof(header));
+		memcpy(bytes.data() + sizeof(header), name.data(), name.size());
+		memcpy(bytes.data() + sizeof(header) + name.size(), text.data(), text.size());
+
+		header.checksum = SessionLogFormat::checksum(bytes.data(), bytes.size());
+		memcpy(bytes.data(), &header, sizeof(header));
+		return bytes;
+	}
+
+	/** A session file as SessionLog would have named it, holding body after the file header. */
+	void writeSession(const string& directory, uint64_t startMs, const vector<uint8_t>& body)
+	{
+		SessionLogFormat::FileHeader header;
+		header.magic = SESSION_LOG_MAGIC;
+		header.version = SESSION_LOG_VERSION;
+		header.reserved = 0;
+		header.startMs = startMs;
+
+		vector<uint8_t> bytes(sizeof(header));
+		memcpy(bytes.data(), &header, sizeof(header));
+		bytes.insert(bytes.end(), body.begin(), body.end());
+
+		char name[64];
+		snprintf(name, sizeof(name), SESSION_LOG_FILE_PREFIX "%016llu" SESSION_LOG_EXTENSION, (unsigned long long)startMs);
+		MTY_WriteFile((directory + name).c_str(), bytes.data(), bytes.size());
+	}
+
+	void append(vector<uint8_t>& to, const vector<uint8_t>& bytes)
+	{
+		to.insert(to.end(), bytes.begin(), bytes.end());
+	}
+
+	/** Waits for the writer to finish another batch. */
+	bool waitForWrite(SessionLog& log, uint64_t bytesBefore)
+	{
+		for (int i = 0; i < 200; i++)
+		{
+			if (log.getStats().bytes > bytesBefore) return true;
+			this_thread::sleep_for(chrono::milliseconds(10));
+		}
+		return false;
+	}
+}
+
+TEST(SessionLogRecordsReadBackAsWritten)
+{
+	const string dir = makeTempDir();
+	const string longName(300, 'n');
+	const string longText(SESSION_LOG_MAX_TEXT + 100, 't');
+
+	SessionLog log;
+	REQUIRE(log.start(dir));
+	log.record(Kind::CHAT, 1001, "alice", "gg everyone");
+	log.record(Kind::COMMAND, 0, nullptr, "!pads");
+	log.record(Kind::JOIN, 1002, longName.c_str(), longText.c_str());
+
+	// Stopped straight away: the last batch is written on the way out, not lost.
+	log.stop();
+	log.record(Kind::LEAVE, 1002, "bob", nullptr);
+	CHECK_EQUAL((uint64_t)3, log.getStats().records);
+
+	const vector<SessionLogReader::Entry> entries = SessionLogReader::tail(dir);
+	REQUIRE(entries.size() == 3);
+
+	CHECK(entries[0].kind == Kind::CHAT);
+	CHECK_EQUAL(1001u, entries[0].userID);
+	CHECK(entries[0].name == "alice");
+	CHECK(entries[0].text == "gg everyone");
+
+	CHECK(entries[1].kind == Kind::COMMAND);
+	CHECK_EQUAL(0u, entries[1].userID);
+	CHECK(entries[1].name.empty());
+	CHECK(entries[1].text == "!pads");
+
+	// Names stop at 255 bytes and text at SESSION_LOG_MAX_TEXT.
+	CHECK(entries[2].kind == Kind::JOIN);
+	CHECK_EQUAL((size_t)UINT8_MAX, entries[2].name.size());
+	CHECK_EQUAL((size_t)SESSION_LOG_MAX_TEXT, entries[2].text.size());
+	CHECK(entries[0].timeMs <= entries[2].timeMs);
+}
+
+TEST(SessionLogReaderStopsAtATornTail)
+{
+	const string dir = makeTempDir();
+
+	vector<uint8_t> body;
+	append(body, frame(1100, 1001, "alice", "first"));
+	append(body, frame(1200, 1002, "bob", "second"));
+
+	// The writer died partway through a third frame.
+	const vector<uint8_t> torn = frame(1300, 1001, "alice", "third");
+	body.insert(body.end(), torn.begin(), torn.begin() + torn.size() / 2);
+	writeSession(dir, 1000, body);
+
+	vector<SessionLogReader::Entry> entries = SessionLogReader::tail(dir);
+	REQUIRE(entries.size() == 2);
+	CHECK(entries[0].text == "first");
+	CHECK(entries[1].text == "second");
+
+	// A frame whose bytes don't match its checksum ends the walk the same way.
+	body[body.size() - torn.size() / 2 - 1] ^= 0xFF;
+	writeSession(dir, 1000, body);
+	entries = SessionLogReader::tail(dir);
+	REQUIRE(entries.size() == 1);
+	CHECK(entries[0].text == "first");
+}
+
+TEST(SessionLogRotatesAndKeepsTheNewestFiles)
+{
+	const string dir = makeTempDir();
+
+	// Any batch overruns a 1 byte file, so every batch starts a new one.
+	SessionLog::Limits limits;
+	limits.maxFileBytes = 1;
+	limits.keepFiles = 2;
+
+	SessionLog log;
+	REQUIRE(log.start(dir, limits));
+	const char* texts[] = { "one", "two", "three", "four" };
+	for (const char* text : texts)
+	{
+		const uint64_t bytes = log.getStats().bytes;
+		log.record(Kind::CHAT, 1001, "alice", text);
+		REQUIRE(waitForWrite(log, bytes));
+	}
+	log.stop();
+
+	CHECK_EQUAL(5u, log.getStats().files);
+	CHECK_EQUAL((size_t)2, SessionLogReader::listFiles(dir).size());
+
+	const vector<SessionLogReader::Entry> entries = SessionLogReader::tail(dir);
+	REQUIRE(entries.size() == 2);
+	CHECK(entries[0].text == "three");
+	CHECK(entries[1].text == "four");
+}
+
+TEST(SessionLogSearchVisitsNewestFilesFirst)
+{
+	const string dir = makeTempDir();
+
+	// A record no real session could hold: it only shows up if the oldest file is read.
+	writeSession(dir, 1000, frame(5000, 1001, "alice", "stale"));
+	writeSession(dir, 2000, frame(2100, 1001, "alice", "middle"));
+	writeSession(dir, 3000, frame(3100, 1001, "alice", "newest"));
+
+	// Enough matches in the newer files: the oldest is never opened.
+	vector<SessionLogReader::Entry> entries = SessionLogReader::tail(dir, 2);
+	REQUIRE(entries.size() == 2);
+	CHECK(entries[0].text == "middle");
+	CHECK(entries[1].text == "newest");
+
+	entries = SessionLogReader::tail(dir, 3);
+	REQUIRE(entries.size() == 3);
+	CHECK(entries[0].text == "stale");
+
+	// Files that began before the one holding fromMs can't match.
+	SessionLogReader::Query query;
+	query.fromMs = 2500;
+	entries = SessionLogReader::search(dir, query);
+	REQUIRE(entries.size() == 1);
+	CHECK(entries[0].text == "newest");
+
+	// Files that began after toMs are skipped whole.
+	query = SessionLogReader::Query();
+	query.toMs = 2500;
+	entries = SessionLogReader::search(dir, query);
+	REQUIRE(entries.size() == 1);
+	CHECK(entries[0].text == "middle");
+}
+
+TEST(SessionLogQueryParsesSpans)
+{
+	const uint64_t nowMs = (uint64_t)time(nullptr) * 1000ULL;
+	const uint64_t hourMs = 3600000ULL;
+
+	SessionLogReader::Query query = SessionLogReader::parseQuery("#1001 2h to 30m gg wp");
+	CHECK_EQUAL(1001u, query.userID);
+	CHECK(query.fromMs + 2 * hourMs >= nowMs && query.fromMs + 2 * hourMs <= nowMs + 1000);
+	CHECK(query.toMs + hourMs / 2 >= nowMs && query.toMs + hourMs / 2 <= nowMs + 1000);
+	CHECK(query.text == "gg wp");
+
+	// Without a span after it, "to" is just a word.
+	query = SessionLogReader::parseQuery("walk to school");
+	CHECK_EQUAL((uint64_t)0, query.fromMs);
+	CHECK_EQUAL((uint64_t)UINT64_MAX, query.toMs);
+	CHECK(query.text == "walk to school");
+
+	query = SessionLogReader::parseQuery("hello to");
+	CHECK_EQUAL((uint64_t)UINT64_MAX, query.toMs);
+	CHECK(query.text == "hello to");
+}
@@ -0,0 +1,611 @@
+// The parts of matoya the core modules use: JSON, files and directories.
+// AES-GCM and HTTP report failure, as they would with no key or network.
+
+#include "matoya.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <utility>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <unistd.h>
+
+struct MTY_JSON
+{
+	enum class Type { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+	Type type = Type::NUL;
+	bool boolean = false;
+	double number = 0;
+	std::string text;
+	std::vector<MTY_JSON*> items;
+	std::vector<std::string> keys;
+
+	~MTY_JSON()
+	{
+		for (MTY_JSON* item : items) delete item;
+	}
+};
+
+namespace
+{
+	class Parser
+	{
+	public:
+		Parser(const char* input) : _at(input) {}
+
+		MTY_JSON* parse()
+		{
+			MTY_JSON* value = parseValue();
+			skipSpace();
+			if (value != nullptr && *_at != '\0')
+			{
+				delete value;
+				return nullptr;
+			}
+			return value;
+		}
+
+	private:
+		const char* _at;
+
+		void skipSpace()
+		{
+			while (*_at == ' ' || *_at == '\t' || *_at == '\n' || *_at == '\r') _at++;
+		}
+
+		bool consume(const char* word)
+		{
+			const size_t length = strlen(word);
+			if (strncmp(_at, word, length) != 0) return false;
+			_at += length;
+			return true;
+		}
+
+		bool parseString(std::string& out)
+		{
+			if (*_at != '"') return false;
+			_at++;
+			while (*_at != '"')
+			{
+				if (*_at == '\0') return false;
+				if (*_at == '\\')
+				{
+					_at++;
+					switch (*_at)
+					{
+					case 'n': out.push_back('\n'); break;
+					case 't': out.push_back('\t'); break;
+					case 'r': out.push_back('\r'); break;
+					case 'b': out.push_back('\b'); break;
+					case 'f': out.push_back('\f'); break;
+					case 'u':
+					{
+						char hex[5] = { 0 };
+						for (int i = 0; i < 4; i++) { _at++; if (*_at == '\0') return false; hex[i] = *_at; }
+						const unsigned long code = strtoul(hex, nullptr, 16);
+						if (code < 0x80) out.push_back((char)code);
+						else if (code < 0x800) { out.push_back((char)(0xC0 | (code >> 6))); out.push_back((char)(0x80 | (code & 0x3F))); }
+						else { out.push_back((char)(0xE0 | (code >> 12))); out.push_back((char)(0x80 | ((code >> 6) & 0x3F))); out.push_back((char)(0x80 | (code & 0x3F))); }
+						break;
+					}
+					default: out.push_back(*_at); break;
+					}
+					_at++;
+				}
+				else
+				{
+					out.push_back(*_at++);
+				}
+			}
+			_at++;
+			return true;
+		}
+
+		MTY_JSON* parseValue()
+		{
+			skipSpace();
+			MTY_JSON* value = new MTY_JSON();
+
+			if (*_at == '{')
+			{
+				value->type = MTY_JSON::Type::OBJECT;
+				_at++;
+				skipSpace();
+				if (*_at == '}') { _at++; return value; }
+				while (true)
+				{
+					skipSpace();
+					std::string key;
+					if (!parseString(key)) { delete value; return nullptr; }
+					skipSpace();
+					if (*_at++ != ':') { delete value; return nullptr; }
+					MTY_JSON* item = parseValue();
+					if (item == nullptr) { delete value; return nullptr; }
+					value->keys.push_back(key);
+					value->items.push_back(item);
+					skipSpace();
+					if (*_at == ',') { _at++; continue; }
+					if (*_at == '}') { _at++; return value; }
+					delete value;
+					return nullptr;
+				}
+			}
+
+			if (*_at == '[')
+			{
+				value->type = MTY_JSON::Type::ARRAY;
+				_at++;
+				skipSpace();
+				if (*_at == ']') { _at++; return value; }
+				while (true)
+				{
+					MTY_JSON* item = parseValue();
+					if (item == nullptr) { delete value; return nullptr; }
+					value->items.push_back(item);
+					skipSpace();
+					if (*_at == ',') { _at++; continue; }
+					if (*_at == ']') { _at++; return value; }
+					delete value;
+					return nullptr;
+				}
+			}
+
+			if (*_at == '"')
+			{
+				value->type = MTY_JSON::Type::STRING;
+				if (!parseString(value->text)) { delete value; return nullptr; }
+				return value;
+			}
+
+			if (consume("true"))	{ value->type = MTY_JSON::Type::BOOLEAN; value->boolean = true; return value; }
+			if (consume("false"))	{ value->type = MTY_JSON::Type::BOOLEAN; return value; }
+			if (consume("null"))	{ return value; }
+
+			char* end = nullptr;
+			value->number = strtod(_at, &end);
+			if (end == _at) { delete value; return nullptr; }
+			value->type = MTY_JSON::Type::NUMBER;
+			_at = end;
+			return value;
+		}
+	};
+
+	void serialize(const MTY_JSON* json, std::string& out)
+	{
+		if (json == nullptr) { out += "null"; return; }
+
+		switch (json->type)
+		{
+		case MTY_JSON::Type::NUL:		out += "null"; break;
+		case MTY_JSON::Type::BOOLEAN:	out += json->boolean ? "true" : "false"; break;
+		case MTY_JSON::Type::NUMBER:
+		{
+			char number[64];
+			if (json->number == floor(json->number) && fabs(json->number) < 1e15)	snprintf(number, sizeof(number), "%.0f", json->number);
+			else																	snprintf(number, sizeof(number), "%.17g", json->number);
+			out += number;
+			break;
+		}
+		case MTY_JSON::Type::STRING:
+		{
+			out.push_back('"');
+			for (char c : json->text)
+			{
+				if (c == '"' || c == '\\')	{ out.push_back('\\'); out.push_back(c); }
+				else if (c == '\n')			out += "\\n";
+				else if (c == '\t')			out += "\\t";
+				else if (c == '\r')			out += "\\r";
+				else if ((unsigned char)c < 0x20) { char code[8]; snprintf(code, sizeof(code), "\\u%04x", c); out += code; }
+				else						out.push_back(c);
+			}
+			out.push_back('"');
+			break;
+		}
+		case MTY_JSON::Type::ARRAY:
+			out.push_back('[');
+			for (size_t i = 0; i < json->items.size(); i++)
+			{
+				if (i > 0) out.push_back(',');
+				serialize(json->items[i], out);
+			}
+			out.push_back(']');
+			break;
+		case MTY_JSON::Type::OBJECT:
+			out.push_back('{');
+			for (size_t i = 0; i < json->items.size(); i++)
+			{
+				if (i > 0) out.push_back(',');
+				MTY_JSON key;
+				key.type = MTY_JSON::Type::STRING;
+				key.text = json->keys[i];
+				serialize(&key, out);
+				out.push_back(':');
+				serialize(json->items[i], out);
+			}
+			out.push_back('}');
+			break;
+		}
+	}
+
+	MTY_JSON* duplicate(const MTY_JSON* json)
+	{
+		MTY_JSON* copy = new MTY_JSON();
+		copy->type = json->type;
+		copy->boolean = json->boolean;
+		copy->number = json->number;
+		copy->text = json->text;
+		copy->keys = json->keys;
+		for (const MTY_JSON* item : json->items) copy->items.push_back(duplicate(item));
+		return copy;
+	}
+
+	const MTY_JSON* find(const MTY_JSON* json, const char* key)
+	{
+		if (json == nullptr || json->type != MTY_JSON::Type::OBJECT) return nullptr;
+		for (size_t i = 0; i < json->keys.size(); i++)
+		{
+			if (json->keys[i] == key) return json->items[i];
+		}
+		return nullptr;
+	}
+
+	void set(MTY_JSON* json, const char* key, MTY_JSON* value)
+	{
+		if (json == nullptr || json->type != MTY_JSON::Type::OBJECT) { delete value; return; }
+		for (size_t i = 0; i < json->keys.size(); i++)
+		{
+			if (json->keys[i] == key)
+			{
+				delete json->items[i];
+				json->items[i] = value;
+				return;
+			}
+		}
+		json->keys.push_back(key);
+		json->items.push_back(value);
+	}
+
+	MTY_JSON* makeNumber(double number)
+	{
+		MTY_JSON* value = new MTY_JSON();
+		value->type = MTY_JSON::Type::NUMBER;
+		value->number = number;
+		return value;
+	}
+
+	template <typename T>
+	bool getNumber(const MTY_JSON* json, const char* key, T* val)
+	{
+		const MTY_JSON* item = find(json, key);
+		if (item == nullptr || item->type != MTY_JSON::Type::NUMBER) return false;
+		*val = (T)item->number;
+		return true;
+	}
+}
+
+
+// JSON
+
+MTY_JSON* MTY_JSONParse(const char* input)
+{
+	return (input != nullptr) ? Parser(input).parse() : nullptr;
+}
+
+MTY_JSON* MTY_JSONReadFile(const char* path)
+{
+	size_t size = 0;
+	char* text = (char*)MTY_ReadFile(path, &size);
+	if (text == nullptr) return nullptr;
+
+	MTY_JSON* json = MTY_JSONParse(text);
+	free(text);
+	return json;
+}
+
+MTY_JSON* MTY_JSONDuplicate(const MTY_JSON* json)
+{
+	return (json != nullptr) ? duplicate(json) : nullptr;
+}
+
+void MTY_JSONDestroy(MTY_JSON** json)
+{
+	if (json == nullptr) return;
+	delete *json;
+	*json = nullptr;
+}
+
+char* MTY_JSONSerialize(const MTY_JSON* json)
+{
+	std::string out;
+	serialize(json, out);
+	char* result = (char*)malloc(out.size() + 1);
+	memcpy(result, out.c_str(), out.size() + 1);
+	return result;
+}
+
+bool MTY_JSONWriteFile(const char* path, const MTY_JSON* json)
+{
+	std::string out;
+	serialize(json, out);
+	return MTY_WriteFile(path, out.c_str(), out.size());
+}
+
+uint32_t MTY_JSONGetLength(const MTY_JSON* json)
+{
+	return (json != nullptr) ? (uint32_t)json->items.size() : 0;
+}
+
+MTY_JSON* MTY_JSONObjCreate(void)
+{
+	MTY_JSON* json = new MTY_JSON();
+	json->type = MTY_JSON::Type::OBJECT;
+	return json;
+}
+
+MTY_JSON* MTY_JSONArrayCreate(void)
+{
+	MTY_JSON* json = new MTY_JSON();
+	json->type = MTY_JSON::Type::ARRAY;
+	return json;
+}
+
+bool MTY_JSONObjKeyExists(const MTY_JSON* json, const char* key)
+{
+	return find(json, key) != nullptr;
+}
+
+const char* MTY_JSONObjGetKey(const MTY_JSON* json, uint32_t index)
+{
+	return (json != nullptr && index < json->keys.size()) ? json->keys[index].c_str() : nullptr;
+}
+
+void MTY_JSONObjDeleteItem(MTY_JSON* json, const char* key)
+{
+	if (json == nullptr) return;
+	for (size_t i = 0; i < json->keys.size(); i++)
+	{
+		if (json->keys[i] == key)
+		{
+			delete json->items[i];
+			json->items.erase(json->items.begin() + i);
+			json->keys.erase(json->keys.begin() + i);
+			return;
+		}
+	}
+}
+
+const MTY_JSON* MTY_JSONObjGetItem(const MTY_JSON* json, const char* key)
+{
+	return find(json, key);
+}
+
+void MTY_JSONObjSetItem(MTY_JSON* json, const char* key, const MTY_JSON* value)
+{
+	set(json, key, const_cast<MTY_JSON*>(value));
+}
+
+bool MTY_JSONArrayIndexExists(const MTY_JSON* json, uint32_t index)
+{
+	return json != nullptr && index < json->items.size();
+}
+
+void MTY_JSONArrayDeleteItem(MTY_JSON* json, uint32_t index)
+{
+	if (!MTY_JSONArrayIndexExists(json, index)) return;
+	delete json->items[index];
+	json->items.erase(json->items.begin() + index);
+}
+
+const MTY_JSON* MTY_JSONArrayGetItem(const MTY_JSON* json, uint32_t index)
+{
+	return MTY_JSONArrayIndexExists(json, index) ? json->items[index] : nullptr;
+}
+
+void MTY_JSONArraySetItem(MTY_JSON* json, uint32_t index, const MTY_JSON* value)
+{
+	if (json == nullptr) return;
+	while (json->items.size() <= index) json->items.push_back(new MTY_JSON());
+	delete json->items[index];
+	json->items[index] = const_cast<MTY_JSON*>(value);
+}
+
+void MTY_JSONArrayAppendItem(MTY_JSON* json, const MTY_JSON* value)
+{
+	if (json != nullptr) json->items.push_back(const_cast<MTY_JSON*>(value));
+}
+
+bool MTY_JSONObjGetString(const MTY_JSON* json, const char* key, char* val, size_t size)
+{
+	const MTY_JSON* item = find(json, key);
+	if (item == nullptr || item->type != MTY_JSON::Type::STRING || size == 0) return false;
+	snprintf(val, size, "%s", item->text.c_str());
+	return true;
+}
+
+bool MTY_JSONObjGetInt(const MTY_JSON* json, const char* key, int32_t* val)		{ return getNumber(json, key, val); }
+bool MTY_JSONObjGetUInt(const MTY_JSON* json, const char* key, uint32_t* val)	{ return getNumber(json, key, val); }
+bool MTY_JSONObjGetInt8(const MTY_JSON* json, const char* key, int8_t* val)		{ return getNumber(json, key, val); }
+bool MTY_JSONObjGetUInt8(const MTY_JSON* json, const char* key, uint8_t* val)	{ return getNumber(json, key, val); }
+bool MTY_JSONObjGetInt16(const MTY_JSON* json, const char* key, int16_t* val)	{ return getNumber(json, key, val); }
+bool MTY_JSONObjGetUInt16(const MTY_JSON* json, const char* key, uint16_t* val)	{ return getNumber(json, key, val); }
+bool MTY_JSONObjGetFloat(const MTY_JSON* json, const char* key, float* val)		{ return getNumber(json, key, val); }
+
+bool MTY_JSONObjGetBool(const MTY_JSON* json, const char* key, bool* val)
+{
+	const MTY_JSON* item = find(json, key);
+	if (item == nullptr || item->type != MTY_JSON::Type::BOOLEAN) return false;
+	*val = item->boolean;
+	return true;
+}
+
+bool MTY_JSONObjIsValNull(const MTY_JSON* json, const char* key)
+{
+	const MTY_JSON* item = find(json, key);
+	return item != nullptr && item->type == MTY_JSON::Type::NUL;
+}
+
+void MTY_JSONObjSetString(MTY_JSON* json, const char* key, const char* val)
+{
+	MTY_JSON* value = new MTY_JSON();
+	value->type = MTY_JSON::Type::STRING;
+	value->text = (val != nullptr) ? val : "";
+	set(json, key, value);
+}
+
+void MTY_JSONObjSetInt(MTY_JSON* json, const char* key, int32_t val)		{ set(json, key, makeNumber(val)); }
+void MTY_JSONObjSetUInt(MTY_JSON* json, const char* key, uint32_t val)		{ set(json, key, makeNumber(val)); }
+void MTY_JSONObjSetFloat(MTY_JSON* json, const char* key, float val)		{ set(json, key, makeNumber(val)); }
+
+void MTY_JSONObjSetBool(MTY_JSON* json, const char* key, bool val)
+{
+	MTY_JSON* value = new MTY_JSON();
+	value->type = MTY_JSON::Type::BOOLEAN;
+	value->boolean = val;
+	set(json, key, value);
+}
+
+void MTY_JSONObjSetNull(MTY_JSON* json, const char* key)
+{
+	set(json, key, new MTY_JSON());
+}
+
+
+// Files
+
+void* MTY_ReadFile(const char* path, size_t* size)
+{
+	FILE* file = fopen(path, "rb");
+	if (file == nullptr) return nullptr;
+
+	fseek(file, 0, SEEK_END);
+	const long length = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	char* buffer = (char*)malloc((size_t)length + 1);
+	const size_t read = fread(buffer, 1, (size_t)length, file);
+	fclose(file);
+
+	buffer[read] = '\0';
+	if (size != nullptr) *size = read;
+	return buffer;
+}
+
+bool MTY_WriteFile(const char* path, const void* buf, size_t size)
+{
+	FILE* file = fopen(path, "wb");
+	if (file == nullptr) return false;
+
+	const bool isOk = fwrite(buf, 1, size, file) == size;
+	return (fclose(file) == 0) && isOk;
+}
+
+bool MTY_DeleteFile(const char* path)
+{
+	return remove(path) == 0;
+}
+
+bool MTY_FileExists(const char* path)
+{
+	struct stat info;
+	return stat(path, &info) == 0 && S_ISREG(info.st_mode);
+}
+
+bool MTY_Mkdir(const char* path)
+{
+	std::string partial;
+	for (const char* at = path; *at != '\0'; at++)
+	{
+		partial.push_back(*at);
+		if (*at == '/' && partial.size() > 1) mkdir(partial.c_str(), 0755);
+	}
+	mkdir(partial.c_str(), 0755);
+
+	struct stat info;
+	return stat(path, &info) == 0 && S_ISDIR(info.st_mode);
+}
+
+MTY_FileList* MTY_GetFileList(const char* path, const char* filter)
+{
+	DIR* directory = opendir(path);
+	if (directory == nullptr) return nullptr;
+
+	std::vector<MTY_FileDesc> files;
+	while (struct dirent* entry = readdir(directory))
+	{
+		if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
+
+		struct stat info;
+		const std::string full = std::string(path) + "/" + entry->d_name;
+		const bool isDir = stat(full.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+		if (!isDir && filter != nullptr && strstr(entry->d_name, filter) == nullptr) continue;
+
+		MTY_FileDesc desc;
+		desc.path = strdup(path);
+		desc.name = strdup(entry->d_name);
+		desc.dir = isDir;
+		files.push_back(desc);
+	}
+	closedir(directory);
+
+	MTY_FileList* list = (MTY_FileList*)calloc(1, sizeof(MTY_FileList));
+	list->len = (uint32_t)files.size();
+	list->files = (MTY_FileDesc*)calloc(files.size() + 1, sizeof(MTY_FileDesc));
+	for (size_t i = 0; i < files.size(); i++) list->files[i] = files[i];
+	return list;
+}
+
+void MTY_FreeFileList(MTY_FileList** fileList)
+{
+	if (fileList == nullptr || *fileList == nullptr) return;
+
+	for (uint32_t i = 0; i < (*fileList)->len; i++)
+	{
+		free((*fileList)->files[i].path);
+		free((*fileList)->files[i].name);
+	}
+	free((*fileList)->files);
+	free(*fileList);
+	*fileList = nullptr;
+}
+
+
+// Memory, crypto and network
+
+void MTY_Free(void* mem)
+{
+	free(mem);
+}
+
+MTY_AESGCM* MTY_AESGCMCreate(const void*)
+{
+	return nullptr;
+}
+
+void MTY_AESGCMDestroy(MTY_AESGCM** aesgcm)
+{
+	if (aesgcm != nullptr) *aesgcm = nullptr;
+}
+
+bool MTY_AESGCMEncrypt(MTY_AESGCM*, const void*, const void*, size_t, void*, void*)
+{
+	return false;
+}
+
+bool MTY_AESGCMDecrypt(MTY_AESGCM*, const void*, const void*, size_t, const void*, void*)
+{
+	return false;
+}
+
+bool MTY_HttpRequest(const char*, uint16_t, bool, const char*, const char*, const char*, const void*, size_t,
+	uint32_t, void** response, size_t* responseSize, uint16_t* status)
+{
+	if (response != nullptr) *response = nullptr;
+	if (responseSize != nullptr) *responseSize = 0;
+	if (status != nullptr) *status = 0;
+	return false;
+}
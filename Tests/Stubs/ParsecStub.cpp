@@ -0,0 +1,185 @@
+#include "ParsecStub.h"
+
+#include <cstring>
+#include <mutex>
+#include <condition_variable>
+
+struct Parsec
+{
+	mutex lock;
+	bool isHosting = false;
+	vector<ParsecGuest> guests;
+	vector<ParsecStub::Message> sent;
+	vector<uint32_t> kicked;
+	vector<ParsecStub::Rumble> rumbles;
+	condition_variable released;
+	bool isHoldingSends = false;
+	size_t heldSends = 0;
+};
+
+namespace
+{
+	void destroy(Parsec* ps)
+	{
+		delete ps;
+	}
+
+	void freeBuffer(void* ptr)
+	{
+		free(ptr);
+	}
+
+	void* getBuffer(Parsec*, uint32_t)
+	{
+		return nullptr;
+	}
+
+	void setLogCallback(ParsecLogCallback, const void*)
+	{
+	}
+
+	uint32_t version()
+	{
+		return PARSEC_VER;
+	}
+
+	ParsecStatus hostStart(Parsec* ps, ParsecHostMode, const ParsecHostConfig*, const char*)
+	{
+		lock_guard<mutex> lock(ps->lock);
+		ps->isHosting = true;
+		return PARSEC_OK;
+	}
+
+	void hostStop(Parsec* ps)
+	{
+		lock_guard<mutex> lock(ps->lock);
+		ps->isHosting = false;
+	}
+
+	ParsecStatus hostSetConfig(Parsec*, const ParsecHostConfig*, const char*)
+	{
+		return PARSEC_OK;
+	}
+
+	uint32_t hostGetGuests(Parsec* ps, uint32_t state, ParsecGuest** guests)
+	{
+		lock_guard<mutex> lock(ps->lock);
+
+		const uint32_t count = (uint32_t)ps->guests.size();
+		if (guests != nullptr)
+		{
+			*guests = (ParsecGuest*)malloc(sizeof(ParsecGuest) * (count > 0 ? count : 1));
+			if (count > 0) memcpy(*guests, ps->guests.data(), sizeof(ParsecGuest) * count);
+		}
+		return count;
+	}
+
+	ParsecStatus hostKickGuest(Parsec* ps, uint32_t guestID)
+	{
+		lock_guard<mutex> lock(ps->lock);
+		ps->kicked.push_back(guestID);
+		return PARSEC_OK;
+	}
+
+	ParsecStatus hostSendUserData(Parsec* ps, uint32_t guestID, uint32_t id, const char* text)
+	{
+		unique_lock<mutex> lock(ps->lock);
+		ps->heldSends++;
+		ps->released.wait(lock, [ps]() { return !ps->isHoldingSends; });
+		ps->heldSends--;
+		ps->sent.push_back(ParsecStub::Message{ guestID, id, (text != nullptr) ? text : "" });
+		return PARSEC_OK;
+	}
+
+	bool hostPollEvents(Parsec*, uint32_t, ParsecHostEvent*)
+	{
+		return false;
+	}
+
+	bool hostPollInput(Parsec*, uint32_t, ParsecGuest*, ParsecMessage*)
+	{
+		return false;
+	}
+
+	ParsecStatus hostSubmitAudio(Parsec*, ParsecPCMFormat, uint32_t, const void*, uint32_t)
+	{
+		return PARSEC_OK;
+	}
+
+	ParsecStatus hostSubmitRumble(Parsec* ps, uint32_t guestID, uint32_t gamepadID, uint8_t motorBig, uint8_t motorSmall)
+	{
+		lock_guard<mutex> lock(ps->lock);
+		ps->rumbles.push_back(ParsecStub::Rumble{ guestID, gamepadID, motorBig, motorSmall });
+		return PARSEC_OK;
+	}
+}
+
+ParsecDSO* ParsecStub::create()
+{
+	ParsecDSO* dso = (ParsecDSO*)calloc(1, sizeof(ParsecDSO));
+	dso->ps = new Parsec();
+
+	dso->api.ParsecDestroy = destroy;
+	dso->api.ParsecFree = freeBuffer;
+	dso->api.ParsecGetBuffer = getBuffer;
+	dso->api.ParsecSetLogCallback = setLogCallback;
+	dso->api.ParsecVersion = version;
+	dso->api.ParsecHostStart = hostStart;
+	dso->api.ParsecHostStop = hostStop;
+	dso->api.ParsecHostSetConfig = hostSetConfig;
+	dso->api.ParsecHostGetGuests = hostGetGuests;
+	dso->api.ParsecHostKickGuest = hostKickGuest;
+	dso->api.ParsecHostSendUserData = hostSendUserData;
+	dso->api.ParsecHostPollEvents = hostPollEvents;
+	dso->api.ParsecHostPollInput = hostPollInput;
+	dso->api.ParsecHostSubmitAudio = hostSubmitAudio;
+	dso->api.ParsecHostSubmitRumble = hostSubmitRumble;
+	return dso;
+}
+
+void ParsecStub::setGuests(ParsecDSO* dso, const vector<ParsecGuest>& guests)
+{
+	lock_guard<mutex> lock(dso->ps->lock);
+	dso->ps->guests = guests;
+}
+
+ParsecGuest ParsecStub::makeGuest(uint32_t id, uint32_t userID, const char* name)
+{
+	ParsecGuest guest;
+	memset(&guest, 0, sizeof(guest));
+	guest.state = GUEST_CONNECTED;
+	guest.id = id;
+	guest.userID = userID;
+	strncpy(guest.name, name, GUEST_NAME_LEN - 1);
+	return guest;
+}
+
+void ParsecStub::holdSends(ParsecDSO* dso, bool isHeld)
+{
+	{
+		lock_guard<mutex> lock(dso->ps->lock);
+		dso->ps->isHoldingSends = isHeld;
+	}
+	dso->ps->released.notify_all();
+}
+
+size_t ParsecStub::heldSends(ParsecDSO* dso)
+{
+	lock_guard<mutex> lock(dso->ps->lock);
+	return dso->ps->heldSends;
+}
+
+const vector<ParsecStub::Message>& ParsecStub::sent(ParsecDSO* dso)
+{
+	return dso->ps->sent;
+}
+
+const vector<uint32_t>& ParsecStub::kicked(ParsecDSO* dso)
+{
+	return dso->ps->kicked;
+}
+
+const vector<ParsecStub::Rumble>& ParsecStub::rumbles(ParsecDSO* dso)
+{
+	return dso->ps->rumbles;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "parsec-dso.h"
+
+using namespace std;
+
+/**
+ * An in-process Parsec host. create() hands back a ParsecDSO whose API table
+ * points at fakes instead of a loaded parsec.dll: they keep every message,
+ * kick and rumble the host sends, and report the guests a test sets up.
+ * Release it with the SDK's own ParsecDestroy().
+ */
+namespace ParsecStub
+{
+	class Message
+	{
+	public:
+		uint32_t guestID;
+		uint32_t id;
+		string text;
+	};
+
+	class Rumble
+	{
+	public:
+		uint32_t guestID;
+		uint32_t gamepadID;
+		uint8_t motorBig;
+		uint8_t motorSmall;
+	};
+
+	ParsecDSO* create();
+
+	/** Sets who ParsecHostGetGuests reports as connected. */
+	void setGuests(ParsecDSO* dso, const vector<ParsecGuest>& guests);
+
+	ParsecGuest makeGuest(uint32_t id, uint32_t userID, const char* name);
+
+	/** While held, ParsecHostSendUserData waits for release, so a test can queue up behind a send. */
+	void holdSends(ParsecDSO* dso, bool isHeld);
+	/** How many sends are waiting on holdSends right now. */
+	size_t heldSends(ParsecDSO* dso);
+
+	const vector<Message>& sent(ParsecDSO* dso);
+	const vector<uint32_t>& kicked(ParsecDSO* dso);
+	const vector<Rumble>& rumbles(ParsecDSO* dso);
+}
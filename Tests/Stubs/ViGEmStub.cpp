@@ -0,0 +1,252 @@
+#include "ViGEmStub.h"
+
+#include <mutex>
+#include <unordered_map>
+
+struct _VIGEM_CLIENT_T
+{
+	bool isConnected = false;
+};
+
+struct _VIGEM_TARGET_T
+{
+	VIGEM_TARGET_TYPE type = Xbox360Wired;
+	USHORT vid = 0;
+	USHORT pid = 0;
+	ULONG index = 0;
+	bool isAttached = false;
+	PVIGEM_CLIENT client = nullptr;
+	PFN_VIGEM_X360_NOTIFICATION x360Notification = nullptr;
+	PFN_VIGEM_DS4_NOTIFICATION ds4Notification = nullptr;
+	LPVOID userData = nullptr;
+	vector<XUSB_REPORT> x360Reports;
+	vector<DS4_REPORT> ds4Reports;
+};
+
+namespace
+{
+	mutex _mutex;
+	bool _isBusMissing = false;
+	ULONG _nextIndex = 1;
+	unordered_map<ULONG, PVIGEM_TARGET> _attached;
+}
+
+
+// ==================================================
+//   Inspection
+// ==================================================
+
+void ViGEmStub::reset()
+{
+	lock_guard<mutex> lock(_mutex);
+	_isBusMissing = false;
+	_nextIndex = 1;
+	_attached.clear();
+}
+
+void ViGEmStub::setBusMissing(bool isMissing)
+{
+	lock_guard<mutex> lock(_mutex);
+	_isBusMissing = isMissing;
+}
+
+size_t ViGEmStub::attachedCount()
+{
+	lock_guard<mutex> lock(_mutex);
+	return _attached.size();
+}
+
+PVIGEM_TARGET ViGEmStub::findTarget(ULONG busIndex)
+{
+	lock_guard<mutex> lock(_mutex);
+	unordered_map<ULONG, PVIGEM_TARGET>::iterator it = _attached.find(busIndex);
+	return (it != _attached.end()) ? it->second : nullptr;
+}
+
+const vector<XUSB_REPORT>& ViGEmStub::x360Reports(PVIGEM_TARGET target)
+{
+	return target->x360Reports;
+}
+
+const vector<DS4_REPORT>& ViGEmStub::ds4Reports(PVIGEM_TARGET target)
+{
+	return target->ds4Reports;
+}
+
+void ViGEmStub::rumble(PVIGEM_TARGET target, UCHAR largeMotor, UCHAR smallMotor)
+{
+	if (target->x360Notification != nullptr)
+	{
+		target->x360Notification(target->client, target, largeMotor, smallMotor, 0, target->userData);
+	}
+	else if (target->ds4Notification != nullptr)
+	{
+		DS4_LIGHTBAR_COLOR color = { 0, 0, 0 };
+		target->ds4Notification(target->client, target, largeMotor, smallMotor, color, target->userData);
+	}
+}
+
+
+// ==================================================
+//   Client API
+// ==================================================
+
+PVIGEM_CLIENT vigem_alloc(void)
+{
+	return new _VIGEM_CLIENT_T();
+}
+
+void vigem_free(PVIGEM_CLIENT vigem)
+{
+	delete vigem;
+}
+
+VIGEM_ERROR vigem_connect(PVIGEM_CLIENT vigem)
+{
+	lock_guard<mutex> lock(_mutex);
+	if (_isBusMissing) return VIGEM_ERROR_BUS_NOT_FOUND;
+	if (vigem->isConnected) return VIGEM_ERROR_BUS_ALREADY_CONNECTED;
+	vigem->isConnected = true;
+	return VIGEM_ERROR_NONE;
+}
+
+void vigem_disconnect(PVIGEM_CLIENT vigem)
+{
+	vigem->isConnected = false;
+}
+
+PVIGEM_TARGET vigem_target_x360_alloc(void)
+{
+	PVIGEM_TARGET target = new _VIGEM_TARGET_T();
+	target->type = Xbox360Wired;
+	return target;
+}
+
+PVIGEM_TARGET vigem_target_ds4_alloc(void)
+{
+	PVIGEM_TARGET target = new _VIGEM_TARGET_T();
+	target->type = DualShock4Wired;
+	return target;
+}
+
+void vigem_target_free(PVIGEM_TARGET target)
+{
+	delete target;
+}
+
+VIGEM_ERROR vigem_target_add(PVIGEM_CLIENT vigem, PVIGEM_TARGET target)
+{
+	lock_guard<mutex> lock(_mutex);
+	if (vigem == nullptr || !vigem->isConnected) return VIGEM_ERROR_BUS_NOT_FOUND;
+	if (target->isAttached) return VIGEM_ERROR_ALREADY_CONNECTED;
+
+	target->client = vigem;
+	target->index = _nextIndex++;
+	target->isAttached = true;
+	_attached[target->index] = target;
+	return VIGEM_ERROR_NONE;
+}
+
+VIGEM_ERROR vigem_target_add_async(PVIGEM_CLIENT vigem, PVIGEM_TARGET target, PFN_VIGEM_TARGET_ADD_RESULT result)
+{
+	const VIGEM_ERROR error = vigem_target_add(vigem, target);
+	if (result != nullptr) result(vigem, target, error);
+	return error;
+}
+
+VIGEM_ERROR vigem_target_remove(PVIGEM_CLIENT vigem, PVIGEM_TARGET target)
+{
+	lock_guard<mutex> lock(_mutex);
+	if (!target->isAttached) return VIGEM_ERROR_TARGET_NOT_PLUGGED_IN;
+
+	target->isAttached = false;
+	_attached.erase(target->index);
+	return VIGEM_ERROR_NONE;
+}
+
+VIGEM_ERROR vigem_target_x360_register_notification(PVIGEM_CLIENT vigem, PVIGEM_TARGET target, PFN_VIGEM_X360_NOTIFICATION notification, LPVOID userData)
+{
+	if (target->x360Notification != nullptr) return VIGEM_ERROR_CALLBACK_ALREADY_REGISTERED;
+	target->x360Notification = notification;
+	target->userData = userData;
+	return VIGEM_ERROR_NONE;
+}
+
+VIGEM_ERROR vigem_target_ds4_register_notification(PVIGEM_CLIENT vigem, PVIGEM_TARGET target, PFN_VIGEM_DS4_NOTIFICATION notification, LPVOID userData)
+{
+	if (target->ds4Notification != nullptr) return VIGEM_ERROR_CALLBACK_ALREADY_REGISTERED;
+	target->ds4Notification = notification;
+	target->userData = userData;
+	return VIGEM_ERROR_NONE;
+}
+
+void vigem_target_x360_unregister_notification(PVIGEM_TARGET target)
+{
+	target->x360Notification = nullptr;
+}
+
+void vigem_target_ds4_unregister_notification(PVIGEM_TARGET target)
+{
+	target->ds4Notification = nullptr;
+}
+
+void vigem_target_set_vid(PVIGEM_TARGET target, USHORT vid)
+{
+	target->vid = vid;
+}
+
+void vigem_target_set_pid(PVIGEM_TARGET target, USHORT pid)
+{
+	target->pid = pid;
+}
+
+USHORT vigem_target_get_vid(PVIGEM_TARGET target)
+{
+	return target->vid;
+}
+
+USHORT vigem_target_get_pid(PVIGEM_TARGET target)
+{
+	return target->pid;
+}
+
+VIGEM_ERROR vigem_target_x360_update(PVIGEM_CLIENT vigem, PVIGEM_TARGET target, XUSB_REPORT report)
+{
+	if (!target->isAttached) return VIGEM_ERROR_TARGET_NOT_PLUGGED_IN;
+	target->x360Reports.push_back(report);
+	return VIGEM_ERROR_NONE;
+}
+
+VIGEM_ERROR vigem_target_ds4_update(PVIGEM_CLIENT vigem, PVIGEM_TARGET target, DS4_REPORT report)
+{
+	if (!target->isAttached) return VIGEM_ERROR_TARGET_NOT_PLUGGED_IN;
+	target->ds4Reports.push_back(report);
+	return VIGEM_ERROR_NONE;
+}
+
+VIGEM_ERROR vigem_target_ds4_update_ex(PVIGEM_CLIENT vigem, PVIGEM_TARGET target, DS4_REPORT_EX report)
+{
+	return target->isAttached ? VIGEM_ERROR_NONE : VIGEM_ERROR_TARGET_NOT_PLUGGED_IN;
+}
+
+ULONG vigem_target_get_index(PVIGEM_TARGET target)
+{
+	return target->index;
+}
+
+VIGEM_TARGET_TYPE vigem_target_get_type(PVIGEM_TARGET target)
+{
+	return target->type;
+}
+
+BOOL vigem_target_is_attached(PVIGEM_TARGET target)
+{
+	return target->isAttached ? TRUE : FALSE;
+}
+
+VIGEM_ERROR vigem_target_x360_get_user_index(PVIGEM_CLIENT vigem, PVIGEM_TARGET target, PULONG index)
+{
+	if (!target->isAttached) return VIGEM_ERROR_TARGET_NOT_PLUGGED_IN;
+	*index = (target->index - 1) % 4;
+	return VIGEM_ERROR_NONE;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+#include "ViGEm/Client.h"
+
+using namespace std;
+
+/**
+ * A stand-in ViGEm bus. Targets live in memory, every report they're sent is
+ * kept in order, and tests can fire the rumble notification a real pad would.
+ */
+namespace ViGEmStub
+{
+	/** Forgets every target and report, and lets connects succeed again. */
+	void reset();
+
+	/** Makes vigem_connect fail, as it does with the bus driver missing. */
+	void setBusMissing(bool isMissing);
+
+	size_t attachedCount();
+
+	/** The plugged-in target with this bus index (Gamepad::getBusIndex), or null. */
+	PVIGEM_TARGET findTarget(ULONG busIndex);
+
+	const vector<XUSB_REPORT>& x360Reports(PVIGEM_TARGET target);
+	const vector<DS4_REPORT>& ds4Reports(PVIGEM_TARGET target);
+
+	/** Fires the target's registered notification, like a game asking for rumble. */
+	void rumble(PVIGEM_TARGET target, UCHAR largeMotor, UCHAR smallMotor);
+}
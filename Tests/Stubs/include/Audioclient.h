@@ -0,0 +1,6 @@
+#pragma once
+
+#include <mmdeviceapi.h>
+
+struct IAudioClient;
+struct IAudioCaptureClient;
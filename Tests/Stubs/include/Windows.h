@@ -0,0 +1,118 @@
+#pragma once
+
+// Just enough of the Win32 API for the core modules to build elsewhere.
+// Functions that would touch the OS do nothing and report success.
+
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cstdarg>
+#include <cwchar>
+#include <cstddef>
+#include <strings.h>
+#include <thread>
+#include <chrono>
+
+typedef unsigned long ULONG;
+typedef ULONG* PULONG;
+typedef unsigned short USHORT;
+typedef unsigned char UCHAR;
+typedef unsigned char BYTE;
+typedef short SHORT;
+typedef unsigned short WORD;
+typedef unsigned long DWORD;
+typedef int BOOL;
+typedef long LONG;
+typedef long HRESULT;
+typedef unsigned int UINT;
+typedef char CHAR;
+typedef wchar_t WCHAR;
+typedef wchar_t TCHAR;
+typedef void* LPVOID;
+typedef void* PVOID;
+typedef void* HANDLE;
+typedef void* HMODULE;
+typedef void* HWND;
+typedef void* HINSTANCE;
+typedef const char* LPCSTR;
+typedef char* LPSTR;
+typedef const wchar_t* LPCWSTR;
+typedef uint64_t ULONGLONG;
+typedef int64_t LONGLONG;
+typedef uintptr_t ULONG_PTR;
+typedef uintptr_t WPARAM;
+typedef intptr_t LPARAM;
+typedef intptr_t LRESULT;
+typedef union { struct { DWORD LowPart; LONG HighPart; }; LONGLONG QuadPart; } LARGE_INTEGER;
+
+#define VOID void
+#define CALLBACK
+#define WINAPI
+#define FORCEINLINE inline
+#define __declspec(x)
+#define _In_
+#define _Out_
+#define _In_opt_
+#define _Inout_
+#define _Function_class_(x)
+#define _IRQL_requires_max_(x)
+#define _IRQL_requires_same_
+
+#define TRUE 1
+#define FALSE 0
+#define MAX_PATH 260
+#define INFINITE 0xFFFFFFFF
+#define TEXT(x) L##x
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#define ZeroMemory(p, n) memset((p), 0, (n))
+#define RtlZeroMemory(p, n) memset((p), 0, (n))
+
+inline void Sleep(DWORD ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+inline BOOL CloseHandle(HANDLE) { return TRUE; }
+inline DWORD GetLastError() { return 0; }
+inline int _stricmp(const char* a, const char* b) { return strcasecmp(a, b); }
+
+// Safe CRT
+#define strcpy_s(dst, ...) strcpy_s_stub(dst, __VA_ARGS__)
+template <size_t N> inline int strcpy_s_stub(char (&dst)[N], const char* src) { strncpy(dst, src, N - 1); dst[N - 1] = '\0'; return 0; }
+inline int strcpy_s_stub(char* dst, size_t size, const char* src) { strncpy(dst, src, size - 1); dst[size - 1] = '\0'; return 0; }
+inline int sprintf_s(char* dst, size_t size, const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	const int result = vsnprintf(dst, size, format, args);
+	va_end(args);
+	return result;
+}
+
+// Mouse injection
+#define INPUT_MOUSE 0
+#define MOUSEEVENTF_MOVE 0x0001
+#define MOUSEEVENTF_LEFTDOWN 0x0002
+#define MOUSEEVENTF_LEFTUP 0x0004
+#define MOUSEEVENTF_RIGHTDOWN 0x0008
+#define MOUSEEVENTF_RIGHTUP 0x0010
+#define MOUSEEVENTF_MIDDLEDOWN 0x0020
+#define MOUSEEVENTF_MIDDLEUP 0x0040
+#define MOUSEEVENTF_XDOWN 0x0080
+#define MOUSEEVENTF_XUP 0x0100
+#define MOUSEEVENTF_WHEEL 0x0800
+#define MOUSEEVENTF_HWHEEL 0x1000
+#define MOUSEEVENTF_VIRTUALDESK 0x4000
+#define MOUSEEVENTF_ABSOLUTE 0x8000
+#define XBUTTON1 1
+#define XBUTTON2 2
+#define WHEEL_DELTA 120
+#define SM_XVIRTUALSCREEN 76
+#define SM_YVIRTUALSCREEN 77
+#define SM_CXVIRTUALSCREEN 78
+#define SM_CYVIRTUALSCREEN 79
+
+typedef struct { LONG dx, dy; DWORD mouseData, dwFlags, time; ULONG_PTR dwExtraInfo; } MOUSEINPUT;
+typedef struct { DWORD type; union { MOUSEINPUT mi; }; } INPUT;
+
+inline UINT SendInput(UINT count, INPUT*, int) { return count; }
+inline int GetSystemMetrics(int) { return 0; }
+
+// Like the real header, bring in the multimedia API too.
+#include <mmsystem.h>
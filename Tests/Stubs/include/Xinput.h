@@ -0,0 +1,11 @@
+#pragma once
+
+#include <Windows.h>
+
+#define XUSER_MAX_COUNT 4
+#define ERROR_DEVICE_NOT_CONNECTED 1167L
+
+typedef struct { WORD wButtons; BYTE bLeftTrigger; BYTE bRightTrigger; SHORT sThumbLX, sThumbLY, sThumbRX, sThumbRY; } XINPUT_GAMEPAD;
+typedef struct { DWORD dwPacketNumber; XINPUT_GAMEPAD Gamepad; } XINPUT_STATE;
+
+inline DWORD XInputGetState(DWORD, XINPUT_STATE*) { return ERROR_DEVICE_NOT_CONNECTED; }
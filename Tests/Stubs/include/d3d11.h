@@ -0,0 +1,11 @@
+#pragma once
+
+#include <Windows.h>
+
+typedef struct { UINT Width, Height; } D3D11_TEXTURE2D_DESC;
+
+struct ID3D11Device;
+struct ID3D11DeviceContext;
+struct ID3D11Texture2D;
+struct ID3D11RenderTargetView;
+struct ID3D11ShaderResourceView;
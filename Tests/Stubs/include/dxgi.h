@@ -0,0 +1,6 @@
+#pragma once
+
+#include <Windows.h>
+
+struct IDXGISwapChain;
+struct IDXGIAdapter;
@@ -0,0 +1,5 @@
+#pragma once
+
+#include <dxgi.h>
+
+struct IDXGIOutputDuplication;
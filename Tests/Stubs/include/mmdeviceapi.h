@@ -0,0 +1,13 @@
+#pragma once
+
+#include <Windows.h>
+
+typedef struct { unsigned long data1; unsigned short data2, data3; unsigned char data4[8]; } GUID;
+typedef GUID CLSID;
+typedef GUID IID;
+#define __uuidof(x) GUID()
+
+struct IMMDeviceEnumerator;
+struct IMMDevice;
+struct IMMDeviceCollection;
+struct MMDeviceEnumerator;
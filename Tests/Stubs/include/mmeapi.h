@@ -0,0 +1,6 @@
+#pragma once
+
+#include <Windows.h>
+
+typedef struct { WCHAR szPname[32]; } WAVEINCAPS;
+typedef struct { WCHAR szPname[32]; } WAVEOUTCAPS;
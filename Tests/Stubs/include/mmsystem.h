@@ -0,0 +1,10 @@
+#pragma once
+
+#include <Windows.h>
+#include <mmeapi.h>
+
+#define SND_FILENAME 0x00020000L
+#define SND_NODEFAULT 0x0002
+#define SND_ASYNC 0x0001
+
+inline BOOL PlaySound(LPCWSTR, HMODULE, DWORD) { return TRUE; }
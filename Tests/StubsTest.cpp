@@ -0,0 +1,69 @@
+#include "Test.h"
+#include "ParsecStub.h"
+#include "ViGEmStub.h"
+#include "matoya.h"
+
+TEST(ParsecStubRecordsHostCalls)
+{
+	ParsecDSO* parsec = ParsecStub::create();
+	ParsecStub::setGuests(parsec, { ParsecStub::makeGuest(7, 1001, "alice") });
+
+	ParsecGuest* guests = nullptr;
+	CHECK_EQUAL(1u, ParsecHostGetGuests(parsec, GUEST_CONNECTED, &guests));
+	CHECK_EQUAL(1001u, guests[0].userID);
+	ParsecFree(parsec, guests);
+
+	ParsecHostSendUserData(parsec, 7, 0, "hello");
+	ParsecHostKickGuest(parsec, 7);
+	ParsecHostSubmitRumble(parsec, 7, 2, 255, 0);
+
+	REQUIRE(ParsecStub::sent(parsec).size() == 1);
+	CHECK(ParsecStub::sent(parsec)[0].text == "hello");
+	CHECK_EQUAL(7u, ParsecStub::kicked(parsec)[0]);
+	CHECK_EQUAL(255, ParsecStub::rumbles(parsec)[0].motorBig);
+
+	ParsecDestroy(parsec);
+}
+
+TEST(ViGEmStubKeepsReportsPerTarget)
+{
+	ViGEmStub::reset();
+	PVIGEM_CLIENT client = vigem_alloc();
+	REQUIRE(VIGEM_SUCCESS(vigem_connect(client)));
+
+	PVIGEM_TARGET pad = vigem_target_x360_alloc();
+	REQUIRE(VIGEM_SUCCESS(vigem_target_add(client, pad)));
+	CHECK_EQUAL(1u, ViGEmStub::attachedCount());
+
+	XUSB_REPORT report;
+	XUSB_REPORT_INIT(&report);
+	report.wButtons = XUSB_GAMEPAD_A;
+	vigem_target_x360_update(client, pad, report);
+	CHECK_EQUAL(1u, ViGEmStub::x360Reports(pad).size());
+	CHECK_EQUAL(XUSB_GAMEPAD_A, ViGEmStub::x360Reports(pad)[0].wButtons);
+
+	vigem_target_remove(client, pad);
+	vigem_target_free(pad);
+	vigem_disconnect(client);
+	vigem_free(client);
+	CHECK_EQUAL(0u, ViGEmStub::attachedCount());
+}
+
+TEST(MatoyaStubRoundTripsJson)
+{
+	MTY_JSON* json = MTY_JSONParse("{\"name\":\"a \\\"b\\\"\",\"tier\":2,\"list\":[1,true,null]}");
+	REQUIRE(json != nullptr);
+
+	char name[32] = "";
+	uint32_t tier = 0;
+	CHECK(MTY_JSONObjGetString(json, "name", name, sizeof(name)));
+	CHECK(string(name) == "a \"b\"");
+	CHECK(MTY_JSONObjGetUInt(json, "tier", &tier));
+	CHECK_EQUAL(2u, tier);
+	CHECK_EQUAL(3u, MTY_JSONGetLength(MTY_JSONObjGetItem(json, "list")));
+
+	char* text = MTY_JSONSerialize(json);
+	CHECK(string(text) == "{\"name\":\"a \\\"b\\\"\",\"tier\":2,\"list\":[1,true,null]}");
+	MTY_Free(text);
+	MTY_JSONDestroy(&json);
+}
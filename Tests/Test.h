@@ -0,0 +1,49 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * A minimal test registry. TEST(Name) defines a case that TestMain runs;
+ * CHECK and CHECK_EQUAL record a failure and carry on, REQUIRE stops the case.
+ */
+namespace Test
+{
+	class Case
+	{
+	public:
+		const char* name;
+		void (*run)();
+	};
+
+	vector<Case>& cases();
+	int& failures();
+
+	class Registrar
+	{
+	public:
+		Registrar(const char* name, void (*run)()) { cases().push_back(Case{ name, run }); }
+	};
+
+	inline bool report(bool isOk, const char* expression, const char* file, int line)
+	{
+		if (!isOk)
+		{
+			failures()++;
+			cout << "  FAILED " << file << ":" << line << ": " << expression << endl;
+		}
+		return isOk;
+	}
+}
+
+#define TEST(name) \
+	static void test_##name(); \
+	static Test::Registrar registrar_##name(#name, test_##name); \
+	static void test_##name()
+
+#define CHECK(expression) Test::report((expression), #expression, __FILE__, __LINE__)
+#define CHECK_EQUAL(expected, actual) Test::report((expected) == (actual), #expected " == " #actual, __FILE__, __LINE__)
+#define REQUIRE(expression) if (!CHECK(expression)) return
@@ -0,0 +1,35 @@
+#include "Test.h"
+
+#include <cstring>
+
+vector<Test::Case>& Test::cases()
+{
+	static vector<Case> all;
+	return all;
+}
+
+int& Test::failures()
+{
+	static int count = 0;
+	return count;
+}
+
+/** Runs every case, or only those whose name contains the first argument. */
+int main(int argc, char** argv)
+{
+	const char* filter = (argc > 1) ? argv[1] : nullptr;
+
+	int ran = 0;
+	for (const Test::Case& test : Test::cases())
+	{
+		if (filter != nullptr && strstr(test.name, filter) == nullptr) continue;
+
+		const int before = Test::failures();
+		test.run();
+		cout << ((Test::failures() == before) ? "[ OK ] " : "[FAIL] ") << test.name << endl;
+		ran++;
+	}
+
+	cout << ran << " tests, " << Test::failures() << " failures" << endl;
+	return (Test::failures() == 0) ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+#include "Bench.h"
+#include "InputTransform.h"
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+namespace
+{
+	/** Deadzone and curve worked out per message in floating point, as apply() would without its tables. */
+	int16_t shapeByMath(int16_t value, const InputTransform::Settings& settings)
+	{
+		const double deadzone = (settings.deadzone == InputTransform::Deadzone::AXIAL) ? settings.deadzoneSize / 32768.0 : 0.0;
+
+		double x = fabs((double)value) / 32768.0;
+		x = (x <= deadzone) ? 0.0 : (x - deadzone) / (1.0 - deadzone);
+
+		switch (settings.curve)
+		{
+		case InputTransform::Curve::SOFT:	x = pow(x, 2.0);	break;
+		case InputTransform::Curve::SOFTER:	x = pow(x, 3.0);	break;
+		case InputTransform::Curve::SHARP:	x = sqrt(x);		break;
+		default:												break;
+		}
+
+		const int16_t shaped = (int16_t)lround(x * 32767.0);
+		return (value < 0) ? -shaped : shaped;
+	}
+
+	void applyByMath(XINPUT_GAMEPAD& gamepad, const InputTransform::Settings& settings)
+	{
+		gamepad.sThumbLX = shapeByMath(gamepad.sThumbLX, settings);
+		gamepad.sThumbLY = shapeByMath(gamepad.sThumbLY, settings);
+		gamepad.sThumbRX = shapeByMath(gamepad.sThumbRX, settings);
+		gamepad.sThumbRY = shapeByMath(gamepad.sThumbRY, settings);
+		if (gamepad.bLeftTrigger < settings.triggerThreshold) gamepad.bLeftTrigger = 0;
+		if (gamepad.bRightTrigger < settings.triggerThreshold) gamepad.bRightTrigger = 0;
+	}
+
+	vector<XINPUT_GAMEPAD> makeStates(size_t count)
+	{
+		mt19937 random(30);
+		uniform_int_distribution<int> stick(-32768, 32767);
+		uniform_int_distribution<int> trigger(0, 255);
+
+		vector<XINPUT_GAMEPAD> states(count);
+		for (XINPUT_GAMEPAD& state : states)
+		{
+			state.wButtons = 0;
+			state.sThumbLX = (SHORT)stick(random);
+			state.sThumbLY = (SHORT)stick(random);
+			state.sThumbRX = (SHORT)stick(random);
+			state.sThumbRY = (SHORT)stick(random);
+			state.bLeftTrigger = (BYTE)trigger(random);
+			state.bRightTrigger = (BYTE)trigger(random);
+		}
+		return states;
+	}
+}
+
+BENCH(TransformTables)
+{
+	InputTransform::Settings settings;
+	settings.deadzone = InputTransform::Deadzone::AXIAL;
+	settings.curve = InputTransform::Curve::SOFT;
+	settings.triggerThreshold = 32;
+	const InputTransform transform(settings);
+
+	const vector<XINPUT_GAMEPAD> states = makeStates(4096);
+
+	// The tables interpolate between 64-step samples; that must stay within a couple of units.
+	for (const XINPUT_GAMEPAD& state : states)
+	{
+		XINPUT_GAMEPAD byMath = state, byTable = state;
+		applyByMath(byMath, settings);
+		transform.apply(byTable, 0);
+		if (abs(byMath.sThumbLX - byTable.sThumbLX) > 2 || abs(byMath.sThumbRY - byTable.sThumbRY) > 2
+			|| byMath.bLeftTrigger != byTable.bLeftTrigger || byMath.bRightTrigger != byTable.bRightTrigger)
+		{
+			Bench::fail("baked tables drift from the per-message math");
+			return;
+		}
+	}
+
+	Bench::measure("per-message math", iterations, [&](uint64_t i) {
+		XINPUT_GAMEPAD gamepad = states[i & 4095];
+		applyByMath(gamepad, settings);
+		Bench::keep(gamepad.sThumbLX + gamepad.bLeftTrigger);
+	});
+
+	Bench::measure("baked tables", iterations, [&](uint64_t i) {
+		XINPUT_GAMEPAD gamepad = states[i & 4095];
+		transform.apply(gamepad, 0);
+		Bench::keep(gamepad.sThumbLX + gamepad.bLeftTrigger);
+	});
+}